@@ -0,0 +1,87 @@
+#include "detect_cycle/detect_cycle.h"
+#include "shortest_path/bellman_ford/bellman_ford.h"
+#include "shortest_path/breadth_first_search/breadth_first_search.h"
+#include "shortest_path/dijkstra/dijkstra.h"
+#include "utils/benchmark.h"
+#include "utils/csr_graph.h"
+#include "utils/random_graphs.h"
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * Run @a func on both layouts of the same graph, and print how long each took.
+ * @a func should return some summary of its result, so we can check that
+ * both layouts give the same result.
+ */
+template <typename T_Func>
+static bool
+compare_layouts(const std::string& name, const type_vec_nodes& vertices,
+  const CsrGraph& csr_graph, T_Func func) {
+  type_length result_vertices = 0;
+  type_length result_csr = 0;
+  const auto vertices_seconds =
+    benchmark_seconds([&] { result_vertices = func(vertices); });
+  const auto csr_seconds =
+    benchmark_seconds([&] { result_csr = func(csr_graph); });
+  std::cout << name << ": type_vec_nodes: " << vertices_seconds
+            << "s, CsrGraph: " << csr_seconds
+            << "s, speedup: " << vertices_seconds / csr_seconds << std::endl;
+
+  if (result_vertices != result_csr) {
+    std::cerr << name << ": The layouts gave different results." << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Usage: murrayc_csr_graph_benchmark [vertices_count] [edges_count]
+ */
+int
+main(int argc, char** argv) {
+  const auto vertices_count =
+    benchmark_get_arg<type_num>(argc, argv, 1, 100000);
+  const auto edges_count =
+    benchmark_get_arg<type_num>(argc, argv, 2, 10 * vertices_count);
+  std::cout << "vertices: " << vertices_count << ", edges: " << edges_count
+            << std::endl;
+
+  const auto vertices = make_random_graph(vertices_count, edges_count, 1000);
+  CsrGraph csr_graph;
+  const auto build_seconds =
+    benchmark_seconds([&] { csr_graph = CsrGraph(vertices); });
+  std::cout << "building CsrGraph: " << build_seconds << "s" << std::endl;
+
+  bool same = compare_layouts("dijkstra_compute_shortest_paths", vertices,
+    csr_graph, [](const auto& graph) {
+      const auto shortest_paths = dijkstra_compute_shortest_paths(graph, 0);
+      return shortest_paths.get_length(graph.size() - 1);
+    });
+
+  same &= compare_layouts(
+    "bfs_compute_path", vertices, csr_graph, [](const auto& graph) {
+      type_vec_path path;
+      bfs_compute_path(graph, 0, graph.size() - 1, path);
+      return static_cast<type_length>(path.size());
+    });
+
+  same &= compare_layouts("bellman_ford_single_source_shortest_paths",
+    vertices, csr_graph, [](const auto& graph) {
+      bool has_negative_cycles = false;
+      const auto shortest_paths = bellman_ford_single_source_shortest_paths(
+        graph, 0, has_negative_cycles);
+      return shortest_paths.get_length(graph.size() - 1);
+    });
+
+  // Use a graph without cycles, so the whole graph must be searched:
+  const auto acyclic_vertices =
+    make_random_acyclic_graph(vertices_count, edges_count, 1000);
+  const CsrGraph acyclic_csr_graph(acyclic_vertices);
+  same &= compare_layouts("detect_cycle_iterative", acyclic_vertices,
+    acyclic_csr_graph, [](const auto& graph) {
+      return static_cast<type_length>(detect_cycle_iterative(graph));
+    });
+
+  return same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -7,8 +7,9 @@
 #include <stack>
 #include <vector>
 
+template <typename T_Graph>
 bool
-detect_cycle_recursive(const type_vec_nodes& vertices, Edge::type_num s,
+detect_cycle_recursive(const T_Graph& vertices, Edge::type_num s,
   std::vector<bool>& discovered, std::vector<bool>& completed) {
   discovered[s] = true;
 
@@ -39,8 +40,9 @@ detect_cycle_recursive(const type_vec_nodes& vertices, Edge::type_num s,
 /**
  * DFS to discover any cycle starting from vertex @a s.
  */
+template <typename T_Graph>
 bool
-detect_cycle_recursive(const type_vec_nodes& vertices, Edge::type_num s) {
+detect_cycle_recursive(const T_Graph& vertices, Edge::type_num s) {
   const auto n = vertices.size();
 
   // DFS on the tree to find a cycle.
@@ -52,8 +54,9 @@ detect_cycle_recursive(const type_vec_nodes& vertices, Edge::type_num s) {
 /**
  * DFS to discover any cycle.
  */
+template <typename T_Graph>
 bool
-detect_cycle_recursive(const type_vec_nodes& vertices) {
+detect_cycle_recursive(const T_Graph& vertices) {
   const auto n = vertices.size();
   std::vector<bool> discovered(n);
   std::vector<bool> completed(n);
@@ -69,8 +72,9 @@ detect_cycle_recursive(const type_vec_nodes& vertices) {
 /**
  * DFS to discover any cycle.
  */
+template <typename T_Graph>
 bool
-detect_cycle_iterative(const type_vec_nodes& vertices, Edge::type_num s,
+detect_cycle_iterative(const T_Graph& vertices, Edge::type_num s,
   std::vector<bool>& discovered, std::vector<bool>& completed) {
 
   // DFS on the tree to find a cycle.
@@ -122,8 +126,9 @@ detect_cycle_iterative(const type_vec_nodes& vertices, Edge::type_num s,
 /**
  * DFS to discover any cycle starting from vertex @a s.
  */
+template <typename T_Graph>
 bool
-detect_cycle_iterative(const type_vec_nodes& vertices, Edge::type_num s) {
+detect_cycle_iterative(const T_Graph& vertices, Edge::type_num s) {
   const auto n = vertices.size();
 
   // DFS on the tree to find a cycle.
@@ -135,8 +140,9 @@ detect_cycle_iterative(const type_vec_nodes& vertices, Edge::type_num s) {
 /**
  * DFS to discover any cycle.
  */
+template <typename T_Graph>
 bool
-detect_cycle_iterative(const type_vec_nodes& vertices) {
+detect_cycle_iterative(const T_Graph& vertices) {
   const auto n = vertices.size();
   std::vector<bool> discovered(n);
   std::vector<bool> completed(n);
@@ -151,9 +157,12 @@ detect_cycle_iterative(const type_vec_nodes& vertices) {
 
 /**
  * DFS to discover any cycle starting from vertex @a s.
+ *
+ * @tparam T_Graph For instance, type_vec_nodes or CsrGraph.
  */
+template <typename T_Graph>
 bool
-detect_cycle(const type_vec_nodes& vertices, Edge::type_num s) {
+detect_cycle(const T_Graph& vertices, Edge::type_num s) {
   return detect_cycle_recursive(vertices, s);
 }
 
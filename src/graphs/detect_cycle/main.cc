@@ -1,4 +1,5 @@
 #include "detect_cycle.h"
+#include "utils/csr_graph.h"
 #include "utils/vertex.h"
 #include <cassert>
 #include <cstdlib>
@@ -58,6 +59,17 @@ test_iterative_from_source_with_cycle() {
   assert(detect_cycle_iterative(EXAMPLE_GRAPH_LARGER_WITH_NEGATIVE_EDGES, 0));
 }
 
+static void
+test_csr() {
+  assert(!detect_cycle_recursive(CsrGraph(EXAMPLE_GRAPH_SMALL)));
+  assert(!detect_cycle_iterative(CsrGraph(EXAMPLE_GRAPH_SMALL)));
+
+  const CsrGraph graph(EXAMPLE_GRAPH_LARGER_WITH_NEGATIVE_EDGES);
+  assert(detect_cycle_recursive(graph));
+  assert(detect_cycle_iterative(graph));
+  assert(detect_cycle(graph, 0));
+}
+
 int
 main() {
   test_recursive_without_cycle();
@@ -68,5 +80,7 @@ main() {
   test_iterative_with_cycle();
   test_iterative_from_source_with_cycle();
 
+  test_csr();
+
   return EXIT_SUCCESS;
 }
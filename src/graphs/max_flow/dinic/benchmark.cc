@@ -0,0 +1,87 @@
+#include "dinic.h"
+#include "max_flow/ford_fulkerson/ford_fulkerson.h"
+#include "utils/benchmark.h"
+#include "utils/random_graphs.h"
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * Compare dinic_max_flow() with ford_fulkerson_max_flow(), which is only run
+ * on graphs with up to @a max_vertices_count_for_ford_fulkerson vertices.
+ * @result false if the results were not the same.
+ */
+static bool
+benchmark_graph(const std::string& name, const type_vec_nodes& vertices,
+  std::size_t max_vertices_count_for_ford_fulkerson) {
+  const auto vertices_count = vertices.size();
+  std::size_t edges_count = 0;
+  for (const auto& vertex : vertices) {
+    edges_count += vertex.edges_.size();
+  }
+
+  std::cout << name << ", vertices: " << vertices_count
+            << ", edges: " << edges_count << std::endl;
+
+  const type_num source_vertex = 0;
+  const type_num sink_vertex = vertices_count - 1;
+
+  Edge::type_length expected = 0;
+  const auto seconds = benchmark_seconds([&] {
+    expected = dinic_max_flow(vertices, source_vertex, sink_vertex);
+  });
+  std::cout << "  dinic_max_flow(): " << seconds << "s, max flow: " << expected
+            << std::endl;
+
+  if (vertices_count > max_vertices_count_for_ford_fulkerson) {
+    std::cout << "  (Skipping ford_fulkerson_max_flow().)" << std::endl;
+    return true;
+  }
+
+  Edge::type_length result = 0;
+  const auto ford_fulkerson_seconds = benchmark_seconds([&] {
+    result = ford_fulkerson_max_flow(vertices, source_vertex, sink_vertex);
+  });
+  std::cout << "  ford_fulkerson_max_flow(): " << ford_fulkerson_seconds
+            << "s" << std::endl;
+  if (result != expected) {
+    std::cerr << "The results were not the same." << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Usage: murrayc_dinic_benchmark [left_count]
+ * [max_vertices_count_for_ford_fulkerson]
+ *
+ * The main graph is a bipartite matching problem, with left_count vertices
+ * on the left and right, each on the left with 3 edges, whose unit
+ * capacities suit Dinic's algorithm best, followed by the GENRMF and random
+ * level graphs from the push-relabel benchmark.
+ */
+int
+main(int argc, char** argv) {
+  const auto left_count = benchmark_get_arg<type_num>(argc, argv, 1, 100000);
+  const auto max_vertices_count_for_ford_fulkerson =
+    benchmark_get_arg<std::size_t>(argc, argv, 2, 20000);
+
+  if (!benchmark_graph("bipartite matching",
+        make_bipartite_matching_graph(left_count, left_count, 3),
+        max_vertices_count_for_ford_fulkerson)) {
+    return EXIT_FAILURE;
+  }
+
+  if (!benchmark_graph("GENRMF long", make_rmf_graph(16, 64, 1000),
+        max_vertices_count_for_ford_fulkerson)) {
+    return EXIT_FAILURE;
+  }
+
+  if (!benchmark_graph("random level graph",
+        make_random_level_graph(128, 256, 3, 1000),
+        max_vertices_count_for_ford_fulkerson)) {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -1,263 +1,219 @@
+#ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_DINIC
+#define MURRAYC_ALGORITHMS_EXPERIMENTS_DINIC
+
 #include "shortest_path/breadth_first_search/breadth_first_search.h"
-#include "utils/example_graphs.h"
+#include "utils/residual_graph.h"
+#include "utils/vertex.h"
+#include <algorithm>
 #include <iostream>
-#include <queue>
-#include <stack>
+#include <vector>
 
 // A set of vertices and their edges.
 using type_vec_nodes = std::vector<Vertex>;
 
 using type_num = Edge::type_num;
 
-using type_depths = std::vector<type_num>;
-
-static type_depths
-bfs_calculate_levels(type_num start_vertex, const type_vec_nodes& vertices) {
-  const auto vertices_size = vertices.size();
-  type_depths result(vertices_size);
-
-  std::queue<type_num> queue;
-  queue.emplace(start_vertex);
-  std::vector<bool> discovered(vertices_size);
-  discovered[start_vertex] = true;
-
-  result[start_vertex] = 0;
-
-  while (!queue.empty()) {
-    const auto i = queue.front();
-    queue.pop();
-    const auto& vertex = vertices[i];
-    const auto depth = result[i];
-
-    const auto& edges = vertex.edges_;
-    const auto edges_count = edges.size();
-    for (type_num e = 0; e < edges_count; ++e) {
-      const auto& edge = edges[e];
-
-      // Ignore zero-length edges.
-      if (edge.length_ == 0) {
-        continue;
-      }
-
-      const auto edge_dest = edge.destination_vertex_;
-      if (discovered[edge_dest])
-        continue;
-
-      discovered[edge_dest] = true;
-      queue.emplace(edge_dest);
-
-      result[edge_dest] = depth + 1;
-    }
-  }
-
-  return result;
-}
-
-static type_vec_nodes
-make_residual_graph(const type_vec_nodes& vertices) {
-  type_vec_nodes result = vertices;
-
-  const auto vertices_count = result.size();
-  for (type_num i = 0; i < vertices_count; ++i) {
-    auto& vertex = result[i];
-
-    const auto edges_count = vertex.edges_.size();
-    for (type_num e = 0; e < edges_count; ++e) {
-      const auto& edge = vertex.edges_[e];
-
-      const auto dest_vertex_num = edge.destination_vertex_;
-      auto& dest_vertex = result[dest_vertex_num];
-      auto& edges = dest_vertex.edges_;
-
-      // Add reverse edge:
-      edges.emplace_back(i, 0);
-      auto& reverse = edges.back();
-
-      // Tell each edge about its reverse edge:
-      reverse.reverse_edge_in_dest_ = e;
-
-      auto& source_edge = vertex.edges_[e];
-      source_edge.reverse_edge_in_dest_ = edges.size() - 1;
+/**
+ * The state of one dinic_max_flow() calculation.
+ *
+ * Each phase finds the level of each vertex, its number of edges from the
+ * source in the residual graph, with a BFS, and then finds a blocking flow
+ * in the level graph, which has only the edges that go up exactly one level,
+ * so that every path from the source to the sink in the residual graph is
+ * then longer. There are at most n phases.
+ *
+ * The blocking flow is found by a DFS that remembers the current arc of each
+ * vertex. An arc that is saturated, or that leads to a dead end, can't be
+ * used again in the same phase, so the DFS moves past it for good, and each
+ * arc is looked at only once per phase, apart from the augmenting paths
+ * themselves.
+ * The path is kept as a stack of vertices, whose current arcs are the arcs
+ * of the path, so augmenting it needs no memory to be allocated.
+ */
+class Dinic {
+public:
+  Dinic(ResidualGraph& residual_graph, type_num source_vertex,
+    type_num sink_vertex)
+  : residual_graph_(residual_graph),
+    source_vertex_(source_vertex),
+    sink_vertex_(sink_vertex),
+    vertices_count_(residual_graph.size()),
+    current_arcs_(vertices_count_),
+    phases_count_(0),
+    augmenting_paths_count_(0) {}
+
+  /**
+   * Find the maximum flow, adding to any flow already in the residual graph.
+   * @result The flow added.
+   */
+  Edge::type_length
+  compute() {
+    Edge::type_length result = 0;
+    while (compute_levels()) {
+      ++phases_count_;
+      std::copy(residual_graph_.offsets_.begin(),
+        residual_graph_.offsets_.end() - 1, current_arcs_.begin());
+      result += compute_blocking_flow();
     }
-  }
-
-  return result;
-}
-
-static Edge&
-get_reverse_edge(const Edge& edge, type_vec_nodes& vertices) {
-  auto& dest = vertices[edge.destination_vertex_];
-  return dest.edges_[edge.reverse_edge_in_dest_];
-}
-
-bool
-dfs_find_path(const type_vec_nodes& vertices, const type_depths& levels,
-  type_num max_level, type_num start_vertex, type_num dest_vertex,
-  type_vec_path& path) {
-  type_vec_path result;
 
-  const auto vertices_size = vertices.size();
-
-  if (start_vertex >= vertices_size) {
-    std::cerr << "start vertex not found in vertices: " << start_vertex
-              << std::endl;
-    path = result;
-    return false;
+    return result;
   }
 
-  if (dest_vertex >= vertices_size) {
-    std::cerr << "end vertex not found in vertices: " << dest_vertex
-              << std::endl;
-    path = result;
-    return false;
+  ResidualGraph& residual_graph_;
+  const type_num source_vertex_;
+  const type_num sink_vertex_;
+  const std::size_t vertices_count_;
+
+  // The levels, as the BFS depths, ignoring the arcs with no remaining
+  // capacity, which have a length of 0 in the residual graph.
+  // After compute(), this has the last BFS, which didn't reach the sink, so
+  // its reached vertices are the source's side of a minimum cut, as used by
+  // get_min_cut().
+  BfsWorkspace levels_;
+
+  // The arc of each vertex at which the DFS continues in this phase.
+  // The vertex's arcs before it are saturated or lead to dead ends.
+  std::vector<std::size_t> current_arcs_;
+
+  // The vertices along the current path from the source, whose current arcs
+  // are the path's arcs.
+  std::vector<type_num> path_;
+
+  // Statistics, for benchmarks.
+  std::size_t phases_count_;
+  std::size_t augmenting_paths_count_;
+
+private:
+  /**
+   * @result false if the sink can't be reached any more.
+   */
+  bool
+  compute_levels() {
+    // The vertices beyond the sink's level are not needed.
+    bfs_compute(residual_graph_, source_vertex_, sink_vertex_,
+      true /* stop_at_end */, levels_);
+    return levels_.is_reached(sink_vertex_);
   }
 
-  std::vector<bool> discovered(vertices_size);
-  std::unordered_map<type_num, SourceAndEdge> predecessors;
-
-  std::stack<type_num> stack;
-  stack.emplace(start_vertex);
-  discovered[start_vertex] = true;
-
-  bool found = false;
-
-  while (!stack.empty()) {
-    const auto i = stack.top();
-    stack.pop();
-
-    // Only DFS down to a certain level:
-    if (levels[i] > max_level) {
-      continue;
+  /**
+   * Whether the arc from @a u is in the level graph.
+   * Only the sink is used from the sink's level.
+   */
+  bool
+  is_admissible(type_num u, std::size_t arc) const {
+    if (residual_graph_.residuals_[arc] == 0) {
+      return false;
     }
 
-    const auto& vertex = vertices[i];
-
-    if (i == dest_vertex) {
-      found = true;
-      break;
-    }
-
-    const auto& edges = vertex.edges_;
-    const auto edges_count = edges.size();
-    for (type_num e = 0; e < edges_count; ++e) {
-      const auto& edge = edges[e];
+    const auto v = residual_graph_.destinations_[arc];
+    const auto& depths = levels_.depths_;
+    return depths[v] == depths[u] + 1 &&
+           (depths[v] < depths[sink_vertex_] || v == sink_vertex_);
+  }
 
-      // Ignore zero-length edges.
-      if (edge.length_ == 0) {
+  /**
+   * Find augmenting paths in the level graph, with the current arcs,
+   * until there are none, and augment the flow along them.
+   * @result The flow added.
+   */
+  Edge::type_length
+  compute_blocking_flow() {
+    Edge::type_length result = 0;
+
+    path_.clear();
+    auto u = source_vertex_;
+    while (true) {
+      if (u == sink_vertex_) {
+        result += augment();
+
+        // Continue from the start of the first saturated arc,
+        // whose current arc will then move past it:
+        auto i = std::find_if(path_.begin(), path_.end(), [this](type_num w) {
+          return residual_graph_.residuals_[current_arcs_[w]] == 0;
+        });
+        u = *i;
+        path_.erase(i, path_.end());
         continue;
       }
 
-      const auto edge_dest = edge.destination_vertex_;
-      if (discovered[edge_dest])
+      // Advance along the current arc, moving past arcs that are not in
+      // the level graph:
+      const auto end = residual_graph_.offsets_[u + 1];
+      auto& arc = current_arcs_[u];
+      while (arc < end && !is_admissible(u, arc)) {
+        ++arc;
+      }
+
+      if (arc < end) {
+        path_.emplace_back(u);
+        u = residual_graph_.destinations_[arc];
         continue;
+      }
 
-      discovered[edge_dest] = true;
-      stack.emplace(edge_dest);
+      // u is a dead end, so retreat, moving past the arc to it:
+      if (path_.empty()) {
+        break;
+      }
 
-      // std::cout << "predecessor of " << edge_dest << " is " << i <<
-      // std::endl;
-      predecessors[edge_dest] = SourceAndEdge(i, e);
+      u = path_.back();
+      path_.pop_back();
+      ++current_arcs_[u];
     }
-  }
-
-  if (found)
-    result =
-      get_path_from_predecessors(start_vertex, dest_vertex, predecessors);
-
-  path = result;
-  return found;
-}
 
-/** Find and augment the blocking flows for the @a k depth level of the
- * residual graph, returning the amount of flow added.
- */
-bool
-dfs_find_blocking_flow(type_vec_nodes& residual_graph,
-  const type_depths& levels, type_num max_level, type_num start_vertex,
-  type_num dest_vertex, Edge::type_length& flow) {
-  flow = 0;
-
-  bool at_least_one_path_found = false;
-  type_vec_path path;
-  while (dfs_find_path(
-    residual_graph, levels, max_level, start_vertex, dest_vertex, path)) {
-    at_least_one_path_found = true;
+    return result;
+  }
 
-    // const auto path_vertices = get_vertices_for_path(start_vertex, path,
-    // residual_graph);
-    // for (const auto& v : path_vertices) {
-    //  std::cout << v << ", ";
-    //}
-    // std::cout << std::endl;
+  /**
+   * Push the most flow that the path allows along it.
+   * @result The flow added.
+   */
+  Edge::type_length
+  augment() {
+    ++augmenting_paths_count_;
 
     // Find the bottleneck in this path
-    //(The edge with the smallest remaining capacity.)
-    const auto iter = std::min_element(path.begin(), path.end(),
-      [&residual_graph](const auto& a, const auto& b) {
-        const auto& a_vertex = residual_graph[a.source_];
-        const auto& a_edge = a_vertex.edges_[a.edge_];
-
-        const auto& b_vertex = residual_graph[b.source_];
-        const auto& b_edge = b_vertex.edges_[b.edge_];
-
-        return a_edge.length_ < b_edge.length_;
-      });
-    const auto& min_vertex = residual_graph[iter->source_];
-    const auto& min_edge = min_vertex.edges_[iter->edge_];
-    const auto c = min_edge.length_;
-    // std::cout << "c: " << c << std::endl;
-
-    // Augment the path:
-    for (auto& source_and_edge : path) {
-      auto& source = residual_graph[source_and_edge.source_];
-      auto& edge = source.edges_[source_and_edge.edge_];
-
-      // Reduce the edge's capacity:
-      // std::cout << "before:"
-      //  << ", capacity=" << edge.length_
-      //  << ", residual=" << edge.residual_ << std::endl;
-      edge.length_ -= c;
-      // std::cout << "after: edge.length_=" << edge.length_ << std::endl;
+    // (The arc with the smallest remaining capacity.)
+    const auto& residuals = residual_graph_.residuals_;
+    auto c = residuals[current_arcs_[path_.front()]];
+    for (const auto w : path_) {
+      c = std::min(c, residuals[current_arcs_[w]]);
+    }
 
-      // Increase the reverse edge's capacity, to allow an undo:
-      auto& reverse_edge = get_reverse_edge(edge, residual_graph);
-      reverse_edge.length_ += c;
+    for (const auto w : path_) {
+      residual_graph_.push(current_arcs_[w], c);
     }
 
-    flow += c;
+    return c;
   }
-
-  return at_least_one_path_found;
-}
-
-/** This is actually the Edmonds-Karp algorithm,
- * because it uses BFS to find the path in each iteration, giving us the path
- * with the least number of hops in each iteration.
- * Using DFS would still be Ford-Fulkerson, but not Edmunds-Karp, and would
- * be less efficient.
+};
+
+/**
+ * Get the value of the maximum flow from @a source_vertex_num to
+ * @a sink_vertex_num, with Dinic's algorithm, treating each edge's length as
+ * its capacity.
+ *
+ * This needs O(V^2 E) time in general, but only O(E sqrt(V)) time for unit
+ * capacity networks such as those for bipartite matching.
  */
 static Edge::type_length
 dinic_max_flow(const type_vec_nodes& vertices, type_num source_vertex_num,
   type_num sink_vertex_num) {
-  Edge::type_length result = 0;
-
-  auto residual_graph = make_residual_graph(vertices);
-  const auto levels = bfs_calculate_levels(source_vertex_num, residual_graph);
-  // for (type_num i = 0; i < levels.size(); ++i) {
-  //  std::cout << "vertex " << i << ": level " << levels[i] << std::endl;
-  //}
+  const auto vertices_count = vertices.size();
+  if (source_vertex_num >= vertices_count ||
+      sink_vertex_num >= vertices_count) {
+    std::cerr << "dinic_max_flow(): vertex not found in vertices."
+              << std::endl;
+    return 0;
+  }
 
-  // Find the blocking paths for each level:
-  const auto max_iter = std::max_element(levels.begin(), levels.end());
-  const auto max_level = *max_iter;
-  for (type_num k = 1; k <= max_level; ++k) {
-    type_vec_path path;
-    Edge::type_length flow = 0;
-    while (dfs_find_blocking_flow(
-      residual_graph, levels, k, source_vertex_num, sink_vertex_num, flow)) {
-      result += flow;
-    }
+  if (source_vertex_num == sink_vertex_num) {
+    std::cerr << "dinic_max_flow(): the source is the sink." << std::endl;
+    return 0;
   }
 
-  return result;
+  ResidualGraph residual_graph(vertices);
+  Dinic dinic(residual_graph, source_vertex_num, sink_vertex_num);
+  return dinic.compute();
 }
+
+#endif // MURRAYC_ALGORITHMS_EXPERIMENTS_DINIC
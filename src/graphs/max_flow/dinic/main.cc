@@ -1,5 +1,7 @@
 #include "dinic.h"
+#include "max_flow/ford_fulkerson/ford_fulkerson.h"
 #include "utils/example_graphs.h"
+#include "utils/random_graphs.h"
 #include <cassert>
 #include <cstdlib>
 #include <iostream>
@@ -17,13 +19,79 @@ test_small(type_num source_vertex_num, type_num sink_vertex_num,
   assert(max_flow == expected_max_flow);
 }
 
+static void
+test_undo() {
+  // The first phase's only shortest path is 0, 1, 4, 5, which blocks both of
+  // the other paths, so the second phase must undo it, via the reverse edge
+  // from 4 to 1, to find 0, 2, 4, 1, 3, 5:
+  const type_vec_nodes graph = {Vertex({Edge(1, 1), Edge(2, 1)}),
+    Vertex({Edge(4, 1), Edge(3, 1)}), Vertex({Edge(4, 1)}),
+    Vertex({Edge(5, 1)}), Vertex({Edge(5, 1)}), Vertex()};
+  assert(dinic_max_flow(graph, 0, 5) == 2);
+
+  // No path:
+  assert(dinic_max_flow(graph, 5, 0) == 0);
+}
+
+static void
+check_graph(const type_vec_nodes& vertices, type_num source_vertex,
+  type_num sink_vertex) {
+  assert(dinic_max_flow(vertices, source_vertex, sink_vertex) ==
+         ford_fulkerson_max_flow(vertices, source_vertex, sink_vertex));
+}
+
+static void
+test_random() {
+  for (unsigned int seed = 0; seed < 20; ++seed) {
+    const auto graph = make_random_graph(200, 1000, 50, seed);
+    check_graph(graph, 0, 199);
+    check_graph(graph, seed, 100 + seed);
+  }
+
+  const auto rmf_graph = make_rmf_graph(5, 6, 100);
+  check_graph(rmf_graph, 0, rmf_graph.size() - 1);
+
+  const auto level_graph = make_random_level_graph(10, 20, 3, 100);
+  check_graph(level_graph, 0, level_graph.size() - 1);
+
+  const auto grid_graph = make_random_grid_graph(20, 20, 10);
+  check_graph(grid_graph, 0, grid_graph.size() - 1);
+
+  const auto matching_graph = make_bipartite_matching_graph(300, 200, 3);
+  check_graph(matching_graph, 0, matching_graph.size() - 1);
+}
+
+static void
+test_reuse() {
+  // Many calculations with the same residual graph, with new capacities,
+  // giving the same results as a new residual graph each time:
+  auto graph = make_random_level_graph(10, 20, 3, 100);
+  const type_num sink_vertex = graph.size() - 1;
+  ResidualGraph residual_graph(graph);
+  Dinic dinic(residual_graph, 0, sink_vertex);
+  for (unsigned int seed = 2; seed < 6; ++seed) {
+    const auto other = make_random_level_graph(10, 20, 3, 100, seed);
+    for (type_num u = 0; u < graph.size(); ++u) {
+      auto& edges = graph[u].edges_;
+      for (std::size_t e = 0; e < edges.size(); ++e) {
+        edges[e].length_ = other[u].edges_[e].length_;
+      }
+    }
+
+    assert(residual_graph.set_capacities(graph));
+    assert(dinic.compute() == dinic_max_flow(graph, 0, sink_vertex));
+  }
+}
+
 int
 main() {
-  // TODO: Test a graph that actually needs us to use the residual (reverse)
-  // edges to undo.
   test_small(0, 3, 5);
   test_small(0, 2, 5);
   test_small(2, 3, 3);
 
+  test_undo();
+  test_random();
+  test_reuse();
+
   return EXIT_SUCCESS;
 }
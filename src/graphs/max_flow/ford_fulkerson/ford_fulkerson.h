@@ -1,5 +1,10 @@
+#ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_FORD_FULKERSON
+#define MURRAYC_ALGORITHMS_EXPERIMENTS_FORD_FULKERSON
+
 #include "shortest_path/breadth_first_search/breadth_first_search.h"
+#include "utils/residual_graph.h"
 #include "utils/vertex.h"
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 
@@ -8,101 +13,59 @@ using type_vec_nodes = std::vector<Vertex>;
 
 using type_num = Edge::type_num;
 
-static type_vec_nodes
-make_residual_graph(const type_vec_nodes& vertices) {
-  type_vec_nodes result = vertices;
-
-  const auto vertices_count = result.size();
-  for (type_num i = 0; i < vertices_count; ++i) {
-    auto& vertex = result[i];
-
-    const auto edges_count = vertex.edges_.size();
-    for (type_num e = 0; e < edges_count; ++e) {
-      const auto& edge = vertex.edges_[e];
-
-      const auto dest_vertex_num = edge.destination_vertex_;
-      auto& dest_vertex = result[dest_vertex_num];
-      auto& edges = dest_vertex.edges_;
-
-      // Add reverse edge:
-      edges.emplace_back(i, 0);
-      auto& reverse = edges.back();
-
-      // Tell each edge about its reverse edge:
-      reverse.reverse_edge_in_dest_ = e;
-
-      auto& source_edge = vertex.edges_[e];
-      source_edge.reverse_edge_in_dest_ = edges.size() - 1;
-    }
-  }
-
-  return result;
-}
-
-static Edge&
-get_reverse_edge(const Edge& edge, type_vec_nodes& vertices) {
-  auto& dest = vertices[edge.destination_vertex_];
-  return dest.edges_[edge.reverse_edge_in_dest_];
-}
-
 /** This is actually the Edmonds-Karp algorithm,
  * because it uses BFS to find the path in each iteration, giving us the path
  * with the least number of hops in each iteration.
  * Using DFS would still be Ford-Fulkerson, but not Edmunds-Karp, and would
  * be less efficient.
+ *
+ * This adds to any flow already in the @a residual_graph, so it can be used
+ * again after ResidualGraph::reset_flow() or ResidualGraph::set_capacities().
+ *
+ * Afterwards, the @a workspace has the last search, which didn't reach the
+ * sink, so its reached vertices are the source's side of a minimum cut,
+ * as used by get_min_cut().
+ *
+ * @result The flow added, or 0 if the source or sink is not valid.
  */
 static Edge::type_length
-ford_fulkerson_max_flow(const type_vec_nodes& vertices,
-  type_num source_vertex_num, type_num sink_vertex_num) {
+ford_fulkerson_max_flow(ResidualGraph& residual_graph,
+  type_num source_vertex_num, type_num sink_vertex_num,
+  BfsWorkspace& workspace) {
   Edge::type_length result = 0;
 
-  // TODO: Separate map of edges to their flows?
-  auto residual_graph = make_residual_graph(vertices);
+  const auto vertices_count = residual_graph.size();
+  if (source_vertex_num >= vertices_count ||
+      sink_vertex_num >= vertices_count) {
+    std::cerr << "ford_fulkerson_max_flow(): vertex not found in vertices."
+              << std::endl;
+    return result;
+  }
+
+  // Otherwise the search would find an empty path, with no bottleneck:
+  if (source_vertex_num == sink_vertex_num) {
+    std::cerr << "ford_fulkerson_max_flow(): the source is the sink."
+              << std::endl;
+    return result;
+  }
 
   type_vec_path path;
   while (bfs_compute_path(
-    residual_graph, source_vertex_num, sink_vertex_num, path)) {
-
-    // std::cout << "path found: ";
-    // const auto path_vertices = get_vertices_for_path(source_vertex_num, path,
-    // residual_graph);
-    // for (const auto& v : path_vertices) {
-    //  std::cout << v << ", ";
-    //}
-    // std::cout << std::endl;
-
+    residual_graph, source_vertex_num, sink_vertex_num, path, workspace)) {
     // Find the bottleneck in this path
     //(The edge with the smallest remaining capacity.)
-    const auto iter = std::min_element(path.begin(), path.end(),
-      [&residual_graph](const auto& a, const auto& b) {
-        const auto& a_vertex = residual_graph[a.source_];
-        const auto& a_edge = a_vertex.edges_[a.edge_];
-
-        const auto& b_vertex = residual_graph[b.source_];
-        const auto& b_edge = b_vertex.edges_[b.edge_];
-
-        return a_edge.length_ < b_edge.length_;
-      });
-    const auto& min_vertex = residual_graph[iter->source_];
-    const auto& min_edge = min_vertex.edges_[iter->edge_];
-    const auto c = min_edge.length_;
-    // std::cout << "c: " << c << std::endl;
+    auto c = Edge::LENGTH_INFINITY;
+    for (const auto& source_and_edge : path) {
+      const auto arc = residual_graph.get_arc(
+        source_and_edge.source_, source_and_edge.edge_);
+      c = std::min(c, residual_graph.residuals_[arc]);
+    }
 
     // Augment the path:
-    for (auto& source_and_edge : path) {
-      auto& source = residual_graph[source_and_edge.source_];
-      auto& edge = source.edges_[source_and_edge.edge_];
-
-      // Reduce the edge's capacity:
-      // std::cout << "before:"
-      //  << ", capacity=" << edge.length_
-      //  << ", residual=" << edge.residual_ << std::endl;
-      edge.length_ -= c;
-      // std::cout << "after: edge.length_=" << edge.length_ << std::endl;
-
-      // Increase the reverse edge's capacity, to allow an undo:
-      auto& reverse_edge = get_reverse_edge(edge, residual_graph);
-      reverse_edge.length_ += c;
+    for (const auto& source_and_edge : path) {
+      residual_graph.push(
+        residual_graph.get_arc(source_and_edge.source_, source_and_edge.edge_),
+        c);
     }
 
     result += c;
@@ -110,3 +73,25 @@ ford_fulkerson_max_flow(const type_vec_nodes& vertices,
 
   return result;
 }
+
+static Edge::type_length
+ford_fulkerson_max_flow(ResidualGraph& residual_graph,
+  type_num source_vertex_num, type_num sink_vertex_num) {
+  BfsWorkspace workspace;
+  return ford_fulkerson_max_flow(
+    residual_graph, source_vertex_num, sink_vertex_num, workspace);
+}
+
+/**
+ * Get the value of the maximum flow from @a source_vertex_num to
+ * @a sink_vertex_num, treating each edge's length as its capacity.
+ */
+static Edge::type_length
+ford_fulkerson_max_flow(const type_vec_nodes& vertices,
+  type_num source_vertex_num, type_num sink_vertex_num) {
+  ResidualGraph residual_graph(vertices);
+  return ford_fulkerson_max_flow(
+    residual_graph, source_vertex_num, sink_vertex_num);
+}
+
+#endif // MURRAYC_ALGORITHMS_EXPERIMENTS_FORD_FULKERSON
@@ -15,13 +15,72 @@ test_small(type_num source_vertex_num, type_num sink_vertex_num,
   assert(max_flow == expected_max_flow);
 }
 
+static void
+test_undo() {
+  // The only shortest path is 0, 1, 4, 5, which blocks both of the other
+  // paths, so it must be undone, via the reverse edge from 4 to 1, to find
+  // 0, 2, 4, 1, 3, 5:
+  const type_vec_nodes graph = {Vertex({Edge(1, 1), Edge(2, 1)}),
+    Vertex({Edge(4, 1), Edge(3, 1)}), Vertex({Edge(4, 1)}),
+    Vertex({Edge(5, 1)}), Vertex({Edge(5, 1)}), Vertex()};
+  ResidualGraph residual_graph(graph);
+  assert(ford_fulkerson_max_flow(residual_graph, 0, 5) == 2);
+
+  // The flow along each edge, in order of their source vertex,
+  // with none along the edge from 1 to 4:
+  const std::vector<Edge::type_length> expected_flows = {1, 1, 0, 1, 1, 1, 1};
+  for (std::size_t i = 0; i < expected_flows.size(); ++i) {
+    assert(residual_graph.get_flow(i) == expected_flows[i]);
+  }
+
+  // There is no more flow to add:
+  assert(ford_fulkerson_max_flow(residual_graph, 0, 5) == 0);
+
+  residual_graph.reset_flow();
+  assert(residual_graph.get_flow(0) == 0);
+  assert(ford_fulkerson_max_flow(residual_graph, 0, 5) == 2);
+}
+
+static void
+test_set_capacities() {
+  type_vec_nodes graph = {Vertex({Edge(1, 1), Edge(2, 1)}),
+    Vertex({Edge(4, 1), Edge(3, 1)}), Vertex({Edge(4, 1)}),
+    Vertex({Edge(5, 1)}), Vertex({Edge(5, 1)}), Vertex()};
+  ResidualGraph residual_graph(graph);
+  assert(ford_fulkerson_max_flow(residual_graph, 0, 5) == 2);
+
+  graph[0].edges_[0].length_ = 5;
+  graph[1].edges_[1].length_ = 5;
+  graph[3].edges_[0].length_ = 5;
+  assert(residual_graph.set_capacities(graph));
+  assert(ford_fulkerson_max_flow(residual_graph, 0, 5) == 6);
+  assert(ford_fulkerson_max_flow(graph, 0, 5) == 6);
+
+  // A graph with different edges:
+  graph[4].edges_.emplace_back(0, 1);
+  assert(!residual_graph.set_capacities(graph));
+}
+
+static void
+test_invalid_terminals() {
+  // The source is the sink:
+  assert(ford_fulkerson_max_flow(EXAMPLE_GRAPH_SMALL_FOR_FLOW, 1, 1) == 0);
+
+  // Vertices not in the graph:
+  ResidualGraph residual_graph(EXAMPLE_GRAPH_SMALL_FOR_FLOW);
+  assert(ford_fulkerson_max_flow(residual_graph, 0, 4) == 0);
+  assert(ford_fulkerson_max_flow(residual_graph, 4, 0) == 0);
+}
+
 int
 main() {
-  // TODO: Test a graph that actually needs us to use the residual (reverse)
-  // edges to undo.
   test_small(0, 3, 5);
   test_small(0, 2, 5);
   test_small(2, 3, 3);
 
+  test_undo();
+  test_set_capacities();
+  test_invalid_terminals();
+
   return EXIT_SUCCESS;
 }
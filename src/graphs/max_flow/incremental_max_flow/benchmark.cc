@@ -0,0 +1,141 @@
+#include "incremental_max_flow.h"
+#include "max_flow/dinic/dinic.h"
+#include "utils/benchmark.h"
+#include "utils/random_graphs.h"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+/**
+ * Change a few capacities at a time, by up to 10% of @a max_capacity, like a
+ * capacity planning loop, comparing IncrementalMaxFlow::update_capacities()
+ * with new calculations by dinic_max_flow(), and by Dinic's algorithm on the
+ * same ResidualGraph, after ResidualGraph::reset_flow().
+ * @result false if the results were not the same.
+ */
+static bool
+benchmark_graph(const std::string& name, const type_vec_nodes& vertices,
+  Edge::type_length max_capacity, std::size_t rounds_count,
+  std::size_t changes_count) {
+  const type_num source_vertex = 0;
+  const type_num sink_vertex = vertices.size() - 1;
+
+  std::vector<Edge::type_length> capacities;
+  for (const auto& vertex : vertices) {
+    for (const auto& edge : vertex.edges_) {
+      capacities.emplace_back(edge.length_);
+    }
+  }
+
+  std::cout << name << ", vertices: " << vertices.size()
+            << ", edges: " << capacities.size() << std::endl;
+
+  // Choose all the changes first:
+  std::mt19937 generator(1);
+  std::uniform_int_distribution<std::size_t> edge_distribution(
+    0, capacities.size() - 1);
+  const auto max_delta = std::max<Edge::type_length>(1, max_capacity / 10);
+  std::uniform_int_distribution<Edge::type_length> delta_distribution(
+    -max_delta, max_delta);
+  std::vector<std::vector<IncrementalMaxFlowCapacityChange>> rounds(
+    rounds_count);
+  for (auto& changes : rounds) {
+    for (std::size_t c = 0; c < changes_count; ++c) {
+      const auto e = edge_distribution(generator);
+      auto& capacity = capacities[e];
+      capacity = std::max<Edge::type_length>(
+        0, capacity + delta_distribution(generator));
+      changes.emplace_back(e, capacity);
+    }
+  }
+
+  std::vector<Edge::type_length> expected(rounds_count);
+  auto changed_vertices = vertices;
+  std::vector<Edge*> edges;
+  for (auto& vertex : changed_vertices) {
+    for (auto& edge : vertex.edges_) {
+      edges.emplace_back(&edge);
+    }
+  }
+
+  const auto from_scratch_seconds = benchmark_seconds([&] {
+    for (std::size_t r = 0; r < rounds_count; ++r) {
+      for (const auto& change : rounds[r]) {
+        edges[change.edge_]->length_ = change.capacity_;
+      }
+
+      expected[r] =
+        dinic_max_flow(changed_vertices, source_vertex, sink_vertex);
+    }
+  });
+  std::cout << "  dinic_max_flow(): " << from_scratch_seconds << "s, "
+            << from_scratch_seconds / rounds_count << "s per round"
+            << std::endl;
+
+  bool same = true;
+  ResidualGraph residual_graph(vertices);
+  Dinic dinic(residual_graph, source_vertex, sink_vertex);
+  const auto seconds = benchmark_seconds([&] {
+    for (std::size_t r = 0; r < rounds_count; ++r) {
+      for (const auto& change : rounds[r]) {
+        residual_graph.set_capacity(change.edge_, change.capacity_);
+      }
+
+      residual_graph.reset_flow();
+      if (dinic.compute() != expected[r]) {
+        same = false;
+      }
+    }
+  });
+  std::cout << "  Dinic, reusing the ResidualGraph: " << seconds << "s, "
+            << seconds / rounds_count << "s per round" << std::endl;
+
+  std::size_t repair_paths_count = 0;
+  const auto incremental_seconds = benchmark_seconds([&] {
+    IncrementalMaxFlow max_flow(vertices, source_vertex, sink_vertex);
+    for (std::size_t r = 0; r < rounds_count; ++r) {
+      max_flow.update_capacities(rounds[r]);
+      if (max_flow.get_flow_value() != expected[r]) {
+        same = false;
+      }
+    }
+
+    repair_paths_count = max_flow.repair_paths_count_;
+  });
+  std::cout << "  IncrementalMaxFlow: " << incremental_seconds
+            << "s (including the first calculation), "
+            << incremental_seconds / rounds_count
+            << "s per round, repair paths: " << repair_paths_count
+            << std::endl;
+
+  if (!same) {
+    std::cerr << "The results were not the same." << std::endl;
+  }
+
+  return same;
+}
+
+/**
+ * Usage: murrayc_incremental_max_flow_benchmark [frame_width] [rounds_count]
+ * [changes_count]
+ */
+int
+main(int argc, char** argv) {
+  const auto frame_width = benchmark_get_arg<type_num>(argc, argv, 1, 12);
+  const auto rounds_count = benchmark_get_arg<std::size_t>(argc, argv, 2, 50);
+  const auto changes_count = benchmark_get_arg<std::size_t>(argc, argv, 3, 5);
+
+  if (!benchmark_graph("GENRMF long",
+        make_rmf_graph(frame_width, frame_width * 4, 1000), 1000,
+        rounds_count, changes_count)) {
+    return EXIT_FAILURE;
+  }
+
+  if (!benchmark_graph("random level graph",
+        make_random_level_graph(frame_width * 4, frame_width * 8, 3, 1000),
+        1000, rounds_count, changes_count)) {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,319 @@
+#ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_INCREMENTAL_MAX_FLOW
+#define MURRAYC_ALGORITHMS_EXPERIMENTS_INCREMENTAL_MAX_FLOW
+
+#include "max_flow/dinic/dinic.h"
+#include "max_flow/min_cut/min_cut.h"
+#include "utils/residual_graph.h"
+#include "utils/vertex.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+/**
+ * A change to the capacity of an edge, for
+ * IncrementalMaxFlow::update_capacities().
+ */
+class IncrementalMaxFlowCapacityChange {
+public:
+  /**
+   * @param edge The index of the edge, counting the edges in order of their
+   * source vertex, as for ResidualGraph::get_flow().
+   */
+  IncrementalMaxFlowCapacityChange(std::size_t edge, Edge::type_length capacity)
+  : edge_(edge), capacity_(capacity) {}
+
+  std::size_t edge_;
+  Edge::type_length capacity_;
+};
+
+/**
+ * The maximum flow from a source to a sink, kept up to date while the
+ * capacities of the edges change, by repairing the existing flow instead of
+ * calculating it again from nothing.
+ *
+ * A capacity increase keeps the flow valid, though it might no longer be a
+ * maximum flow. A capacity decrease below an edge's flow removes the extra
+ * flow from the edge, which leaves that much excess flow at its source
+ * vertex, and a deficit at its destination vertex. Each excess is sent, along
+ * the shortest path in the residual graph, to a vertex with a deficit, or
+ * back to the source, or on to the sink, and then each deficit is filled,
+ * along the shortest path, from the source or the sink. Such paths always
+ * exist, because the excess flow must have come from somewhere. That gives a
+ * valid flow again, close to the old one, so Dinic's algorithm then only
+ * needs a few augmenting paths to make it a maximum flow again.
+ */
+class IncrementalMaxFlow {
+public:
+  /**
+   * Calculate the initial maximum flow, with Dinic's algorithm.
+   */
+  IncrementalMaxFlow(const type_vec_nodes& vertices, type_num source_vertex,
+    type_num sink_vertex)
+  : residual_graph_(vertices),
+    source_vertex_(source_vertex),
+    sink_vertex_(sink_vertex),
+    dinic_(residual_graph_, source_vertex, sink_vertex),
+    excesses_(residual_graph_.size()),
+    repair_paths_count_(0),
+    predecessor_arcs_(residual_graph_.size(), NONE) {
+    if (!has_valid_terminals()) {
+      std::cerr << "IncrementalMaxFlow(): invalid source or sink vertex."
+                << std::endl;
+      return;
+    }
+
+    dinic_.compute();
+  }
+
+  IncrementalMaxFlow(const IncrementalMaxFlow& src) = delete;
+  IncrementalMaxFlow&
+  operator=(const IncrementalMaxFlow& src) = delete;
+
+  /**
+   * The value of the maximum flow, as the net flow into the sink.
+   * @result 0 if the source or sink was not valid.
+   */
+  Edge::type_length
+  get_flow_value() const {
+    Edge::type_length result = 0;
+    if (!has_valid_terminals()) {
+      return result;
+    }
+
+    const auto end = residual_graph_.offsets_[sink_vertex_ + 1];
+    for (auto arc = residual_graph_.offsets_[sink_vertex_]; arc < end;
+         ++arc) {
+      // The flow along a reverse arc's edge, into the sink, is its remaining
+      // capacity, and the flow along an edge out of the sink is its capacity
+      // minus its remaining capacity.
+      result +=
+        residual_graph_.residuals_[arc] - residual_graph_.capacities_[arc];
+    }
+
+    return result;
+  }
+
+  /**
+   * The minimum cut, from the last search of Dinic's algorithm.
+   * @result An empty cut if the source or sink was not valid.
+   */
+  MinCut
+  get_min_cut() const {
+    if (!has_valid_terminals()) {
+      return MinCut();
+    }
+
+    return ::get_min_cut(residual_graph_, dinic_.levels_);
+  }
+
+  /**
+   * Change the capacities of several edges, and then repair the maximum flow
+   * once, which is cheaper than repairing it after each change.
+   *
+   * @result false if a change was not valid, in which case no changes are
+   * made.
+   */
+  bool
+  update_capacities(
+    const std::vector<IncrementalMaxFlowCapacityChange>& changes) {
+    if (!has_valid_terminals()) {
+      return false;
+    }
+
+    const auto edges_count = residual_graph_.edge_arcs_.size();
+    for (const auto& change : changes) {
+      if (change.edge_ >= edges_count) {
+        std::cerr << "update_capacities(): edge not found: " << change.edge_
+                  << std::endl;
+        return false;
+      }
+
+      if (change.capacity_ < 0) {
+        std::cerr << "update_capacities(): negative capacities are not "
+                     "supported."
+                  << std::endl;
+        return false;
+      }
+    }
+
+    unbalanced_vertices_.clear();
+
+    auto& residuals = residual_graph_.residuals_;
+    auto& capacities = residual_graph_.capacities_;
+    for (const auto& change : changes) {
+      const auto arc = residual_graph_.edge_arcs_[change.edge_];
+      const auto reverse_arc = residual_graph_.reverse_arcs_[arc];
+      const auto flow = capacities[arc] - residuals[arc];
+      if (change.capacity_ >= flow) {
+        residuals[arc] += change.capacity_ - capacities[arc];
+        capacities[arc] = change.capacity_;
+        continue;
+      }
+
+      // Remove the flow that no longer fits:
+      const auto removed = flow - change.capacity_;
+      capacities[arc] = change.capacity_;
+      residuals[arc] = 0;
+      residuals[reverse_arc] -= removed;
+
+      const auto u = residual_graph_.destinations_[reverse_arc];
+      const auto v = residual_graph_.destinations_[arc];
+      add_excess(u, removed);
+      add_excess(v, -removed);
+    }
+
+    // Send the excesses away, and then fill the deficits.
+    // The repairs don't add any unbalanced vertices.
+    for (const auto v : unbalanced_vertices_) {
+      while (excesses_[v] > 0) {
+        if (!repair(v, true /* forwards */)) {
+          return false;
+        }
+      }
+    }
+
+    for (const auto v : unbalanced_vertices_) {
+      while (excesses_[v] < 0) {
+        if (!repair(v, false /* forwards */)) {
+          return false;
+        }
+      }
+    }
+
+    dinic_.compute();
+    return true;
+  }
+
+  ResidualGraph residual_graph_;
+  const type_num source_vertex_;
+  const type_num sink_vertex_;
+  Dinic dinic_;
+
+  // The excess flow (inflow minus outflow) of each vertex, other than the
+  // source and the sink, during update_capacities(). Otherwise, all 0.
+  std::vector<Edge::type_length> excesses_;
+  std::vector<type_num> unbalanced_vertices_;
+
+  // The number of paths used to repair the flow, for benchmarks.
+  std::size_t repair_paths_count_;
+
+private:
+  static constexpr std::size_t NONE = std::numeric_limits<std::size_t>::max();
+
+  bool
+  has_valid_terminals() const {
+    const auto vertices_count = residual_graph_.size();
+    return source_vertex_ < vertices_count && sink_vertex_ < vertices_count &&
+           source_vertex_ != sink_vertex_;
+  }
+
+  void
+  add_excess(type_num v, Edge::type_length excess) {
+    if (v == source_vertex_ || v == sink_vertex_) {
+      // The source and sink can have any excess.
+      return;
+    }
+
+    if (excesses_[v] == 0) {
+      unbalanced_vertices_.emplace_back(v);
+    }
+
+    excesses_[v] += excess;
+  }
+
+  /**
+   * Whether flow can end, or start, at the vertex, while repairing the flow
+   * of a vertex with an excess, or a deficit.
+   */
+  bool
+  is_repair_target(type_num v, bool forwards) const {
+    return v == source_vertex_ || v == sink_vertex_ ||
+           (forwards ? excesses_[v] < 0 : excesses_[v] > 0);
+  }
+
+  /**
+   * Find the shortest path in the residual graph from @a start to a vertex
+   * that can take its excess, if @a forwards, or otherwise from a vertex that
+   * can fill its deficit, with a BFS, and send as much flow along it as
+   * possible.
+   * @result false if there is no such path, which should not happen.
+   */
+  bool
+  repair(type_num start, bool forwards) {
+    ++repair_paths_count_;
+
+    const auto& residuals = residual_graph_.residuals_;
+    const auto& destinations = residual_graph_.destinations_;
+    const auto& reverse_arcs = residual_graph_.reverse_arcs_;
+
+    // The arc used to reach each vertex, which leads from the vertex when
+    // searching backwards:
+    auto& queue = queue_;
+    queue.clear();
+    queue.emplace_back(start);
+    predecessor_arcs_[start] = residual_graph_.arcs_count();
+
+    auto target = start;
+    for (std::size_t i = 0; i < queue.size() && target == start; ++i) {
+      const auto x = queue[i];
+      const auto end = residual_graph_.offsets_[x + 1];
+      for (auto a = residual_graph_.offsets_[x]; a < end; ++a) {
+        const auto y = destinations[a];
+        const auto arc = forwards ? a : reverse_arcs[a];
+        if (predecessor_arcs_[y] != NONE || residuals[arc] == 0) {
+          continue;
+        }
+
+        predecessor_arcs_[y] = arc;
+        queue.emplace_back(y);
+        if (is_repair_target(y, forwards)) {
+          target = y;
+          break;
+        }
+      }
+    }
+
+    if (target == start) {
+      std::cerr << "update_capacities(): no path to repair the flow of vertex "
+                << start << std::endl;
+      return false;
+    }
+
+    // Find the bottleneck, including the excesses:
+    auto c = std::abs(excesses_[start]);
+    if (target != source_vertex_ && target != sink_vertex_) {
+      c = std::min(c, std::abs(excesses_[target]));
+    }
+
+    for (auto y = target; y != start;) {
+      const auto arc = predecessor_arcs_[y];
+      c = std::min(c, residuals[arc]);
+      y = forwards ? destinations[reverse_arcs[arc]] : destinations[arc];
+    }
+
+    for (auto y = target; y != start;) {
+      const auto arc = predecessor_arcs_[y];
+      residual_graph_.push(arc, c);
+      y = forwards ? destinations[reverse_arcs[arc]] : destinations[arc];
+    }
+
+    const auto moved = forwards ? c : -c;
+    excesses_[start] -= moved;
+    add_excess(target, moved);
+
+    for (const auto v : queue) {
+      predecessor_arcs_[v] = NONE;
+    }
+
+    return true;
+  }
+
+  std::vector<std::size_t> predecessor_arcs_;
+  std::vector<type_num> queue_;
+};
+
+constexpr std::size_t IncrementalMaxFlow::NONE;
+
+#endif // MURRAYC_ALGORITHMS_EXPERIMENTS_INCREMENTAL_MAX_FLOW
@@ -0,0 +1,165 @@
+#include "incremental_max_flow.h"
+#include "max_flow/dinic/dinic.h"
+#include "utils/random_graphs.h"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+/**
+ * Check that the flow is a valid flow, within the capacities, with as much
+ * flow into each vertex as out of it, other than the source and sink, and
+ * that it is a maximum flow, by comparing it with a new calculation, and with
+ * the minimum cut.
+ */
+static void
+check_flow(const IncrementalMaxFlow& max_flow, const type_vec_nodes& vertices) {
+  const auto& residual_graph = max_flow.residual_graph_;
+  std::vector<Edge::type_length> excesses(vertices.size());
+  std::size_t i = 0;
+  for (type_num u = 0; u < vertices.size(); ++u) {
+    for (const auto& edge : vertices[u].edges_) {
+      const auto flow = residual_graph.get_flow(i++);
+      assert(flow >= 0);
+      assert(flow <= edge.length_);
+      excesses[u] -= flow;
+      excesses[edge.destination_vertex_] += flow;
+    }
+  }
+
+  for (type_num v = 0; v < vertices.size(); ++v) {
+    if (v == max_flow.source_vertex_) {
+      assert(excesses[v] == -max_flow.get_flow_value());
+    } else if (v == max_flow.sink_vertex_) {
+      assert(excesses[v] == max_flow.get_flow_value());
+    } else {
+      assert(excesses[v] == 0);
+      assert(max_flow.excesses_[v] == 0);
+    }
+  }
+
+  const auto expected = dinic_max_flow(
+    vertices, max_flow.source_vertex_, max_flow.sink_vertex_);
+  assert(max_flow.get_flow_value() == expected);
+  assert(max_flow.get_min_cut().capacity_ == expected);
+}
+
+static void
+test_small() {
+  // As in the Dinic test, with the maximum flow along 0, 1, 3, 5 and
+  // 0, 2, 4, 5:
+  type_vec_nodes graph = {Vertex({Edge(1, 1), Edge(2, 1)}),
+    Vertex({Edge(4, 1), Edge(3, 1)}), Vertex({Edge(4, 1)}),
+    Vertex({Edge(5, 1)}), Vertex({Edge(5, 1)}), Vertex()};
+  IncrementalMaxFlow max_flow(graph, 0, 5);
+  assert(max_flow.get_flow_value() == 2);
+  check_flow(max_flow, graph);
+
+  // Remove the edge from 1 to 3, so the flow from 1 must go to 4 instead,
+  // which then leaves no room for the flow from 2:
+  assert(max_flow.update_capacities({IncrementalMaxFlowCapacityChange(3, 0)}));
+  graph[1].edges_[1].length_ = 0;
+  assert(max_flow.get_flow_value() == 1);
+  check_flow(max_flow, graph);
+
+  // Widen the edge from 4 to 5 too:
+  assert(max_flow.update_capacities({IncrementalMaxFlowCapacityChange(6, 2)}));
+  graph[4].edges_[0].length_ = 2;
+  assert(max_flow.get_flow_value() == 2);
+  check_flow(max_flow, graph);
+
+  // Put the edge back, and narrow both of the source's edges:
+  assert(max_flow.update_capacities({IncrementalMaxFlowCapacityChange(3, 1),
+    IncrementalMaxFlowCapacityChange(0, 0),
+    IncrementalMaxFlowCapacityChange(1, 0)}));
+  graph[1].edges_[1].length_ = 1;
+  graph[0].edges_[0].length_ = 0;
+  graph[0].edges_[1].length_ = 0;
+  assert(max_flow.get_flow_value() == 0);
+  check_flow(max_flow, graph);
+
+  // Invalid changes:
+  assert(!max_flow.update_capacities({IncrementalMaxFlowCapacityChange(7, 1)}));
+  assert(
+    !max_flow.update_capacities({IncrementalMaxFlowCapacityChange(0, -1)}));
+  check_flow(max_flow, graph);
+}
+
+/**
+ * Change a few random capacities at a time, comparing the repaired flow with
+ * a new calculation.
+ */
+static void
+check_random_changes(type_vec_nodes vertices, type_num source_vertex,
+  type_num sink_vertex, Edge::type_length max_capacity) {
+  IncrementalMaxFlow max_flow(vertices, source_vertex, sink_vertex);
+  check_flow(max_flow, vertices);
+
+  std::vector<Edge*> edges;
+  for (auto& vertex : vertices) {
+    for (auto& edge : vertex.edges_) {
+      edges.emplace_back(&edge);
+    }
+  }
+
+  std::mt19937 generator(1);
+  std::uniform_int_distribution<std::size_t> edge_distribution(
+    0, edges.size() - 1);
+  std::uniform_int_distribution<Edge::type_length> capacity_distribution(
+    0, max_capacity);
+  std::uniform_int_distribution<std::size_t> count_distribution(1, 5);
+  for (int i = 0; i < 50; ++i) {
+    std::vector<IncrementalMaxFlowCapacityChange> changes;
+    const auto count = count_distribution(generator);
+    for (std::size_t c = 0; c < count; ++c) {
+      const auto e = edge_distribution(generator);
+      const auto capacity = capacity_distribution(generator);
+      changes.emplace_back(e, capacity);
+      edges[e]->length_ = capacity;
+    }
+
+    assert(max_flow.update_capacities(changes));
+    check_flow(max_flow, vertices);
+  }
+}
+
+static void
+test_invalid_terminals() {
+  const type_vec_nodes graph = {
+    Vertex({Edge(1, 1)}), Vertex({Edge(2, 1)}), Vertex()};
+
+  // The sink is not in the graph:
+  IncrementalMaxFlow max_flow(graph, 0, 3);
+  assert(max_flow.get_flow_value() == 0);
+  assert(max_flow.get_min_cut().edges_.empty());
+  assert(!max_flow.update_capacities({IncrementalMaxFlowCapacityChange(0, 2)}));
+
+  // The source is the sink:
+  IncrementalMaxFlow same_max_flow(graph, 1, 1);
+  assert(same_max_flow.get_flow_value() == 0);
+  assert(same_max_flow.get_min_cut().edges_.empty());
+}
+
+static void
+test_random() {
+  for (unsigned int seed = 0; seed < 5; ++seed) {
+    check_random_changes(make_random_graph(100, 500, 50, seed), 0, 99, 50);
+    check_random_changes(
+      make_random_graph(100, 500, 50, seed), seed, 50 + seed, 50);
+  }
+
+  const auto level_graph = make_random_level_graph(10, 20, 3, 100);
+  check_random_changes(level_graph, 0, level_graph.size() - 1, 100);
+
+  const auto grid_graph = make_random_grid_graph(15, 15, 10);
+  check_random_changes(grid_graph, 0, grid_graph.size() - 1, 10);
+}
+
+int
+main() {
+  test_small();
+  test_invalid_terminals();
+  test_random();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,109 @@
+#include "min_cut.h"
+#include "max_flow/dinic/dinic.h"
+#include "max_flow/ford_fulkerson/ford_fulkerson.h"
+#include "utils/random_graphs.h"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * Check that the cut separates the source from the sink, that its edges are
+ * exactly those from the source's side to the other side, and that they are
+ * saturated, with a total capacity of the maximum flow.
+ */
+static void
+check_min_cut(const MinCut& cut, const ResidualGraph& residual_graph,
+  type_num source_vertex, type_num sink_vertex, Edge::type_length max_flow) {
+  assert(cut.source_side_[source_vertex]);
+  assert(!cut.source_side_[sink_vertex]);
+  assert(cut.capacity_ == max_flow);
+
+  std::size_t cut_edges_count = 0;
+  const auto edges_count = residual_graph.edge_arcs_.size();
+  for (std::size_t i = 0; i < edges_count; ++i) {
+    const auto arc = residual_graph.edge_arcs_[i];
+
+    // The reverse arc leads back to the edge's source vertex:
+    const auto u =
+      residual_graph.destinations_[residual_graph.reverse_arcs_[arc]];
+    const auto v = residual_graph.destinations_[arc];
+    if (cut.source_side_[u] && !cut.source_side_[v]) {
+      assert(cut_edges_count < cut.edges_.size());
+      assert(cut.edges_[cut_edges_count] == i);
+      assert(residual_graph.get_flow(i) == residual_graph.capacities_[arc]);
+      ++cut_edges_count;
+    }
+  }
+
+  assert(cut_edges_count == cut.edges_.size());
+}
+
+static void
+test_small() {
+  // The edges from 1 to 3 and from 2 to 4 are the bottleneck:
+  const type_vec_nodes graph = {Vertex({Edge(1, 10), Edge(2, 10)}),
+    Vertex({Edge(2, 5), Edge(3, 3)}), Vertex({Edge(4, 4)}),
+    Vertex({Edge(5, 10)}), Vertex({Edge(5, 10)}), Vertex()};
+
+  ResidualGraph residual_graph(graph);
+  BfsWorkspace workspace;
+  assert(ford_fulkerson_max_flow(residual_graph, 0, 5, workspace) == 7);
+  const auto cut = get_min_cut(residual_graph, workspace);
+  assert(cut.source_side_ ==
+         std::vector<bool>({true, true, true, false, false, false}));
+  assert(cut.edges_ == std::vector<std::size_t>({3, 4}));
+  assert(cut.capacity_ == 7);
+  check_min_cut(cut, residual_graph, 0, 5, 7);
+
+  ResidualGraph dinic_residual_graph(graph);
+  Dinic dinic(dinic_residual_graph, 0, 5);
+  assert(dinic.compute() == 7);
+  const auto dinic_cut = get_min_cut(dinic_residual_graph, dinic.levels_);
+  assert(dinic_cut.source_side_ == cut.source_side_);
+  assert(dinic_cut.edges_ == cut.edges_);
+}
+
+static void
+check_graph(const type_vec_nodes& vertices, type_num source_vertex,
+  type_num sink_vertex) {
+  const auto max_flow = dinic_max_flow(vertices, source_vertex, sink_vertex);
+
+  ResidualGraph residual_graph(vertices);
+  BfsWorkspace workspace;
+  assert(ford_fulkerson_max_flow(residual_graph, source_vertex, sink_vertex,
+           workspace) == max_flow);
+  check_min_cut(get_min_cut(residual_graph, workspace), residual_graph,
+    source_vertex, sink_vertex, max_flow);
+
+  residual_graph.reset_flow();
+  Dinic dinic(residual_graph, source_vertex, sink_vertex);
+  assert(dinic.compute() == max_flow);
+  check_min_cut(get_min_cut(residual_graph, dinic.levels_), residual_graph,
+    source_vertex, sink_vertex, max_flow);
+
+  assert(ford_fulkerson_max_flow(vertices, source_vertex, sink_vertex) ==
+         max_flow);
+}
+
+static void
+test_random() {
+  for (unsigned int seed = 0; seed < 20; ++seed) {
+    const auto graph = make_random_graph(200, 1000, 50, seed);
+    check_graph(graph, 0, 199);
+    check_graph(graph, seed, 100 + seed);
+  }
+
+  const auto rmf_graph = make_rmf_graph(5, 6, 100);
+  check_graph(rmf_graph, 0, rmf_graph.size() - 1);
+
+  const auto level_graph = make_random_level_graph(10, 20, 3, 100);
+  check_graph(level_graph, 0, level_graph.size() - 1);
+}
+
+int
+main() {
+  test_small();
+  test_random();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,66 @@
+#ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_MIN_CUT
+#define MURRAYC_ALGORITHMS_EXPERIMENTS_MIN_CUT
+
+#include "shortest_path/breadth_first_search/breadth_first_search.h"
+#include "utils/residual_graph.h"
+#include <vector>
+
+/**
+ * A minimum cut, which separates the source from the sink, with the least
+ * total capacity, which is the value of the maximum flow.
+ */
+class MinCut {
+public:
+  MinCut() : capacity_(0) {}
+
+  // Whether each vertex is on the source's side of the cut.
+  std::vector<bool> source_side_;
+
+  // The edges from the source's side to the sink's side, as the indices of
+  // the original graph's edges, as for ResidualGraph::get_flow().
+  std::vector<std::size_t> edges_;
+
+  // The total capacity of the edges.
+  Edge::type_length capacity_;
+};
+
+/**
+ * Get the minimum cut after a maximum flow calculation, from its last search
+ * from the source in the residual graph, which didn't reach the sink, such as
+ * the BfsWorkspace passed to ford_fulkerson_max_flow(), or Dinic::levels_.
+ *
+ * The vertices that the search reached are the source's side of the cut.
+ * They can't be reached in the residual graph by any more flow, so every edge
+ * from them to the other vertices must be saturated, and the cut's capacity
+ * is the flow's value. This just looks at the edges, without searching again.
+ */
+static MinCut
+get_min_cut(
+  const ResidualGraph& residual_graph, const BfsWorkspace& last_search) {
+  MinCut result;
+
+  const auto vertices_count = residual_graph.size();
+  result.source_side_.resize(vertices_count);
+  for (ResidualGraph::type_num v = 0; v < vertices_count; ++v) {
+    result.source_side_[v] = last_search.is_reached(v);
+  }
+
+  const auto& edge_arcs = residual_graph.edge_arcs_;
+  const auto edges_count = edge_arcs.size();
+  for (std::size_t i = 0; i < edges_count; ++i) {
+    const auto arc = edge_arcs[i];
+
+    // The reverse arc leads back to the edge's source vertex:
+    const auto u =
+      residual_graph.destinations_[residual_graph.reverse_arcs_[arc]];
+    const auto v = residual_graph.destinations_[arc];
+    if (result.source_side_[u] && !result.source_side_[v]) {
+      result.edges_.emplace_back(i);
+      result.capacity_ += residual_graph.capacities_[arc];
+    }
+  }
+
+  return result;
+}
+
+#endif // MURRAYC_ALGORITHMS_EXPERIMENTS_MIN_CUT
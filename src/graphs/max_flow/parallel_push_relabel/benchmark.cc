@@ -0,0 +1,97 @@
+#include "parallel_push_relabel.h"
+#include "max_flow/push_relabel/push_relabel.h"
+#include "utils/benchmark.h"
+#include "utils/random_graphs.h"
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+/**
+ * Compare parallel_push_relabel_max_flow(), with 1, 2, 4, etc threads, up to
+ * @a max_threads_count, with push_relabel_max_flow().
+ * @result false if the results were not the same.
+ */
+static bool
+benchmark_graph(const std::string& name, const type_vec_nodes& vertices,
+  std::size_t max_threads_count) {
+  const auto vertices_count = vertices.size();
+  std::size_t edges_count = 0;
+  for (const auto& vertex : vertices) {
+    edges_count += vertex.edges_.size();
+  }
+
+  std::cout << name << ", vertices: " << vertices_count
+            << ", edges: " << edges_count << std::endl;
+
+  const type_num source_vertex = 0;
+  const type_num sink_vertex = vertices_count - 1;
+
+  Edge::type_length expected = 0;
+  const auto serial_seconds = benchmark_seconds([&] {
+    expected = push_relabel_max_flow(vertices, source_vertex, sink_vertex);
+  });
+  std::cout << "  push_relabel_max_flow(): " << serial_seconds
+            << "s, max flow: " << expected << std::endl;
+
+  for (std::size_t threads_count = 1; threads_count <= max_threads_count;
+       threads_count *= 2) {
+    ThreadPool thread_pool(threads_count);
+
+    // Build the residual graph in the timing too,
+    // as push_relabel_max_flow() does:
+    Edge::type_length result = 0;
+    std::size_t rounds_count = 0;
+    std::size_t global_relabels_count = 0;
+    const auto seconds = benchmark_seconds([&] {
+      ResidualGraph residual_graph(vertices);
+      ParallelPushRelabel push_relabel(
+        residual_graph, source_vertex, sink_vertex, thread_pool);
+      result = push_relabel.compute();
+      rounds_count = push_relabel.rounds_count_;
+      global_relabels_count = push_relabel.global_relabels_count_;
+    });
+    std::cout << "  parallel push-relabel, " << threads_count
+              << " threads: " << seconds
+              << "s, speedup: " << serial_seconds / seconds
+              << ", rounds: " << rounds_count
+              << ", global relabels: " << global_relabels_count << std::endl;
+
+    if (result != expected) {
+      std::cerr << "The results were not the same." << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Usage: murrayc_parallel_push_relabel_benchmark [width] [max_threads_count]
+ *
+ * The graphs are grids like those used to segment images with graph cuts,
+ * with a vertex per pixel, and a GENRMF "wide" network, for comparison.
+ */
+int
+main(int argc, char** argv) {
+  const auto width = benchmark_get_arg<type_num>(argc, argv, 1, 512);
+  const auto max_threads_count = benchmark_get_arg<std::size_t>(
+    argc, argv, 2, std::max(1u, std::thread::hardware_concurrency()));
+
+  if (!benchmark_graph("segmentation grid",
+        make_segmentation_grid_graph(width, width, 1000), max_threads_count)) {
+    return EXIT_FAILURE;
+  }
+
+  if (!benchmark_graph("segmentation grid, wide",
+        make_segmentation_grid_graph(width * 2, width / 2, 1000),
+        max_threads_count)) {
+    return EXIT_FAILURE;
+  }
+
+  if (!benchmark_graph("GENRMF wide",
+        make_rmf_graph(width / 8, width / 64, 1000), max_threads_count)) {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
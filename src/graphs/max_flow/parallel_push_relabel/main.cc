@@ -0,0 +1,95 @@
+#include "parallel_push_relabel.h"
+#include "max_flow/push_relabel/push_relabel.h"
+#include "utils/csr_graph.h"
+#include "utils/example_graphs.h"
+#include "utils/random_graphs.h"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * Check the maximum flow against push_relabel_max_flow(), with several
+ * numbers of threads, so the threads interleave differently, even on one
+ * core.
+ */
+static void
+check_graph(const type_vec_nodes& vertices, type_num source_vertex,
+  type_num sink_vertex) {
+  const auto expected =
+    push_relabel_max_flow(vertices, source_vertex, sink_vertex);
+
+  for (const std::size_t threads_count : {1, 2, 4}) {
+    ThreadPool thread_pool(threads_count);
+    assert(parallel_push_relabel_max_flow(
+             vertices, source_vertex, sink_vertex, thread_pool) == expected);
+  }
+}
+
+static void
+test_small() {
+  check_graph(EXAMPLE_GRAPH_SMALL_FOR_FLOW, 0, 3);
+  check_graph(EXAMPLE_GRAPH_SMALL_FOR_FLOW, 0, 2);
+  check_graph(EXAMPLE_GRAPH_SMALL_FOR_FLOW, 2, 3);
+
+  // Using all cores:
+  const auto max_flow =
+    parallel_push_relabel_max_flow(EXAMPLE_GRAPH_SMALL_FOR_FLOW, 0, 3);
+  std::cout << "max flow from 0 to 3: " << max_flow << std::endl;
+  assert(max_flow == 5);
+}
+
+static void
+test_undo() {
+  // If the flow first goes along 0, 1, 2, 3, then some of it must be undone,
+  // via the reverse edge from 2 to 1, to get the maximum flow:
+  const type_vec_nodes graph = {Vertex({Edge(1, 1), Edge(2, 1)}),
+    Vertex({Edge(2, 1), Edge(3, 1)}), Vertex({Edge(3, 1)}), Vertex()};
+  assert(parallel_push_relabel_max_flow(graph, 0, 3) == 2);
+
+  // No path:
+  assert(parallel_push_relabel_max_flow(graph, 3, 0) == 0);
+}
+
+static void
+test_random() {
+  for (unsigned int seed = 0; seed < 20; ++seed) {
+    const auto graph = make_random_graph(200, 1000, 50, seed);
+    check_graph(graph, 0, 199);
+    check_graph(graph, seed, 100 + seed);
+  }
+
+  const auto rmf_graph = make_rmf_graph(5, 6, 100);
+  check_graph(rmf_graph, 0, rmf_graph.size() - 1);
+
+  const auto level_graph = make_random_level_graph(10, 20, 3, 100);
+  check_graph(level_graph, 0, level_graph.size() - 1);
+
+  const auto grid_graph = make_random_grid_graph(20, 20, 10);
+  check_graph(grid_graph, 0, grid_graph.size() - 1);
+
+  for (unsigned int seed = 0; seed < 5; ++seed) {
+    const auto segmentation_graph =
+      make_segmentation_grid_graph(40, 30, 100, seed);
+    check_graph(segmentation_graph, 0, segmentation_graph.size() - 1);
+  }
+}
+
+static void
+test_csr_graph() {
+  const auto graph = make_segmentation_grid_graph(30, 30, 100);
+  const auto expected = push_relabel_max_flow(graph, 0, graph.size() - 1);
+
+  ThreadPool thread_pool(2);
+  assert(parallel_push_relabel_max_flow(
+           CsrGraph(graph), 0, graph.size() - 1, thread_pool) == expected);
+}
+
+int
+main() {
+  test_small();
+  test_undo();
+  test_random();
+  test_csr_graph();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,446 @@
+#ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_PARALLEL_PUSH_RELABEL
+#define MURRAYC_ALGORITHMS_EXPERIMENTS_PARALLEL_PUSH_RELABEL
+
+#include "utils/residual_graph.h"
+#include "utils/thread_pool.h"
+#include "utils/vertex.h"
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <vector>
+
+// A set of vertices and their edges.
+using type_vec_nodes = std::vector<Vertex>;
+
+using type_num = Edge::type_num;
+
+/**
+ * The state of one parallel_push_relabel_max_flow() calculation.
+ *
+ * This works in rounds. In each round, the active vertices, which have
+ * excess flow, are shared between the @a thread_pool's threads, like a work
+ * queue, and each thread discharges its vertices. Each active vertex is in
+ * the list only once, so only one thread discharges it, and only that thread
+ * changes its label or takes flow away from it, so there are no locks. Other
+ * threads can still push flow to it, and along the reverses of its arcs, so
+ * the excesses and remaining capacities are updated with atomic additions.
+ * A vertex that gets excess is added to the pushing thread's part of the
+ * next round's list by whichever thread first claims it for that round, with
+ * a compare-exchange, so it is in the list only once.
+ *
+ * Like Hong and He's lock-free push-relabel, a vertex doesn't wait until an
+ * arc is admissible. It always looks at all its arcs, pushes to its lowest
+ * neighbour in the residual graph if that is lower than itself, and
+ * otherwise relabels itself to one more than that neighbour, so a vertex
+ * never needs to see its neighbours' labels and remaining capacities at
+ * any particular moment.
+ *
+ * The global relabels are parallel backwards BFSs from the sink, done
+ * between rounds, when the threads are not pushing. As in PushRelabel, the
+ * vertices with a label of n are just left alone.
+ */
+class ParallelPushRelabel {
+public:
+  ParallelPushRelabel(ResidualGraph& residual_graph, type_num source_vertex,
+    type_num sink_vertex, ThreadPool& thread_pool)
+  : residual_graph_(residual_graph),
+    source_vertex_(source_vertex),
+    sink_vertex_(sink_vertex),
+    thread_pool_(thread_pool),
+    vertices_count_(residual_graph.size()),
+    arcs_count_(residual_graph.arcs_count()),
+    labels_(vertices_count_),
+    excesses_(vertices_count_),
+    residuals_(arcs_count_),
+    queued_rounds_(vertices_count_),
+    threads_(thread_pool.size()),
+    rounds_count_(0),
+    pushes_count_(0),
+    relabels_count_(0),
+    global_relabels_count_(0) {}
+
+  /**
+   * Find the value of the maximum flow, adding to any flow already in the
+   * residual graph.
+   * @result The flow added.
+   */
+  Edge::type_length
+  compute() {
+    // Work on atomic copies of the remaining capacities:
+    thread_pool_.parallel_for(arcs_count_,
+      [this](std::size_t arc, std::size_t /* thread_index */) {
+        residuals_[arc].store(
+          residual_graph_.residuals_[arc], std::memory_order_relaxed);
+      },
+      ATOMICS_CHUNK_SIZE);
+
+    thread_pool_.parallel_for(vertices_count_,
+      [this](std::size_t v, std::size_t /* thread_index */) {
+        excesses_[v].store(0, std::memory_order_relaxed);
+        queued_rounds_[v].store(0, std::memory_order_relaxed);
+      },
+      ATOMICS_CHUNK_SIZE);
+
+    // Saturate the source's arcs:
+    const auto end = residual_graph_.offsets_[source_vertex_ + 1];
+    for (auto arc = residual_graph_.offsets_[source_vertex_]; arc < end;
+         ++arc) {
+      const auto capacity = residuals_[arc].load(std::memory_order_relaxed);
+      if (capacity > 0) {
+        push(arc, residual_graph_.destinations_[arc], capacity, 0);
+        excesses_[source_vertex_].fetch_sub(
+          capacity, std::memory_order_relaxed);
+      }
+    }
+
+    // The source's arcs have made the first round's active vertices, but the
+    // global relabel finds them again.
+    for (auto& thread : threads_) {
+      thread.next_active_.clear();
+    }
+
+    global_relabel();
+
+    // A vertex can be left with excess if its last look at its neighbours
+    // was out of date, so check with a final global relabel that no excess
+    // can still reach the sink, as it couldn't in the sequential algorithm.
+    while (!active_.empty()) {
+      while (!active_.empty()) {
+        compute_round();
+      }
+
+      global_relabel();
+    }
+
+    // Copy the remaining capacities back:
+    thread_pool_.parallel_for(arcs_count_,
+      [this](std::size_t arc, std::size_t /* thread_index */) {
+        residual_graph_.residuals_[arc] =
+          residuals_[arc].load(std::memory_order_relaxed);
+      },
+      ATOMICS_CHUNK_SIZE);
+
+    return excesses_[sink_vertex_].load(std::memory_order_relaxed);
+  }
+
+  /**
+   * The work of each thread, in its own object, so no thread writes to
+   * another's.
+   */
+  class ThreadState {
+  public:
+    ThreadState() : work_(0), pushes_count_(0), relabels_count_(0) {}
+
+    // The vertices that got excess from this thread's pushes,
+    // or that this thread found in a global relabel.
+    std::vector<type_num> next_active_;
+
+    // The vertices found by this thread in a global relabel's current level.
+    std::vector<type_num> next_frontier_;
+
+    // The number of arcs examined by relabels since the last global relabel,
+    // plus a constant per relabel.
+    std::size_t work_;
+
+    std::size_t pushes_count_;
+    std::size_t relabels_count_;
+  };
+
+  ResidualGraph& residual_graph_;
+  const type_num source_vertex_;
+  const type_num sink_vertex_;
+  ThreadPool& thread_pool_;
+  const std::size_t vertices_count_;
+  const std::size_t arcs_count_;
+
+  std::vector<std::atomic<type_num>> labels_;
+  std::vector<std::atomic<Edge::type_length>> excesses_;
+
+  // The remaining capacities, copied from the residual graph in compute(),
+  // and back again at the end.
+  std::vector<std::atomic<Edge::type_length>> residuals_;
+
+  // The last round for whose list each vertex was claimed.
+  std::vector<std::atomic<std::size_t>> queued_rounds_;
+
+  // The vertices to discharge in this round.
+  std::vector<type_num> active_;
+
+  // The current level of a global relabel's BFS.
+  std::vector<type_num> frontier_;
+
+  std::vector<ThreadState> threads_;
+
+  // Statistics, for benchmarks.
+  std::size_t rounds_count_;
+  std::size_t pushes_count_;
+  std::size_t relabels_count_;
+  std::size_t global_relabels_count_;
+
+private:
+  // As in PushRelabel.
+  static constexpr std::size_t GLOBAL_RELABEL_WORK_FACTOR = 6;
+  static constexpr std::size_t RELABEL_WORK = 12;
+
+  // The number of array elements to give to a thread at a time when copying
+  // or initializing them.
+  static constexpr std::size_t ATOMICS_CHUNK_SIZE = 4096;
+
+  /**
+   * Discharge this round's active vertices, and then do a global relabel if
+   * the threads have done enough work since the last one, or just gather the
+   * next round's active vertices.
+   */
+  void
+  compute_round() {
+    ++rounds_count_;
+
+    thread_pool_.parallel_for(
+      active_.size(), [this](std::size_t i, std::size_t thread_index) {
+        discharge(active_[i], thread_index);
+      });
+
+    std::size_t work = 0;
+    for (auto& thread : threads_) {
+      work += thread.work_;
+      pushes_count_ += thread.pushes_count_;
+      relabels_count_ += thread.relabels_count_;
+      thread.pushes_count_ = 0;
+      thread.relabels_count_ = 0;
+    }
+
+    if (work > GLOBAL_RELABEL_WORK_FACTOR * vertices_count_ + arcs_count_) {
+      for (auto& thread : threads_) {
+        thread.next_active_.clear();
+      }
+
+      global_relabel();
+      return;
+    }
+
+    gather(&ThreadState::next_active_, active_);
+  }
+
+  /**
+   * Send @a flow along the arc to @a v, taking it from the excess of the
+   * arc's vertex, which only the calling thread may do.
+   */
+  void
+  push(std::size_t arc, type_num v, Edge::type_length flow,
+    std::size_t thread_index) {
+    residuals_[arc].fetch_sub(flow, std::memory_order_relaxed);
+    residuals_[residual_graph_.reverse_arcs_[arc]].fetch_add(
+      flow, std::memory_order_relaxed);
+    excesses_[v].fetch_add(flow, std::memory_order_relaxed);
+    if (v == source_vertex_ || v == sink_vertex_) {
+      return;
+    }
+
+    // Claim v for the next round's list, unless another push already has.
+    // v might still be discharged in this round too, after this push, in
+    // which case it will have no excess in the next round.
+    const auto next_round = rounds_count_ + 1;
+    auto queued_round = queued_rounds_[v].load(std::memory_order_relaxed);
+    if (queued_round != next_round &&
+        queued_rounds_[v].compare_exchange_strong(
+          queued_round, next_round, std::memory_order_relaxed)) {
+      threads_[thread_index].next_active_.emplace_back(v);
+    }
+  }
+
+  /**
+   * Push the excess of @a u to its lowest neighbours, relabelling it
+   * whenever they are not lower, until it has no excess, or can't reach the
+   * sink.
+   */
+  void
+  discharge(type_num u, std::size_t thread_index) {
+    auto& thread = threads_[thread_index];
+    const auto begin = residual_graph_.offsets_[u];
+    const auto end = residual_graph_.offsets_[u + 1];
+
+    // Only this thread changes u's label and takes away its excess,
+    // so these are up to date, though other threads might add more excess.
+    auto label = labels_[u].load(std::memory_order_relaxed);
+    auto excess = excesses_[u].load(std::memory_order_relaxed);
+    while (excess > 0 && label < vertices_count_) {
+      // Find the lowest neighbour in the residual graph:
+      auto lowest = vertices_count_;
+      auto lowest_arc = begin;
+      Edge::type_length lowest_residual = 0;
+      for (auto arc = begin; arc < end; ++arc) {
+        const auto v = residual_graph_.destinations_[arc];
+        const auto residual = residuals_[arc].load(std::memory_order_relaxed);
+        if (residual == 0 || v == u) {
+          continue;
+        }
+
+        const std::size_t v_label = labels_[v].load(std::memory_order_relaxed);
+        if (v_label < lowest) {
+          lowest = v_label;
+          lowest_arc = arc;
+          lowest_residual = residual;
+        }
+      }
+
+      if (label > lowest) {
+        ++thread.pushes_count_;
+        const auto c = std::min(lowest_residual, excess);
+        excesses_[u].fetch_sub(c, std::memory_order_relaxed);
+        push(lowest_arc, residual_graph_.destinations_[lowest_arc], c,
+          thread_index);
+      } else {
+        ++thread.relabels_count_;
+        thread.work_ += end - begin + RELABEL_WORK;
+        label = std::min(lowest + 1, vertices_count_);
+        labels_[u].store(label, std::memory_order_relaxed);
+      }
+
+      excess = excesses_[u].load(std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * Set each label to the exact number of edges on the shortest path to the
+   * sink in the residual graph, with a parallel backwards BFS from the sink,
+   * or to n if there is no path, and find the active vertices again, as in
+   * parallel_bfs_compute().
+   * Each vertex is claimed by changing its label from n, with a
+   * compare-exchange.
+   */
+  void
+  global_relabel() {
+    ++global_relabels_count_;
+
+    thread_pool_.parallel_for(vertices_count_,
+      [this](std::size_t v, std::size_t /* thread_index */) {
+        labels_[v].store(vertices_count_, std::memory_order_relaxed);
+      },
+      ATOMICS_CHUNK_SIZE);
+
+    for (auto& thread : threads_) {
+      thread.work_ = 0;
+    }
+
+    labels_[sink_vertex_].store(0, std::memory_order_relaxed);
+    frontier_.clear();
+    frontier_.emplace_back(sink_vertex_);
+
+    type_num label = 0;
+    while (!frontier_.empty()) {
+      ++label;
+
+      thread_pool_.parallel_for(
+        frontier_.size(), [&](std::size_t i, std::size_t thread_index) {
+          auto& thread = threads_[thread_index];
+          const auto v = frontier_[i];
+          const auto end = residual_graph_.offsets_[v + 1];
+          for (auto arc = residual_graph_.offsets_[v]; arc < end; ++arc) {
+            // The reverse arc, from u to v, has capacity,
+            // so u can reach the sink via v:
+            const auto u = residual_graph_.destinations_[arc];
+            const auto reverse_arc = residual_graph_.reverse_arcs_[arc];
+            if (u == source_vertex_ ||
+                residuals_[reverse_arc].load(std::memory_order_relaxed) ==
+                  0) {
+              continue;
+            }
+
+            type_num expected = vertices_count_;
+            if (!labels_[u].compare_exchange_strong(
+                  expected, label, std::memory_order_relaxed)) {
+              continue;
+            }
+
+            thread.next_frontier_.emplace_back(u);
+            if (excesses_[u].load(std::memory_order_relaxed) > 0) {
+              thread.next_active_.emplace_back(u);
+            }
+          }
+        });
+
+      gather(&ThreadState::next_frontier_, frontier_);
+    }
+
+    gather(&ThreadState::next_active_, active_);
+  }
+
+  /**
+   * Replace @a result with the threads' lists, with each thread copying its
+   * own list, and clear the threads' lists.
+   */
+  void
+  gather(std::vector<type_num> ThreadState::*list,
+    std::vector<type_num>& result) {
+    const auto threads_count = threads_.size();
+    std::vector<std::size_t> offsets(threads_count + 1, 0);
+    for (std::size_t t = 0; t < threads_count; ++t) {
+      offsets[t + 1] = offsets[t] + (threads_[t].*list).size();
+    }
+
+    result.resize(offsets.back());
+    thread_pool_.run([&](std::size_t thread_index) {
+      auto& part = threads_[thread_index].*list;
+      std::copy(
+        part.begin(), part.end(), result.begin() + offsets[thread_index]);
+      part.clear();
+    });
+  }
+};
+
+constexpr std::size_t ParallelPushRelabel::GLOBAL_RELABEL_WORK_FACTOR;
+constexpr std::size_t ParallelPushRelabel::RELABEL_WORK;
+constexpr std::size_t ParallelPushRelabel::ATOMICS_CHUNK_SIZE;
+
+/**
+ * Get the same maximum flow value as push_relabel_max_flow(), with the
+ * push-relabel algorithm, using the @a thread_pool's threads to discharge
+ * many vertices at once.
+ *
+ * This has no gap heuristic, because the threads would need to agree about
+ * how many vertices have each label, and discharges the active vertices in
+ * any order, rather than the highest first, so it does more pushes and
+ * relabels than the sequential version, which only pays off with several
+ * cores, on large graphs, such as the grid graphs used to segment images.
+ *
+ * @tparam T_Graph For instance, type_vec_nodes or CsrGraph.
+ */
+template <typename T_Graph>
+Edge::type_length
+parallel_push_relabel_max_flow(const T_Graph& vertices,
+  type_num source_vertex_num, type_num sink_vertex_num,
+  ThreadPool& thread_pool) {
+  const auto vertices_count = vertices.size();
+  if (source_vertex_num >= vertices_count ||
+      sink_vertex_num >= vertices_count) {
+    std::cerr
+      << "parallel_push_relabel_max_flow(): vertex not found in vertices."
+      << std::endl;
+    return 0;
+  }
+
+  if (source_vertex_num == sink_vertex_num) {
+    std::cerr << "parallel_push_relabel_max_flow(): the source is the sink."
+              << std::endl;
+    return 0;
+  }
+
+  ResidualGraph residual_graph(vertices);
+  ParallelPushRelabel push_relabel(
+    residual_graph, source_vertex_num, sink_vertex_num, thread_pool);
+  return push_relabel.compute();
+}
+
+/**
+ * Like parallel_push_relabel_max_flow(), using all cores.
+ */
+template <typename T_Graph>
+Edge::type_length
+parallel_push_relabel_max_flow(const T_Graph& vertices,
+  type_num source_vertex_num, type_num sink_vertex_num) {
+  ThreadPool thread_pool;
+  return parallel_push_relabel_max_flow(
+    vertices, source_vertex_num, sink_vertex_num, thread_pool);
+}
+
+#endif // MURRAYC_ALGORITHMS_EXPERIMENTS_PARALLEL_PUSH_RELABEL
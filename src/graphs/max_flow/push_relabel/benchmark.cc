@@ -0,0 +1,110 @@
+#include "push_relabel.h"
+#include "max_flow/dinic/dinic.h"
+#include "max_flow/ford_fulkerson/ford_fulkerson.h"
+#include "utils/benchmark.h"
+#include "utils/random_graphs.h"
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * Compare push_relabel_max_flow(), with both selection strategies, with
+ * dinic_max_flow() and ford_fulkerson_max_flow().
+ * The slower algorithms are only run on graphs with up to
+ * @a max_vertices_count_for_slow_algorithms vertices.
+ * @result false if the results were not the same.
+ */
+static bool
+benchmark_graph(const std::string& name, const type_vec_nodes& vertices,
+  std::size_t max_vertices_count_for_slow_algorithms) {
+  const auto vertices_count = vertices.size();
+  std::size_t edges_count = 0;
+  for (const auto& vertex : vertices) {
+    edges_count += vertex.edges_.size();
+  }
+
+  std::cout << name << ", vertices: " << vertices_count
+            << ", edges: " << edges_count << std::endl;
+
+  const type_num source_vertex = 0;
+  const type_num sink_vertex = vertices_count - 1;
+
+  Edge::type_length expected = 0;
+  const auto seconds = benchmark_seconds([&] {
+    expected = push_relabel_max_flow(vertices, source_vertex, sink_vertex);
+  });
+  std::cout << "  push_relabel_max_flow(), highest label: " << seconds
+            << "s, max flow: " << expected << std::endl;
+
+  Edge::type_length result = 0;
+  const auto fifo_seconds = benchmark_seconds([&] {
+    result = push_relabel_max_flow(
+      vertices, source_vertex, sink_vertex, PushRelabelSelection::FIFO);
+  });
+  std::cout << "  push_relabel_max_flow(), FIFO: " << fifo_seconds << "s"
+            << std::endl;
+  if (result != expected) {
+    std::cerr << "The results were not the same." << std::endl;
+    return false;
+  }
+
+  if (vertices_count > max_vertices_count_for_slow_algorithms) {
+    std::cout << "  (Skipping the slower algorithms.)" << std::endl;
+    return true;
+  }
+
+  const auto dinic_seconds = benchmark_seconds([&] {
+    result = dinic_max_flow(vertices, source_vertex, sink_vertex);
+  });
+  std::cout << "  dinic_max_flow(): " << dinic_seconds << "s" << std::endl;
+  if (result != expected) {
+    std::cerr << "The results were not the same." << std::endl;
+    return false;
+  }
+
+  const auto ford_fulkerson_seconds = benchmark_seconds([&] {
+    result = ford_fulkerson_max_flow(vertices, source_vertex, sink_vertex);
+  });
+  std::cout << "  ford_fulkerson_max_flow(): " << ford_fulkerson_seconds
+            << "s" << std::endl;
+  if (result != expected) {
+    std::cerr << "The results were not the same." << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Usage: murrayc_push_relabel_benchmark [frame_width]
+ * [max_vertices_count_for_slow_algorithms]
+ *
+ * The graphs are like those from the DIMACS generators: GENRMF "long"
+ * networks, with many small frames, and "wide" networks, with a few large
+ * frames, and Washington random level graphs.
+ */
+int
+main(int argc, char** argv) {
+  const auto frame_width = benchmark_get_arg<type_num>(argc, argv, 1, 32);
+  const auto max_vertices_count_for_slow_algorithms =
+    benchmark_get_arg<std::size_t>(argc, argv, 2, 20000);
+
+  if (!benchmark_graph("GENRMF long",
+        make_rmf_graph(frame_width / 2, frame_width * 4, 1000),
+        max_vertices_count_for_slow_algorithms)) {
+    return EXIT_FAILURE;
+  }
+
+  if (!benchmark_graph("GENRMF wide",
+        make_rmf_graph(frame_width * 2, frame_width / 4, 1000),
+        max_vertices_count_for_slow_algorithms)) {
+    return EXIT_FAILURE;
+  }
+
+  if (!benchmark_graph("random level graph",
+        make_random_level_graph(frame_width * 4, frame_width * 8, 3, 1000),
+        max_vertices_count_for_slow_algorithms)) {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -1,5 +1,7 @@
 #include "push_relabel.h"
+#include "max_flow/ford_fulkerson/ford_fulkerson.h"
 #include "utils/example_graphs.h"
+#include "utils/random_graphs.h"
 #include <cassert>
 #include <cstdlib>
 #include <iostream>
@@ -13,15 +15,62 @@ test_small(type_num source_vertex_num, type_num sink_vertex_num,
   std::cout << "max flow from " << source_vertex_num << " to "
             << sink_vertex_num << ": " << max_flow << std::endl;
   assert(max_flow == expected_max_flow);
+
+  assert(push_relabel_max_flow(EXAMPLE_GRAPH_SMALL_FOR_FLOW,
+           source_vertex_num, sink_vertex_num,
+           PushRelabelSelection::FIFO) == expected_max_flow);
+}
+
+static void
+test_undo() {
+  // If the flow first goes along 0, 1, 2, 3, then some of it must be undone,
+  // via the reverse edge from 2 to 1, to get the maximum flow:
+  const type_vec_nodes graph = {Vertex({Edge(1, 1), Edge(2, 1)}),
+    Vertex({Edge(2, 1), Edge(3, 1)}), Vertex({Edge(3, 1)}), Vertex()};
+  assert(push_relabel_max_flow(graph, 0, 3) == 2);
+  assert(push_relabel_max_flow(graph, 0, 3, PushRelabelSelection::FIFO) == 2);
+
+  // No path:
+  assert(push_relabel_max_flow(graph, 3, 0) == 0);
+}
+
+static void
+check_graph(const type_vec_nodes& vertices, type_num source_vertex,
+  type_num sink_vertex) {
+  const auto expected =
+    ford_fulkerson_max_flow(vertices, source_vertex, sink_vertex);
+  assert(push_relabel_max_flow(vertices, source_vertex, sink_vertex) ==
+         expected);
+  assert(push_relabel_max_flow(vertices, source_vertex, sink_vertex,
+           PushRelabelSelection::FIFO) == expected);
+}
+
+static void
+test_random() {
+  for (unsigned int seed = 0; seed < 20; ++seed) {
+    const auto graph = make_random_graph(200, 1000, 50, seed);
+    check_graph(graph, 0, 199);
+    check_graph(graph, seed, 100 + seed);
+  }
+
+  const auto rmf_graph = make_rmf_graph(5, 6, 100);
+  check_graph(rmf_graph, 0, rmf_graph.size() - 1);
+
+  const auto level_graph = make_random_level_graph(10, 20, 3, 100);
+  check_graph(level_graph, 0, level_graph.size() - 1);
+
+  const auto grid_graph = make_random_grid_graph(20, 20, 10);
+  check_graph(grid_graph, 0, grid_graph.size() - 1);
 }
 
 int
 main() {
-  // TODO: Test a graph that actually needs us to use the residual (reverse)
-  // edges to undo.
   test_small(0, 3, 5);
   test_small(0, 2, 5);
   test_small(2, 3, 3);
 
+  test_undo();
+  test_random();
+
   return EXIT_SUCCESS;
 }
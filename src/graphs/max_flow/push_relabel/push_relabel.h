@@ -1,179 +1,446 @@
-#include "shortest_path/breadth_first_search/breadth_first_search.h"
+#ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_PUSH_RELABEL
+#define MURRAYC_ALGORITHMS_EXPERIMENTS_PUSH_RELABEL
+
+#include "utils/residual_graph.h"
 #include "utils/vertex.h"
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <vector>
 
 // A set of vertices and their edges.
 using type_vec_nodes = std::vector<Vertex>;
 
 using type_num = Edge::type_num;
 
-static type_vec_nodes
-make_residual_graph(const type_vec_nodes& vertices) {
-  type_vec_nodes result = vertices;
-
-  const auto vertices_count = result.size();
-  for (type_num i = 0; i < vertices_count; ++i) {
-    auto& vertex = result[i];
-
-    const auto edges_count = vertex.edges_.size();
-    for (type_num e = 0; e < edges_count; ++e) {
-      const auto& edge = vertex.edges_[e];
+/**
+ * How push_relabel_max_flow() chooses the next vertex with excess flow.
+ */
+enum class PushRelabelSelection {
+  // The vertex with the highest label, which moves the excess towards the
+  // sink in big steps, and usually does the fewest pushes.
+  HIGHEST_LABEL,
+
+  // The vertices in the order in which they got excess.
+  FIFO
+};
+
+/**
+ * The state of one push_relabel_max_flow() calculation.
+ *
+ * The vertices with each label (height) below n are in a doubly-linked list
+ * for that label, so the gap heuristic can find all the vertices above an
+ * empty label. The active vertices, which have excess flow, are also in a
+ * singly-linked list (a stack) for each label, for the highest-label
+ * selection, or in one FIFO queue.
+ * A label of n means that the vertex can't reach the sink any more, so its
+ * excess can only go back to the source. We don't need to do that to know
+ * the maximum flow's value, so those vertices are just left alone.
+ */
+class PushRelabel {
+public:
+  PushRelabel(ResidualGraph& residual_graph, type_num source_vertex,
+    type_num sink_vertex, PushRelabelSelection selection)
+  : residual_graph_(residual_graph),
+    source_vertex_(source_vertex),
+    sink_vertex_(sink_vertex),
+    selection_(selection),
+    vertices_count_(residual_graph.size()),
+    arcs_count_(residual_graph.arcs_count()),
+    labels_(vertices_count_),
+    excesses_(vertices_count_),
+    current_arcs_(residual_graph.offsets_.begin(),
+      residual_graph.offsets_.end() - 1),
+    next_(vertices_count_),
+    previous_(vertices_count_),
+    first_(vertices_count_, NONE),
+    next_active_(vertices_count_),
+    first_active_(vertices_count_, NONE),
+    highest_label_(0),
+    highest_active_label_(0),
+    fifo_begin_(0),
+    work_since_global_relabel_(0),
+    pushes_count_(0),
+    relabels_count_(0),
+    gaps_count_(0),
+    global_relabels_count_(0) {}
+
+  /**
+   * Find the value of the maximum flow, adding to any flow already in the
+   * residual graph.
+   * @result The flow added.
+   */
+  Edge::type_length
+  compute() {
+    // Saturate the source's arcs:
+    labels_[source_vertex_] = vertices_count_;
+    const auto end = residual_graph_.offsets_[source_vertex_ + 1];
+    for (auto arc = residual_graph_.offsets_[source_vertex_]; arc < end;
+         ++arc) {
+      const auto capacity = residual_graph_.residuals_[arc];
+      if (capacity > 0) {
+        residual_graph_.push(arc, capacity);
+        excesses_[residual_graph_.destinations_[arc]] += capacity;
+        excesses_[source_vertex_] -= capacity;
+      }
+    }
 
-      const auto dest_vertex_num = edge.destination_vertex_;
-      auto& dest_vertex = result[dest_vertex_num];
-      auto& edges = dest_vertex.edges_;
+    global_relabel();
 
-      // Add reverse edge:
-      edges.emplace_back(i, 0);
-      auto& reverse = edges.back();
+    while (true) {
+      if (work_since_global_relabel_ > GLOBAL_RELABEL_WORK_FACTOR *
+                                          vertices_count_ +
+                                        arcs_count_) {
+        global_relabel();
+      }
 
-      // Tell each edge about its reverse edge:
-      reverse.reverse_edge_in_dest_ = e;
+      const auto u = take_active();
+      if (u == NONE) {
+        break;
+      }
 
-      auto& source_edge = vertex.edges_[e];
-      source_edge.reverse_edge_in_dest_ = edges.size() - 1;
+      discharge(u);
     }
+
+    return excesses_[sink_vertex_];
   }
 
-  return result;
-}
+  ResidualGraph& residual_graph_;
+  const type_num source_vertex_;
+  const type_num sink_vertex_;
+  const PushRelabelSelection selection_;
+  const std::size_t vertices_count_;
+  const std::size_t arcs_count_;
+
+  std::vector<type_num> labels_;
+  std::vector<Edge::type_length> excesses_;
+
+  // The arc of each vertex at which to continue looking for an admissible
+  // arc. The vertex's arcs before it can't be admissible until the vertex is
+  // relabelled.
+  std::vector<std::size_t> current_arcs_;
+
+  // The lists of vertices with each label.
+  std::vector<type_num> next_;
+  std::vector<type_num> previous_;
+  std::vector<type_num> first_;
+
+  // The stacks of active vertices with each label.
+  std::vector<type_num> next_active_;
+  std::vector<type_num> first_active_;
+
+  // The highest label with any vertices, and with any active vertices.
+  type_num highest_label_;
+  type_num highest_active_label_;
+
+  // The active vertices for PushRelabelSelection::FIFO,
+  // starting at fifo_begin_.
+  std::vector<type_num> fifo_;
+  std::size_t fifo_begin_;
+
+  // The vertices found by the BFS in global_relabel().
+  std::vector<type_num> global_relabel_queue_;
+
+  // The number of arcs examined by relabels since the last global relabel,
+  // plus a constant per relabel.
+  std::size_t work_since_global_relabel_;
+
+  // Statistics, for benchmarks.
+  std::size_t pushes_count_;
+  std::size_t relabels_count_;
+  std::size_t gaps_count_;
+  std::size_t global_relabels_count_;
+
+private:
+  static constexpr type_num NONE = std::numeric_limits<type_num>::max();
+
+  // Do a global relabel after relabels have examined about this many arcs
+  // per vertex, plus the number of arcs, so the global relabels take about
+  // as long as the relabels.
+  static constexpr std::size_t GLOBAL_RELABEL_WORK_FACTOR = 6;
+
+  // The work counted for each relabel, in addition to its arcs.
+  static constexpr std::size_t RELABEL_WORK = 12;
+
+  void
+  add_to_label_list(type_num v) {
+    const auto label = labels_[v];
+    const auto first = first_[label];
+    next_[v] = first;
+    previous_[v] = NONE;
+    if (first != NONE) {
+      previous_[first] = v;
+    }
 
-static Edge&
-get_reverse_edge(const Edge& edge, type_vec_nodes& vertices) {
-  auto& dest = vertices[edge.destination_vertex_];
-  return dest.edges_[edge.reverse_edge_in_dest_];
-}
+    first_[label] = v;
+    highest_label_ = std::max(highest_label_, label);
+  }
 
-bool
-has_outgoing_downhill_capacity(const type_vec_nodes& vertices,
-  const type_num vertex_num, const std::vector<Edge::type_length>& heights) {
-  const auto vertex_height = heights[vertex_num];
-  const auto& vertex = vertices[vertex_num];
+  void
+  remove_from_label_list(type_num v) {
+    const auto next = next_[v];
+    const auto previous = previous_[v];
+    if (previous == NONE) {
+      first_[labels_[v]] = next;
+    } else {
+      next_[previous] = next;
+    }
 
-  for (const auto& edge : vertex.edges_) {
-    if (edge.length_ > 0 && vertex_height > heights[edge.destination_vertex_])
-      return true;
+    if (next != NONE) {
+      previous_[next] = previous;
+    }
   }
 
-  return false;
-}
-
-static Edge::type_length
-push_relabel_max_flow(const type_vec_nodes& vertices,
-  type_num source_vertex_num, type_num sink_vertex_num) {
-  // TODO: Separate map of edges to their flows?
-  auto residual_graph = make_residual_graph(vertices);
+  void
+  add_active(type_num v) {
+    if (selection_ == PushRelabelSelection::FIFO) {
+      // Forget the vertices that have already been taken,
+      // when they are most of the queue:
+      if (fifo_begin_ > vertices_count_ && fifo_begin_ * 2 > fifo_.size()) {
+        fifo_.erase(fifo_.begin(), fifo_.begin() + fifo_begin_);
+        fifo_begin_ = 0;
+      }
 
-  const auto vertices_count = vertices.size();
-  std::vector<Edge::type_length> heights(vertices_count);
-  heights[source_vertex_num] = vertices_count;
-  std::vector<Edge::type_length> excesses(vertices_count);
-
-  // This should return true if a is less than b.
-  const auto comparator = [&residual_graph, &heights, &excesses,
-    sink_vertex_num](const auto& a, const auto& b) {
-    // If they are the same index, then a is not less than b.
-    if (a == b) {
-      return false;
+      fifo_.emplace_back(v);
+      return;
     }
 
-    const auto excess_a = excesses[a];
-    const auto excess_b = excesses[b];
+    const auto label = labels_[v];
+    next_active_[v] = first_active_[label];
+    first_active_[label] = v;
+    highest_active_label_ = std::max(highest_active_label_, label);
+  }
+
+  /**
+   * Remove and return the next active vertex, or NONE.
+   */
+  type_num
+  take_active() {
+    if (selection_ == PushRelabelSelection::FIFO) {
+      while (fifo_begin_ < fifo_.size()) {
+        const auto v = fifo_[fifo_begin_++];
+
+        // A vertex lifted by a gap can still be in the queue.
+        if (labels_[v] < vertices_count_) {
+          return v;
+        }
+      }
 
-    // If only one has excess,the one with excess comes first.
-    if (excess_a > 0 && excess_b <= 0) {
-      return true;
-    } else if (excess_b > 0 && excess_a <= 0) {
-      return false;
+      fifo_.clear();
+      fifo_begin_ = 0;
+      return NONE;
     }
 
-    // Both a and b have have excess:
+    while (true) {
+      const auto v = first_active_[highest_active_label_];
+      if (v != NONE) {
+        first_active_[highest_active_label_] = next_active_[v];
+        return v;
+      }
 
-    // if (excess_a != excess_b) {
-    //  return excess_a > excess_b;
-    //}
+      if (highest_active_label_ == 0) {
+        return NONE;
+      }
 
-    // Make sure that the sink vertex is always the last one,
-    if (a == sink_vertex_num) {
-      return false;
-    } else if (b == sink_vertex_num) {
-      return false;
+      --highest_active_label_;
     }
+  }
 
-    const auto height_a = heights[a];
-    const auto height_b = heights[b];
-    if (height_a == height_b) {
-      return excess_a > excess_b; // TODO: Alternative ways of choosing?
+  /**
+   * Set each label to the exact number of edges on the shortest path to the
+   * sink in the residual graph, with a backwards BFS from the sink, or to n
+   * if there is no path, and rebuild the lists.
+   */
+  void
+  global_relabel() {
+    ++global_relabels_count_;
+    work_since_global_relabel_ = 0;
+
+    std::fill(labels_.begin(), labels_.end(), vertices_count_);
+    std::fill(first_.begin(), first_.end(), NONE);
+    std::fill(first_active_.begin(), first_active_.end(), NONE);
+    std::copy(residual_graph_.offsets_.begin(),
+      residual_graph_.offsets_.end() - 1, current_arcs_.begin());
+    fifo_.clear();
+    fifo_begin_ = 0;
+    highest_label_ = 0;
+    highest_active_label_ = 0;
+
+    auto& queue = global_relabel_queue_;
+    queue.clear();
+    labels_[sink_vertex_] = 0;
+    queue.emplace_back(sink_vertex_);
+    for (std::size_t i = 0; i < queue.size(); ++i) {
+      const auto v = queue[i];
+      const auto label = labels_[v] + 1;
+      const auto end = residual_graph_.offsets_[v + 1];
+      for (auto arc = residual_graph_.offsets_[v]; arc < end; ++arc) {
+        // The reverse arc, from u to v, has capacity,
+        // so u can reach the sink via v:
+        const auto u = residual_graph_.destinations_[arc];
+        const auto reverse_arc = residual_graph_.reverse_arcs_[arc];
+        if (labels_[u] == vertices_count_ && u != source_vertex_ &&
+            residual_graph_.residuals_[reverse_arc] > 0) {
+          labels_[u] = label;
+          queue.emplace_back(u);
+        }
+      }
     }
 
-    return height_a > height_b;
-  };
-
-  // We don't use a std::priority_queue() because we want to manually
-  // reorder the items after external changes.
-  // std::priority_queue<type_num, std::vector<type_num>,
-  //  decltype(comparator)> heap(comparator);
-  std::vector<type_num> heap(vertices_count);
-  for (type_num i = 0; i < vertices_count; ++i) {
-    heap[i] = i;
+    for (const auto v : queue) {
+      add_to_label_list(v);
+      if (excesses_[v] > 0 && v != sink_vertex_) {
+        add_active(v);
+      }
+    }
   }
-  std::make_heap(heap.begin(), heap.end(), comparator);
-
-  const auto predicate_edge_has_capacity = [](
-    const Edge& edge) { return edge.length_ > 0; };
-
-  type_num best = source_vertex_num;
-  while (excesses[best] > 0) {
-    // If there is a higher vertex with outgoing capacity,
-    // send flow along that edge.
-    if (has_outgoing_downhill_capacity(residual_graph, best, heights)) {
-      auto& excess = excesses[best];
-
-      auto& vertex = residual_graph[best];
-      auto& edges = vertex.edges_;
-      auto iter_edge =
-        std::find_if(edges.begin(), edges.end(), predicate_edge_has_capacity);
-      while (excess > 0 && iter_edge != edges.end()) {
-        // Reduce the edge's capacity:
-        // std::cout << "before:"
-        //  << ", capacity=" << edge.length_
-        //  << ", residual=" << edge.residual_ << std::endl;
-        auto& edge = *iter_edge;
-        const auto c = std::min(edge.length_, excess);
-        edge.length_ -= c;
-        // std::cout << "after: edge.length_=" << edge.length_ << std::endl;
-
-        // Increase the reverse edge's capacity, to allow an undo:
-        auto& reverse_edge = get_reverse_edge(edge, residual_graph);
-        reverse_edge.length_ += c;
-
-        // Move the excess from the vertex to its destination:
+
+  /**
+   * Push the excess of @a u along its admissible arcs, relabelling it
+   * whenever it has none, until it has no excess, or can't reach the sink.
+   */
+  void
+  discharge(type_num u) {
+    auto& residuals = residual_graph_.residuals_;
+    const auto end = residual_graph_.offsets_[u + 1];
+    auto& excess = excesses_[u];
+    while (excess > 0) {
+      const auto label = labels_[u];
+      auto& arc = current_arcs_[u];
+      for (; arc < end; ++arc) {
+        const auto v = residual_graph_.destinations_[arc];
+        if (residuals[arc] == 0 || labels_[v] + 1 != label) {
+          continue;
+        }
+
+        // Push:
+        ++pushes_count_;
+        const auto c = std::min(residuals[arc], excess);
+        residual_graph_.push(arc, c);
+        if (excesses_[v] == 0 && v != sink_vertex_) {
+          add_active(v);
+        }
+
+        excesses_[v] += c;
         excess -= c;
+        if (excess == 0) {
+          // Keep the current arc, which might still have capacity.
+          return;
+        }
+      }
 
-        auto& excess_dest = excesses[edge.destination_vertex_];
-        excess_dest += c;
+      relabel(u);
+      if (labels_[u] >= vertices_count_) {
+        return;
+      }
+    }
+  }
 
-        iter_edge =
-          std::find_if(iter_edge, edges.end(), predicate_edge_has_capacity);
+  /**
+   * Set the label of @a u to one more than its lowest neighbour in the
+   * residual graph, so it has an admissible arc again.
+   * If @a u was the only vertex with its old label, no vertex above that
+   * label can reach the sink, because every arc in the residual graph goes
+   * down by at most one label, so they are all lifted to n (the gap
+   * heuristic).
+   */
+  void
+  relabel(type_num u) {
+    ++relabels_count_;
+
+    const auto begin = residual_graph_.offsets_[u];
+    const auto end = residual_graph_.offsets_[u + 1];
+    work_since_global_relabel_ += end - begin + RELABEL_WORK;
+
+    auto lowest = vertices_count_;
+    auto lowest_arc = begin;
+    for (auto arc = begin; arc < end; ++arc) {
+      const auto v = residual_graph_.destinations_[arc];
+      if (residual_graph_.residuals_[arc] > 0 && labels_[v] < lowest) {
+        lowest = labels_[v];
+        lowest_arc = arc;
       }
-    } else if (best == sink_vertex_num) {
-      std::cerr << "Unexpectedly trying to relabel destination vertex.\n";
-    } else {
-      // Relabel the highest vertex and try again.
-      heights[best]++;
     }
 
-    // Get the new best vertex,
-    // (Of the vertices with excess, the highest one.)
-    std::make_heap(heap.begin(), heap.end(), comparator);
-    best = heap.front();
+    const auto old_label = labels_[u];
+    remove_from_label_list(u);
+
+    if (first_[old_label] == NONE) {
+      ++gaps_count_;
+      for (auto label = old_label + 1; label <= highest_label_; ++label) {
+        for (auto v = first_[label]; v != NONE; v = next_[v]) {
+          labels_[v] = vertices_count_;
+        }
+
+        first_[label] = NONE;
+        first_active_[label] = NONE;
+      }
+
+      labels_[u] = vertices_count_;
+      highest_label_ = old_label == 0 ? 0 : old_label - 1;
+      highest_active_label_ = std::min(highest_active_label_, highest_label_);
+      return;
+    }
+
+    labels_[u] = std::min<type_num>(lowest + 1, vertices_count_);
+    current_arcs_[u] = lowest_arc;
+    if (labels_[u] < vertices_count_) {
+      add_to_label_list(u);
+    }
+  }
+};
+
+constexpr type_num PushRelabel::NONE;
+constexpr std::size_t PushRelabel::GLOBAL_RELABEL_WORK_FACTOR;
+constexpr std::size_t PushRelabel::RELABEL_WORK;
+
+/**
+ * Get the value of the maximum flow from @a source_vertex_num to
+ * @a sink_vertex_num, with the push-relabel (preflow-push) algorithm,
+ * treating each edge's length as its capacity.
+ *
+ * Each vertex has a label, which never overestimates its distance to the
+ * sink, in edges, in the residual graph. Flow is pushed only along
+ * "admissible" edges, which go down by exactly one label, and a vertex is
+ * relabelled when it has excess flow but no admissible edges. This uses the
+ * heuristics that make push-relabel fast in practice:
+ * - The vertex with the highest label is discharged next, found via buckets
+ *   of vertices per label, or optionally the vertices are discharged in FIFO
+ *   order.
+ * - Each vertex remembers its current edge, so it doesn't look at the same
+ *   inadmissible edges again before its next relabel.
+ * - The gap heuristic: when no vertex has a label, the vertices above it are
+ *   lifted out of the way at once.
+ * - Global relabelling: the labels are periodically set to the exact
+ *   distances, with a backwards BFS from the sink.
+ *
+ * This only does the first phase of push-relabel, which finds the value of
+ * the maximum flow, as the excess at the sink. It doesn't return the excess
+ * that can't reach the sink to the source, which would be needed to get a
+ * valid flow for each edge.
+ */
+static Edge::type_length
+push_relabel_max_flow(const type_vec_nodes& vertices,
+  type_num source_vertex_num, type_num sink_vertex_num,
+  PushRelabelSelection selection = PushRelabelSelection::HIGHEST_LABEL) {
+  const auto vertices_count = vertices.size();
+  if (source_vertex_num >= vertices_count ||
+      sink_vertex_num >= vertices_count) {
+    std::cerr << "push_relabel_max_flow(): vertex not found in vertices."
+              << std::endl;
+    return 0;
   }
 
-  Edge::type_length result = 0;
-  const auto& source_vertex = residual_graph[source_vertex_num];
-  for (const auto& edge : source_vertex.edges_) {
-    result += edge.length_;
+  if (source_vertex_num == sink_vertex_num) {
+    std::cerr << "push_relabel_max_flow(): the source is the sink."
+              << std::endl;
+    return 0;
   }
 
-  return result;
+  ResidualGraph residual_graph(vertices);
+  PushRelabel push_relabel(
+    residual_graph, source_vertex_num, sink_vertex_num, selection);
+  return push_relabel.compute();
 }
+
+#endif // MURRAYC_ALGORITHMS_EXPERIMENTS_PUSH_RELABEL
@@ -15,18 +15,24 @@ using type_vec_edges = std::vector<Edge>;
 using type_num = Edge::type_num;
 using type_length = Edge::type_length;
 
-class EdgeWithSource : public Edge {
+template <typename T_Edge>
+class BasicEdgeWithSource : public T_Edge {
 public:
-  EdgeWithSource(const Edge& edge, type_num source_vertex)
-  : Edge(edge), source_vertex_(source_vertex) {}
+  using type_num = typename T_Edge::type_num;
+  using type_length = typename T_Edge::type_length;
 
-  EdgeWithSource(
+  BasicEdgeWithSource(const T_Edge& edge, type_num source_vertex)
+  : T_Edge(edge), source_vertex_(source_vertex) {}
+
+  BasicEdgeWithSource(
     type_num source_vertex, type_num destination_vertex, type_length length)
-  : Edge(destination_vertex, length), source_vertex_(source_vertex) {}
+  : T_Edge(destination_vertex, length), source_vertex_(source_vertex) {}
 
   type_num source_vertex_;
 };
 
+using EdgeWithSource = BasicEdgeWithSource<Edge>;
+
 static_assert(std::is_copy_assignable<EdgeWithSource>::value,
   "EdgeWithSource should be copy assignable.");
 static_assert(std::is_copy_constructible<EdgeWithSource>::value,
@@ -36,9 +42,17 @@ static_assert(std::is_move_assignable<EdgeWithSource>::value,
 static_assert(std::is_move_constructible<EdgeWithSource>::value,
   "EdgeWithSource should be move constructible.");
 
-using type_vec_edges_with_sources = std::vector<EdgeWithSource>;
+template <typename T_Edge>
+using type_vec_basic_edges_with_sources =
+  std::vector<BasicEdgeWithSource<T_Edge>>;
+
+template <typename T_Edge>
+using type_basic_set_msts =
+  std::vector<type_vec_basic_edges_with_sources<T_Edge>>;
+
+using type_vec_edges_with_sources = type_vec_basic_edges_with_sources<Edge>;
 
-using type_set_msts = std::vector<type_vec_edges_with_sources>;
+using type_set_msts = type_basic_set_msts<Edge>;
 
 /** Erase an item from a map, returning its value.
  */
@@ -59,17 +73,24 @@ get_and_erase_from_map(T_Map& map, const typename T_Map::key_type& key) {
 /**
  * @param max_clusters Call this with 1 to get a single Minimum Spanning Tree.
  */
-static type_set_msts
-find_clusters(const type_vec_edges_with_sources& sorted_edges,
-  type_num count_nodes, type_num max_clusters) {
-  type_set_msts result; // Declare this here to try to get some RVO.
+template <typename T_Edge>
+static type_basic_set_msts<T_Edge>
+find_clusters(const type_vec_basic_edges_with_sources<T_Edge>& sorted_edges,
+  typename T_Edge::type_num count_nodes,
+  typename T_Edge::type_num max_clusters) {
+  using type_edge_num = typename T_Edge::type_num;
+  using type_edge_length = typename T_Edge::type_length;
+
+  // Declare this here to try to get some RVO.
+  type_basic_set_msts<T_Edge> result;
 
   // Map of roots to spanning tree costs:
-  std::unordered_map<type_num, type_vec_edges_with_sources> map_msts;
+  std::unordered_map<type_edge_num, type_vec_basic_edges_with_sources<T_Edge>>
+    map_msts;
 
-  UnionFind<type_num> ds(count_nodes);
-  type_num clusters_count = count_nodes;
-  type_length min_spacing = std::numeric_limits<type_length>::max();
+  UnionFind<type_edge_num> ds(count_nodes);
+  type_edge_num clusters_count = count_nodes;
+  auto min_spacing = std::numeric_limits<type_edge_length>::max();
 
   for (const auto& edge : sorted_edges) {
     const auto& from = edge.source_vertex_;
@@ -121,11 +142,11 @@ find_clusters(const type_vec_edges_with_sources& sorted_edges,
         // This is not a real edge, but it's how we tell the caller
         // that there is only one node in the cluster.
         if (from == from_leader && !map_msts.count(from)) {
-          map_msts[from] = {EdgeWithSource(from, from, 0)};
+          map_msts[from] = {BasicEdgeWithSource<T_Edge>(from, from, 0)};
         }
 
         if (to == to_leader && !map_msts.count(to)) {
-          map_msts[to] = {EdgeWithSource(to, to, 0)};
+          map_msts[to] = {BasicEdgeWithSource<T_Edge>(to, to, 0)};
         }
 
         // std::cout << "  remembering max distance" << std::endl;
@@ -150,21 +171,28 @@ find_clusters(const type_vec_edges_with_sources& sorted_edges,
   return result;
 }
 
-static type_set_msts
-compute_mst_cost(const type_vec_nodes& vertices) {
-  type_vec_edges_with_sources edges;
-  const auto vertices_count = vertices.size();
-  for (type_num v = 0; v < vertices_count; ++v) {
+/**
+ * @tparam T_Edge For instance, Edge, or a BasicEdge with narrower types,
+ * so there are fewer bytes to move while sorting the edges.
+ */
+template <typename T_Edge>
+static type_basic_set_msts<T_Edge>
+compute_mst_cost(const std::vector<BasicVertex<T_Edge>>& vertices) {
+  using type_edge_num = typename T_Edge::type_num;
+
+  type_vec_basic_edges_with_sources<T_Edge> edges;
+  const type_edge_num vertices_count = vertices.size();
+  for (type_edge_num v = 0; v < vertices_count; ++v) {
     const auto& vertex_edges = vertices[v].edges_;
 
     std::transform(vertex_edges.begin(), vertex_edges.end(),
       std::back_inserter(edges),
-      [v](const auto& edge) { return EdgeWithSource(edge, v); });
+      [v](const auto& edge) { return BasicEdgeWithSource<T_Edge>(edge, v); });
   }
 
   // Sort the edges by their distance (ascending):
   std::sort(edges.begin(), edges.end(),
     [](const auto& a, const auto& b) -> bool { return a.length_ < b.length_; });
 
-  return find_clusters(edges, vertices.size(), 1);
+  return find_clusters<T_Edge>(edges, vertices_count, 1);
 }
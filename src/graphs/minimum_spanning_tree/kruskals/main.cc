@@ -5,8 +5,10 @@
 #include <iostream>
 #include <numeric>
 
+template <typename T_Edge>
 static void
-test_mst(const std::vector<Vertex>& graph, type_length expected_cost) {
+test_mst(
+  const std::vector<BasicVertex<T_Edge>>& graph, type_length expected_cost) {
   const auto msts = compute_mst_cost(graph);
   if (msts.size() == 1) {
     std::cout << "There is a minimum spanning tree:" << std::endl;
@@ -43,5 +45,9 @@ main() {
   test_mst(EXAMPLE_GRAPH_LARGER_WITH_NEGATIVE_EDGES,
     7); // TODO: Not the same as with prims.
 
+  test_mst(
+    convert_vertices<CompactEdge>(EXAMPLE_GRAPH_SMALL_WITH_NEGATIVE_EDGES),
+    -10013);
+
   return EXIT_SUCCESS;
 }
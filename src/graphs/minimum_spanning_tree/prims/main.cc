@@ -18,5 +18,18 @@ main() {
   std::cout << "MST cost: " << cost << std::endl;
   assert(cost == 59);
 
+  cost = compute_mst_cost(
+    convert_vertices<CompactEdge>(EXAMPLE_GRAPH_LARGER_WITH_NEGATIVE_EDGES));
+  std::cout << "MST cost (with CompactEdge): " << cost << std::endl;
+  assert(cost == 59);
+
+  assert(compute_mst_cost_with_indexed_heap(EXAMPLE_GRAPH_SMALL) == 6);
+  assert(compute_mst_cost_with_indexed_heap(
+           EXAMPLE_GRAPH_SMALL_WITH_NEGATIVE_EDGES) == -10013);
+  assert(compute_mst_cost_with_indexed_heap(
+           EXAMPLE_GRAPH_LARGER_WITH_NEGATIVE_EDGES) == 59);
+  assert(compute_mst_cost_with_indexed_heap<8>(
+           EXAMPLE_GRAPH_LARGER_WITH_NEGATIVE_EDGES) == 59);
+
   return EXIT_SUCCESS;
 }
@@ -1,3 +1,4 @@
+#include "utils/indexed_d_ary_heap.h"
 #include "utils/vertex.h"
 #include <iostream>
 #include <limits>
@@ -14,11 +15,15 @@ using type_length = Edge::type_length;
 
 const auto comparator = [](
   const auto& a, const auto& b) { return a.length_ > b.length_; };
+
+template <typename T_Edge>
 using type_pq =
-  std::priority_queue<Edge, std::vector<Edge>, decltype(comparator)>;
+  std::priority_queue<T_Edge, std::vector<T_Edge>, decltype(comparator)>;
 
+template <typename T_Edge>
 static void
-add_edges_to_pq(type_pq& pq_edges, const type_vec_nodes& nodes,
+add_edges_to_pq(type_pq<T_Edge>& pq_edges,
+  const std::vector<BasicVertex<T_Edge>>& nodes,
   const type_set_nodes& mst_nodes, type_num node_num) {
   const auto& node = nodes[node_num];
 
@@ -32,18 +37,23 @@ add_edges_to_pq(type_pq& pq_edges, const type_vec_nodes& nodes,
   }
 }
 
+/**
+ * @tparam T_Edge For instance, Edge, or a BasicEdge with narrower types,
+ * so there are fewer bytes to move through the priority queue.
+ */
+template <typename T_Edge>
 static type_length
-compute_mst_cost(const type_vec_nodes& nodes) {
+compute_mst_cost(const std::vector<BasicVertex<T_Edge>>& nodes) {
   // We track the nodes in the MST just to know when an edge's destination is
   // out of the tree.
   type_set_nodes mst_nodes;
 
   // We track the edges in the MST so we can sum their lengths,
   // though we could do this using a simple numeric sum along the way.
-  std::vector<Edge> mst_edges;
+  std::vector<T_Edge> mst_edges;
 
   // We use a priority queue to always find the lowest-cost edge out of the MST.
-  type_pq pq_edges(comparator);
+  type_pq<T_Edge> pq_edges(comparator);
 
   const auto start_node_num = 0;
   // std::cout << "start_node: " << start_node_num << std::endl;
@@ -61,7 +71,7 @@ compute_mst_cost(const type_vec_nodes& nodes) {
     // Ignore edges that don't lead out.
     // We need to do this because we add shorter edges without removing (or
     // decreasing) old ones.
-    // A Fiboncci heap would let us decrease-key in amortized O(1) time instead.
+    // compute_mst_cost_with_indexed_heap() uses decrease-key instead.
     if (mst_nodes.count(node_num)) {
       continue;
     }
@@ -80,3 +90,53 @@ compute_mst_cost(const type_vec_nodes& nodes) {
 
   return cost;
 }
+
+/**
+ * Like compute_mst_cost(), but using an IndexedDAryHeap of the vertices that
+ * are not yet in the tree, with the length of the shortest edge leading to
+ * each of them from the tree, decreasing that length when we find a shorter
+ * edge. So the heap never holds more than one entry per vertex,
+ * instead of one entry per edge.
+ *
+ * @tparam T_Arity The number of children of each node in the heap.
+ */
+template <unsigned int T_Arity = 4, typename T_Edge>
+static type_length
+compute_mst_cost_with_indexed_heap(
+  const std::vector<BasicVertex<T_Edge>>& nodes) {
+  const auto nodes_count = nodes.size();
+  if (nodes_count == 0) {
+    return 0;
+  }
+
+  // Whether each node is in the MST:
+  std::vector<bool> mst_nodes(nodes_count);
+
+  IndexedDAryHeap<typename T_Edge::type_length, T_Arity> heap(nodes_count);
+
+  const type_num start_node_num = 0;
+  heap.push(start_node_num, 0);
+
+  type_length cost = 0;
+  while (!heap.empty()) {
+    // Find the node, outside of the current tree,
+    // with the smallest cost edge leading to it from the tree:
+    const auto node_num = heap.top();
+    cost += heap.top_key();
+    heap.pop();
+
+    mst_nodes[node_num] = true;
+
+    for (const auto& edge : nodes[node_num].edges_) {
+      // Ignore edges that don't lead out of the current tree:
+      const type_num dest = edge.destination_vertex_;
+      if (mst_nodes[dest]) {
+        continue;
+      }
+
+      heap.push_or_decrease_key(dest, edge.length_);
+    }
+  }
+
+  return cost;
+}
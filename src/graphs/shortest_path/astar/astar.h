@@ -0,0 +1,303 @@
+#ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_ASTAR
+#define MURRAYC_ALGORITHMS_EXPERIMENTS_ASTAR
+
+#include "shortest_path/dijkstra/dijkstra.h"
+#include "utils/csr_graph.h"
+#include "utils/shortest_path.h"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+/**
+ * A heuristic that always estimates 0,
+ * which makes astar_compute_shortest_path() behave like Dijkstra's algorithm.
+ */
+class AStarZeroHeuristic {
+public:
+  type_length
+  operator()(type_num /* v */) const {
+    return 0;
+  }
+};
+
+/**
+ * The distances between some landmark vertices and all vertices,
+ * for AltHeuristic (A*, Landmarks, and the Triangle inequality).
+ *
+ * These are calculated once, with 2 runs of Dijkstra's algorithm per
+ * landmark, one on the graph and one on the reverse graph, and can then be
+ * used for any number of queries on the same graph.
+ * The distances are stored in flat arrays, with the distances for all
+ * landmarks to or from the same vertex next to each other, because
+ * AltHeuristic reads all of them for one vertex at a time.
+ */
+class AltLandmarks {
+public:
+  /**
+   * @param landmarks The landmark vertices, such as those chosen by
+   * alt_choose_landmarks().
+   */
+  template <typename T_Num, typename T_Length>
+  AltLandmarks(const BasicCsrGraph<T_Num, T_Length>& graph,
+    const std::vector<type_num>& landmarks)
+  : landmarks_(landmarks), vertices_count_(graph.size()) {
+    const auto landmarks_count = landmarks_.size();
+    from_landmarks_.resize(vertices_count_ * landmarks_count);
+    to_landmarks_.resize(vertices_count_ * landmarks_count);
+
+    const auto reverse_graph = make_reverse_csr_graph(graph);
+
+    DijkstraWorkspace workspace;
+    for (std::size_t l = 0; l < landmarks_count; ++l) {
+      const auto landmark = landmarks_[l];
+
+      dijkstra_compute(graph, landmark, landmark, false, workspace);
+      for (std::size_t v = 0; v < vertices_count_; ++v) {
+        from_landmarks_[v * landmarks_count + l] = workspace.get_length(v);
+      }
+
+      // The distances from the landmark in the reverse graph are the
+      // distances to the landmark in the graph:
+      dijkstra_compute(reverse_graph, landmark, landmark, false, workspace);
+      for (std::size_t v = 0; v < vertices_count_; ++v) {
+        to_landmarks_[v * landmarks_count + l] = workspace.get_length(v);
+      }
+    }
+  }
+
+  std::size_t
+  landmarks_count() const {
+    return landmarks_.size();
+  }
+
+  std::vector<type_num> landmarks_;
+  std::size_t vertices_count_;
+
+  // The distance from landmark l to vertex v is at
+  // [v * landmarks_count() + l], or Edge::LENGTH_INFINITY if there is no path.
+  std::vector<type_length> from_landmarks_;
+
+  // The distance from vertex v to landmark l, arranged in the same way.
+  std::vector<type_length> to_landmarks_;
+};
+
+/**
+ * Choose landmarks that are far from each other,
+ * because a landmark gives the best estimates for vertices that are roughly
+ * between it and the end vertex.
+ *
+ * Starting from @a first_vertex, this repeatedly chooses the vertex that is
+ * furthest from the landmarks chosen so far.
+ */
+template <typename T_Num, typename T_Length>
+std::vector<type_num>
+alt_choose_landmarks(const BasicCsrGraph<T_Num, T_Length>& graph,
+  std::size_t landmarks_count, type_num first_vertex = 0) {
+  std::vector<type_num> result;
+  const auto vertices_count = graph.size();
+  if (vertices_count == 0 || landmarks_count == 0) {
+    return result;
+  }
+
+  // The distance from each vertex to its nearest landmark:
+  std::vector<type_length> distances(vertices_count, Edge::LENGTH_INFINITY);
+
+  DijkstraWorkspace workspace;
+  auto landmark = first_vertex;
+  while (result.size() < landmarks_count) {
+    result.emplace_back(landmark);
+
+    dijkstra_compute(graph, landmark, landmark, false, workspace);
+
+    type_length furthest_distance = 0;
+    for (std::size_t v = 0; v < vertices_count; ++v) {
+      distances[v] = std::min(distances[v], workspace.get_length(v));
+
+      // Ignore vertices that are not reachable from any landmark:
+      if (distances[v] != Edge::LENGTH_INFINITY &&
+          distances[v] > furthest_distance) {
+        furthest_distance = distances[v];
+        landmark = v;
+      }
+    }
+
+    if (furthest_distance == 0) {
+      // Every reachable vertex is already a landmark.
+      break;
+    }
+  }
+
+  return result;
+}
+
+/**
+ * A heuristic, for astar_compute_shortest_path(), that estimates the distance
+ * from any vertex to one end vertex, using the triangle inequality with the
+ * precomputed distances to and from some landmarks:
+ * dist(v, end) >= dist(landmark, end) - dist(landmark, v)
+ * and
+ * dist(v, end) >= dist(v, landmark) - dist(end, landmark).
+ *
+ * This never overestimates, and is consistent, so A* never needs to settle a
+ * vertex more than once.
+ */
+class AltHeuristic {
+public:
+  AltHeuristic(const AltLandmarks& landmarks, type_num end_vertex)
+  : landmarks_(landmarks),
+    end_from_landmarks_(
+      landmarks.from_landmarks_.begin() +
+        end_vertex * landmarks.landmarks_count(),
+      landmarks.from_landmarks_.begin() +
+        (end_vertex + 1) * landmarks.landmarks_count()),
+    end_to_landmarks_(landmarks.to_landmarks_.begin() +
+                        end_vertex * landmarks.landmarks_count(),
+      landmarks.to_landmarks_.begin() +
+        (end_vertex + 1) * landmarks.landmarks_count()) {}
+
+  type_length
+  operator()(type_num v) const {
+    const auto landmarks_count = end_from_landmarks_.size();
+    const auto from_landmarks =
+      landmarks_.from_landmarks_.data() + v * landmarks_count;
+    const auto to_landmarks =
+      landmarks_.to_landmarks_.data() + v * landmarks_count;
+
+    type_length result = 0;
+    for (std::size_t l = 0; l < landmarks_count; ++l) {
+      // Ignore landmarks that don't have paths to (or from) both vertices.
+      if (from_landmarks[l] != Edge::LENGTH_INFINITY &&
+          end_from_landmarks_[l] != Edge::LENGTH_INFINITY) {
+        result = std::max(result, end_from_landmarks_[l] - from_landmarks[l]);
+      }
+
+      if (to_landmarks[l] != Edge::LENGTH_INFINITY &&
+          end_to_landmarks_[l] != Edge::LENGTH_INFINITY) {
+        result = std::max(result, to_landmarks[l] - end_to_landmarks_[l]);
+      }
+    }
+
+    return result;
+  }
+
+private:
+  const AltLandmarks& landmarks_;
+
+  // The distances from and to the landmarks for the end vertex,
+  // copied, because they are needed for every vertex.
+  std::vector<type_length> end_from_landmarks_;
+  std::vector<type_length> end_to_landmarks_;
+};
+
+/**
+ * Get the shortest path from @a start_vertex to @a end_vertex,
+ * like dijkstra_compute_shortest_path(), but choosing the next vertex by
+ * the length of the path to it plus the @a heuristic's estimate of the
+ * remaining distance to @a end_vertex, so the search heads towards
+ * @a end_vertex instead of exploring in all directions.
+ *
+ * The priority queue holds those estimated total lengths,
+ * while the @a workspace's distances are the actual lengths.
+ *
+ * This needs the edge lengths to be non-negative.
+ *
+ * @param heuristic A callable that takes a vertex and returns an estimate of
+ * the length of the shortest path from it to @a end_vertex. If this never
+ * overestimates, the result is the shortest path. If it is also consistent,
+ * each vertex is settled at most once, and the estimated total lengths never
+ * decrease, as needed by DijkstraRadixHeap.
+ *
+ * @param edge_filter Called with the source vertex and the edge, returning
+ * false to ignore the edge, as for dijkstra_compute().
+ *
+ * @tparam T_Graph For instance, type_vec_nodes or CsrGraph.
+ * @tparam T_Heuristic The type of the @a heuristic, such as AltHeuristic,
+ * or a lambda, so the call can be inlined.
+ */
+template <typename T_Graph, typename T_Heuristic, typename T_Queue,
+  typename T_EdgeFilter>
+ShortestPath
+astar_compute_shortest_path(const T_Graph& vertices, type_num start_vertex,
+  type_num end_vertex, const T_Heuristic& heuristic,
+  BasicDijkstraWorkspace<T_Queue>& workspace,
+  const T_EdgeFilter& edge_filter) {
+  const auto vertices_size = vertices.size();
+
+  if (start_vertex >= vertices_size) {
+    std::cerr << "start vertex not found in vertices: " << start_vertex
+              << std::endl;
+    return ShortestPath();
+  }
+
+  if (end_vertex >= vertices_size) {
+    std::cerr << "end vertex not found in vertices: " << end_vertex
+              << std::endl;
+    return ShortestPath();
+  }
+
+  workspace.start(vertices_size);
+  workspace.set_length(start_vertex, 0, start_vertex);
+
+  auto& queue = workspace.queue_;
+  queue.push(start_vertex, heuristic(start_vertex));
+
+  while (!queue.empty()) {
+    const auto best = queue.pop();
+    const auto best_vertex = best.vertex_;
+    const auto length = workspace.distances_[best_vertex];
+
+    if (best.total_length_ > length + heuristic(best_vertex)) {
+      // A stale entry, because we later found a shorter path to the same
+      // vertex. See dijkstra_compute().
+      continue;
+    }
+
+    if (best_vertex == end_vertex) {
+      return ShortestPath(
+        length, workspace.get_path(start_vertex, end_vertex));
+    }
+
+    for (const auto& edge : vertices[best_vertex].edges_) {
+      if (!edge_filter(best_vertex, edge)) {
+        continue;
+      }
+
+      const type_num edge_destination_vertex = edge.destination_vertex_;
+      const type_length total_length = length + edge.length_;
+
+      // Ignore edges that don't give us a shorter path:
+      if (workspace.is_reached(edge_destination_vertex) &&
+          total_length >= workspace.distances_[edge_destination_vertex]) {
+        continue;
+      }
+
+      workspace.set_length(
+        edge_destination_vertex, total_length, best_vertex /* predecessor */);
+      queue.push(edge_destination_vertex,
+        total_length + heuristic(edge_destination_vertex));
+    }
+  }
+
+  // There is no path to end_vertex.
+  return ShortestPath();
+}
+
+template <typename T_Graph, typename T_Heuristic, typename T_Queue>
+ShortestPath
+astar_compute_shortest_path(const T_Graph& vertices, type_num start_vertex,
+  type_num end_vertex, const T_Heuristic& heuristic,
+  BasicDijkstraWorkspace<T_Queue>& workspace) {
+  return astar_compute_shortest_path(vertices, start_vertex, end_vertex,
+    heuristic, workspace, DijkstraAllEdges());
+}
+
+template <typename T_Graph, typename T_Heuristic>
+ShortestPath
+astar_compute_shortest_path(const T_Graph& vertices, type_num start_vertex,
+  type_num end_vertex, const T_Heuristic& heuristic) {
+  DijkstraWorkspace workspace;
+  return astar_compute_shortest_path(
+    vertices, start_vertex, end_vertex, heuristic, workspace);
+}
+
+#endif // MURRAYC_ALGORITHMS_EXPERIMENTS_ASTAR
@@ -0,0 +1,89 @@
+#include "astar.h"
+#include "utils/benchmark.h"
+#include "utils/random_graphs.h"
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+
+using type_queries = std::vector<std::pair<type_num, type_num>>;
+
+/**
+ * Run all the @a queries with A* and ALT heuristics for @a landmarks_count
+ * landmarks, and print the queries per second.
+ */
+static type_length
+benchmark_alt(const CsrGraph& graph, const type_queries& queries,
+  std::size_t landmarks_count) {
+  std::unique_ptr<AltLandmarks> landmarks;
+  const auto setup_seconds = benchmark_seconds([&] {
+    landmarks = std::make_unique<AltLandmarks>(
+      graph, alt_choose_landmarks(graph, landmarks_count));
+  });
+
+  // Sum the lengths, so we can check that all the versions give the same
+  // results, and so the compiler can't skip the work.
+  type_length checksum = 0;
+  DijkstraWorkspace workspace;
+  const auto seconds = benchmark_seconds([&] {
+    for (const auto& query : queries) {
+      checksum += astar_compute_shortest_path(graph, query.first,
+        query.second, AltHeuristic(*landmarks, query.second), workspace)
+                    .length_;
+    }
+  });
+
+  std::cout << "A* with " << landmarks_count
+            << " ALT landmarks: " << queries.size() / seconds
+            << " queries/s (precomputed in " << setup_seconds << "s)"
+            << std::endl;
+
+  return checksum;
+}
+
+/**
+ * Usage: murrayc_astar_benchmark [grid_width] [queries_count]
+ *
+ * This uses a grid graph, which, like a road network, has a large diameter.
+ */
+int
+main(int argc, char** argv) {
+  const auto width = benchmark_get_arg<type_num>(argc, argv, 1, 300);
+  const auto queries_count = benchmark_get_arg<type_num>(argc, argv, 2, 300);
+  const auto vertices_count = width * width;
+  std::cout << "vertices: " << vertices_count << ", queries: " << queries_count
+            << std::endl;
+
+  const CsrGraph graph(make_random_grid_graph(width, width, 1000));
+
+  std::mt19937 generator(1);
+  std::uniform_int_distribution<type_num> vertex_distribution(
+    0, vertices_count - 1);
+  type_queries queries;
+  for (type_num i = 0; i < queries_count; ++i) {
+    queries.emplace_back(
+      vertex_distribution(generator), vertex_distribution(generator));
+  }
+
+  type_length checksum_dijkstra = 0;
+  DijkstraWorkspace workspace;
+  const auto dijkstra_seconds = benchmark_seconds([&] {
+    for (const auto& query : queries) {
+      checksum_dijkstra += dijkstra_compute_shortest_path(
+        graph, query.first, query.second, workspace)
+                             .length_;
+    }
+  });
+
+  std::cout << "dijkstra: " << queries.size() / dijkstra_seconds
+            << " queries/s" << std::endl;
+
+  for (const std::size_t landmarks_count : {4, 8, 16}) {
+    if (benchmark_alt(graph, queries, landmarks_count) != checksum_dijkstra) {
+      std::cerr << "The results were not the same." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
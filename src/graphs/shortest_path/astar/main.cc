@@ -0,0 +1,121 @@
+#include "astar.h"
+#include "utils/example_graphs.h"
+#include "utils/random_graphs.h"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * Check that A*, with the @a heuristic for each end vertex,
+ * gives the same lengths as Dijkstra's algorithm, for all pairs of vertices.
+ *
+ * @param get_heuristic A callable that takes an end vertex and returns a
+ * heuristic for it.
+ */
+template <typename T_Graph, typename T_GetHeuristic>
+static void
+test_compare_with_dijkstra(
+  const T_Graph& graph, const T_GetHeuristic& get_heuristic) {
+  DijkstraWorkspace workspace;
+
+  const auto vertices_count = graph.size();
+  for (type_num start = 0; start < vertices_count; ++start) {
+    const auto expected = dijkstra_compute_shortest_paths(graph, start);
+    for (type_num end = 0; end < vertices_count; ++end) {
+      const auto shortest_path = astar_compute_shortest_path(
+        graph, start, end, get_heuristic(end), workspace);
+      assert(shortest_path.length_ == expected.get_length(end));
+
+      if (shortest_path.length_ == Edge::LENGTH_INFINITY) {
+        assert(shortest_path.path_.empty());
+      } else {
+        assert(shortest_path.path_.front() == start);
+        assert(shortest_path.path_.back() == end);
+      }
+    }
+  }
+}
+
+static void
+test_small() {
+  const auto shortest_path = astar_compute_shortest_path(
+    EXAMPLE_GRAPH_SMALL, 0, 3, AStarZeroHeuristic());
+  assert(shortest_path.length_ == 5);
+  assert(shortest_path.path_ == ShortestPath::type_path({0, 1, 3}));
+
+  // There is no path back to vertex 0:
+  assert(astar_compute_shortest_path(
+           EXAMPLE_GRAPH_SMALL, 3, 0, AStarZeroHeuristic())
+           .length_ == Edge::LENGTH_INFINITY);
+}
+
+static void
+test_grid() {
+  // On a grid whose edges all have length 1,
+  // the Manhattan distance is a consistent heuristic.
+  const type_num width = 7;
+  const CsrGraph graph(make_random_grid_graph(width, 5, 1));
+  test_compare_with_dijkstra(graph, [width](type_num end) {
+    return [width, end](type_num v) {
+      const auto dx = static_cast<type_length>(v % width) -
+                      static_cast<type_length>(end % width);
+      const auto dy = static_cast<type_length>(v / width) -
+                      static_cast<type_length>(end / width);
+      return std::abs(dx) + std::abs(dy);
+    };
+  });
+}
+
+static void
+test_alt_landmarks() {
+  const CsrGraph graph(EXAMPLE_GRAPH_SMALL);
+  const AltLandmarks landmarks(graph, {0, 3});
+  assert(landmarks.landmarks_count() == 2);
+
+  // From vertex 0, and to vertex 3:
+  assert(landmarks.from_landmarks_[3 * 2 + 0] == 5);
+  assert(landmarks.to_landmarks_[0 * 2 + 1] == 5);
+
+  // There are no paths from vertex 3, or to vertex 0:
+  assert(landmarks.from_landmarks_[0 * 2 + 1] == Edge::LENGTH_INFINITY);
+  assert(landmarks.to_landmarks_[3 * 2 + 0] == Edge::LENGTH_INFINITY);
+
+  const AltHeuristic heuristic(landmarks, 3);
+  assert(heuristic(0) == 5);
+  assert(heuristic(3) == 0);
+}
+
+static void
+test_alt(const CsrGraph& graph, std::size_t landmarks_count) {
+  const auto chosen = alt_choose_landmarks(graph, landmarks_count);
+  assert(!chosen.empty());
+  assert(chosen.size() <= landmarks_count);
+
+  const AltLandmarks landmarks(graph, chosen);
+  test_compare_with_dijkstra(
+    graph, [&landmarks](type_num end) { return AltHeuristic(landmarks, end); });
+}
+
+int
+main() {
+  const auto start_vertex = 0;
+  const auto dest_vertices = {0, 1, 2, 3};
+  for (auto dest_vertex_num : dest_vertices) {
+    const auto shortest_path = astar_compute_shortest_path(
+      EXAMPLE_GRAPH_SMALL, start_vertex, dest_vertex_num, AStarZeroHeuristic());
+    std::cout << "shortest path from " << start_vertex << " to "
+              << dest_vertex_num << ": " << shortest_path.length_
+              << ", path: " << shortest_path.get_path_string() << std::endl;
+  }
+
+  test_small();
+  test_compare_with_dijkstra(EXAMPLE_GRAPH_SMALL,
+    [](type_num /* end */) { return AStarZeroHeuristic(); });
+  test_grid();
+  test_alt_landmarks();
+  test_alt(CsrGraph(EXAMPLE_GRAPH_SMALL), 2);
+  test_alt(CsrGraph(make_random_graph(100, 300, 20)), 4);
+  test_alt(CsrGraph(make_random_grid_graph(8, 6, 10)), 3);
+
+  return EXIT_SUCCESS;
+}
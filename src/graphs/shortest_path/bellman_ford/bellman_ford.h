@@ -21,9 +21,10 @@ using type_map_predecessors = std::vector<type_num>;
  * Calculate the shortest path from @a s to @a v, using at most @i hops (edges).
  * @result true if the shortest path was changed.
  */
+template <typename T_Edge>
 static bool
 bellman_ford_update_adjacent_vertex(type_shortest_paths& shortest_paths,
-  type_num w, const Edge& edge, type_length& shortest_path_so_far,
+  type_num w, const T_Edge& edge, type_length& shortest_path_so_far,
   type_map_predecessors& predecessors) {
   const auto v = edge.destination_vertex_;
 
@@ -90,8 +91,9 @@ bellman_ford_update_adjacent_vertex(type_shortest_paths& shortest_paths,
  * Calculate the shortest path from @a s to @a v, using at most @i hops (edges).
  * @result true if the shortest path was changed.
  */
+template <typename T_Graph>
 static bool
-bellman_ford_update_for_vertex(const type_vec_nodes& vertices,
+bellman_ford_update_for_vertex(const T_Graph& vertices,
   type_shortest_paths& shortest_paths, type_num v,
   type_length& shortest_path_so_far, type_map_predecessors& predecessors) {
   bool changed = false;
@@ -111,8 +113,9 @@ bellman_ford_update_for_vertex(const type_vec_nodes& vertices,
 /**
  * @result true if at least one shortest path was changed.
  */
+template <typename T_Graph>
 static bool
-bellman_ford_single_iteration(const type_vec_nodes& vertices,
+bellman_ford_single_iteration(const T_Graph& vertices,
   type_shortest_paths& shortest_paths, type_length& shortest_path_so_far,
   type_map_predecessors& predecessors) {
   bool changed = false;
@@ -133,18 +136,21 @@ bellman_ford_single_iteration(const type_vec_nodes& vertices,
  * This will be more efficient if the caller firsts removes excess parallel
  * edges,
  * leaving only the lowest-cost edge between each vertex.
+ *
+ * @tparam T_Graph For instance, type_vec_nodes or CsrGraph.
  */
-std::vector<ShortestPath>
+template <typename T_Graph>
+ShortestPaths
 bellman_ford_single_source_shortest_paths(
-  const type_vec_nodes& vertices, type_num s, bool& has_negative_cycles) {
+  const T_Graph& vertices, type_num s, bool& has_negative_cycles) {
   // Initialize output variable:
   has_negative_cycles = false;
 
   // n:
   const auto vertices_count = vertices.size();
 
-  type_map_predecessors map_path_predecessor(vertices_count);
-  map_path_predecessor[s] = 0; // Invalid
+  type_map_predecessors map_path_predecessor(
+    vertices_count, INVALID_PREDECESSOR);
 
   // Initialize shortest paths:
   // - 0 to get to the source from the source.
@@ -182,26 +188,9 @@ bellman_ford_single_source_shortest_paths(
     has_negative_cycles = true;
   }
 
-  std::vector<ShortestPath> result;
-  type_num end_vertex = 0;
-  for (const auto& length_and_predecessor : shortest_paths) {
-    const auto length = length_and_predecessor;
-
-    // Examine the chain of predecessors to get the full path:
-    std::string path;
-    auto predecessor = end_vertex;
-    while (predecessor != s) {
-      path = std::to_string(predecessor) + ", " + path;
-      predecessor = map_path_predecessor[predecessor];
-    }
-
-    path = std::to_string(s) + ", " + path;
-
-    result.emplace_back(length, path);
-
-    ++end_vertex;
-  }
-  return result;
+  // The paths will only be built from the predecessors if they are needed:
+  return ShortestPaths(
+    s, std::move(shortest_paths), std::move(map_path_predecessor));
 }
 
 #endif // MURRAYC_ALGORITHMS_EXPERIMENTS_BELLMAN_FORD
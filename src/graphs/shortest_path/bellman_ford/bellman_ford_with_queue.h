@@ -1,13 +1,11 @@
 #ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_BELLMAN_FORD_WITH_QUEUE
 #define MURRAYC_ALGORITHMS_EXPERIMENTS_BELLMAN_FORD_WITH_QUEUE
 
-#include "detect_cycle/detect_cycle.h"
 #include "utils/shortest_path.h"
 #include "utils/vertex.h"
 #include <iostream>
 #include <limits>
 #include <queue>
-#include <stack>
 #include <vector>
 
 using type_num = Edge::type_num;
@@ -16,38 +14,80 @@ using type_length = Edge::type_length;
 using type_shortest_paths = std::vector<type_length>;
 
 using type_map_predecessors = std::vector<type_num>;
-constexpr type_num INVALID_PREDECESSOR = std::numeric_limits<type_num>::max();
 
 /**
- * DFS to discover any negative cycle so far
+ * How bellman_ford_single_source_shortest_paths_with_queue() checks for
+ * negative cycles. Without a check, it would never finish if there is a
+ * negative cycle reachable from the start vertex.
+ */
+enum class BellmanFordCycleCheck {
+  // Look for a cycle in the predecessors after every pop from the queue.
+  // This finds a negative cycle as soon as it appears in the predecessors,
+  // but takes O(V) time for each pop.
+  EVERY_POP,
+
+  // Look for a cycle in the predecessors after every V relaxations,
+  // so the O(V) check adds only O(1) amortized time to each relaxation.
+  AMORTIZED,
+
+  // Keep the number of edges in the path to each vertex. A path with V or
+  // more edges must contain a cycle, which can only have made the path
+  // shorter if it is negative. This adds O(1) time to each relaxation, but can
+  // take V times longer to notice a negative cycle than checking the
+  // predecessors.
+  EDGE_COUNTS
+};
+
+/**
+ * Discover any cycle in the predecessors so far.
+ *
+ * The predecessors should be a tree, but they can contain a cycle, which
+ * must be negative. Once the cycle has formed, it is no longer reachable from
+ * the start vertex, so we must look for it from all vertices.
+ * Each vertex has at most one predecessor, so we can just follow the
+ * predecessors from each vertex, until we reach a vertex that has already been
+ * visited, without the stack of a DFS.
+ *
+ * @param visited_by A vector of vertices_count elements, reused by each
+ * call, to avoid allocating it every time.
  */
 static bool
-check_has_negative_cycle(const type_vec_nodes& vertices, type_num s,
-  const type_map_predecessors& predecessors) {
-
-  // Build a graph that is just the shortest path tree so far:
-  // Well, it should be a tree, but it could have a cycle,
-  // which would be negative, which we will then find.
-  const auto n = vertices.size();
-  type_vec_nodes g(n);
-  for (std::size_t i = 0; i < n; ++i) {
-    const auto pred = predecessors[i];
-    if (pred != INVALID_PREDECESSOR) {
-      g[pred].edges_.emplace_back(i, 1); // The weight doesn't matter here.
+check_has_negative_cycle(const type_map_predecessors& predecessors,
+  std::vector<type_num>& visited_by) {
+  const auto vertices_count = predecessors.size();
+  std::fill(visited_by.begin(), visited_by.end(), INVALID_PREDECESSOR);
+
+  for (type_num i = 0; i < vertices_count; ++i) {
+    // Follow the predecessors back from i, marking the vertices as visited
+    // by this walk, until we reach the start vertex, or a vertex visited by
+    // an earlier walk, or a vertex visited by this walk, which means that we
+    // have gone around a cycle:
+    type_num v = i;
+    while (v != INVALID_PREDECESSOR && visited_by[v] == INVALID_PREDECESSOR) {
+      visited_by[v] = i;
+      v = predecessors[v];
+    }
+
+    if (v != INVALID_PREDECESSOR && visited_by[v] == i) {
+      return true;
     }
   }
 
-  // DFS on the tree to find a cycle.
-  return detect_cycle(g, s);
+  return false;
 }
 
 /**
  * Calculate the shortest path from @a s to @a v, using at most @i hops (edges).
+ *
+ * @param edge_counts The number of edges in the shortest path so far to each
+ * vertex, or empty if these are not needed.
  */
+template <typename T_Edge>
 static void
 bellman_ford_update_adjacent_vertex(std::queue<type_num>& q,
   std::vector<bool>& on_q, type_shortest_paths& shortest_paths, type_num w,
-  const Edge& edge, type_map_predecessors& predecessors) {
+  const T_Edge& edge, type_map_predecessors& predecessors,
+  std::vector<type_num>& edge_counts) {
   const auto v = edge.destination_vertex_;
 
   // Check the bounds:
@@ -80,22 +120,18 @@ bellman_ford_update_adjacent_vertex(std::queue<type_num>& q,
     }
   }
 
-  const auto best = std::min(case1, case2);
-
-  // Make sure that it's less than any cost calculated for the same vertex
-  // during this same iteration (i), for another other edge that goes to this
-  // same vertex.
-  auto result = Edge::LENGTH_INFINITY;
-  const auto existing = shortest_paths[v];
-  if (existing < best) {
-    result = existing;
-  } else {
-    result = best;
-
-    // Also update the predecessor, if we've found a new best way to get to this
-    // vertex:
-    if (case2 < case1) {
-      predecessors[v] = w;
+  // Only put the vertex on the queue again if its path is now shorter,
+  // so we don't relax its edges again for nothing:
+  auto result = case1;
+  if (case2 < case1) {
+    result = case2;
+
+    // Also update the predecessor, because we've found a new best way to get
+    // to this vertex:
+    predecessors[v] = w;
+
+    if (!edge_counts.empty()) {
+      edge_counts[v] = edge_counts[w] + 1;
     }
 
     if (!on_q[v]) {
@@ -119,15 +155,16 @@ bellman_ford_update_adjacent_vertex(std::queue<type_num>& q,
 /**
  * "Relax" the path to v.
  */
+template <typename T_Graph>
 static void
 bellman_ford_update_for_vertex(std::queue<type_num>& q, std::vector<bool>& on_q,
-  const type_vec_nodes& vertices, type_shortest_paths& shortest_paths,
-  type_num v, type_map_predecessors& predecessors) {
+  const T_Graph& vertices, type_shortest_paths& shortest_paths, type_num v,
+  type_map_predecessors& predecessors, std::vector<type_num>& edge_counts) {
   for (const auto& edge : vertices[v].edges_) {
     // bellman_ford_update_adjacent_vertex will use the existing shortest_paths
     // and write new values in shortest_paths.
     bellman_ford_update_adjacent_vertex(
-      q, on_q, shortest_paths, v, edge, predecessors);
+      q, on_q, shortest_paths, v, edge, predecessors, edge_counts);
   }
 }
 
@@ -141,8 +178,7 @@ bellman_ford_update_for_vertex(std::queue<type_num>& q, std::vector<bool>& on_q,
  * whose paths changed (were relaxed) last time.
  * However, I wonder if cache considerations (data locality) makes the standard
  * algorithm perform better in practice.
- * Performance can be improved by only checking for a cycle every now and then,
- * for instance after every n pops from the stack.
+ * The check for negative cycles is chosen by @a cycle_check.
  *
  * This is based on Sedgewick/Wayne's implementation in
  * Algorithms (4th edition), page 674.
@@ -153,10 +189,14 @@ bellman_ford_update_for_vertex(std::queue<type_num>& q, std::vector<bool>& on_q,
  * https://en.wikipedia.org/wiki/Shortest_Path_Faster_Algorithm
  * However, I think I've also read somewhere that this was Bellman's original
  * algorithm.
+ *
+ * @tparam T_Graph For instance, type_vec_nodes or CsrGraph.
  */
-std::vector<ShortestPath>
-bellman_ford_single_source_shortest_paths_with_queue(
-  const type_vec_nodes& vertices, type_num s, bool& has_negative_cycles) {
+template <typename T_Graph>
+ShortestPaths
+bellman_ford_single_source_shortest_paths_with_queue(const T_Graph& vertices,
+  type_num s, bool& has_negative_cycles,
+  BellmanFordCycleCheck cycle_check = BellmanFordCycleCheck::AMORTIZED) {
   // Initialize output variable:
   has_negative_cycles = false;
 
@@ -178,50 +218,59 @@ bellman_ford_single_source_shortest_paths_with_queue(
   std::queue<type_num> q;
   q.emplace(s);
 
+  std::vector<type_num> edge_counts;
+  if (cycle_check == BellmanFordCycleCheck::EDGE_COUNTS) {
+    edge_counts.resize(vertices_count);
+  }
+
+  std::vector<type_num> visited_by;
+  if (cycle_check != BellmanFordCycleCheck::EDGE_COUNTS) {
+    visited_by.resize(vertices_count);
+  }
+
+  // The number of relaxations since the last check for a cycle in the
+  // predecessors:
+  std::size_t relaxations_since_check = 0;
+
   while (!q.empty()) {
-    // std::cout << "i=" << i << std::endl;
     const auto v = q.front();
     q.pop();
-
-    // Relax the shortest path to this vertex:
-    bellman_ford_update_for_vertex(
-      q, on_q, vertices, shortest_paths, v, map_path_predecessor);
-    if (check_has_negative_cycle(vertices, s, map_path_predecessor)) {
+    on_q[v] = false;
+
+    // A path with vertices_count or more edges can only have been found via a
+    // negative cycle. A path's edge count only grows when it gets shorter,
+    // which puts its vertex on the queue, so we only need to check the
+    // vertices as they come off the queue.
+    if (cycle_check == BellmanFordCycleCheck::EDGE_COUNTS &&
+        edge_counts[v] >= vertices_count) {
       has_negative_cycles = true;
       return {};
     }
-  }
 
-  // Check for a negative cycle:
-  // Try one more calculation, this time with i=n.
-  // If we get a shorter path then we must have taken a negative cycle:
-  // TODO: bellman_ford_single_iteration(q, on_q, vertices, shortest_paths,
-  //  map_path_predecessor);
-
-  // if (shortest_path_so_far < shortest_path) {
-  //  has_negative_cycles = true;
-  //}
-
-  std::vector<ShortestPath> result;
-  type_num end_vertex = 0;
-  for (const auto& length_and_predecessor : shortest_paths) {
-    const auto length = length_and_predecessor;
-
-    // Examine the chain of predecessors to get the full path:
-    std::string path;
-    auto predecessor = end_vertex;
-    while (predecessor != s) {
-      path = std::to_string(predecessor) + ", " + path;
-      predecessor = map_path_predecessor[predecessor];
+    // Relax the shortest path to this vertex:
+    bellman_ford_update_for_vertex(
+      q, on_q, vertices, shortest_paths, v, map_path_predecessor, edge_counts);
+
+    bool check = false;
+    if (cycle_check == BellmanFordCycleCheck::EVERY_POP) {
+      check = true;
+    } else if (cycle_check == BellmanFordCycleCheck::AMORTIZED) {
+      relaxations_since_check += vertices[v].edges_.size();
+      check = relaxations_since_check >= vertices_count;
     }
 
-    path = std::to_string(s) + ", " + path;
-
-    result.emplace_back(length, path);
-
-    ++end_vertex;
+    if (check) {
+      relaxations_since_check = 0;
+      if (check_has_negative_cycle(map_path_predecessor, visited_by)) {
+        has_negative_cycles = true;
+        return {};
+      }
+    }
   }
-  return result;
+
+  // The paths will only be built from the predecessors if they are needed:
+  return ShortestPaths(
+    s, std::move(shortest_paths), std::move(map_path_predecessor));
 }
 
 #endif // MURRAYC_ALGORITHMS_EXPERIMENTS_BELLMAN_FORD_WITH_QUEUE
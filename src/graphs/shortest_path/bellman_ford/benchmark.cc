@@ -0,0 +1,130 @@
+#include "bellman_ford.h"
+#include "bellman_ford_with_queue.h"
+#include "utils/benchmark.h"
+#include "utils/csr_graph.h"
+#include "utils/random_graphs.h"
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * Run bellman_ford_single_source_shortest_paths_with_queue() with the
+ * @a cycle_check, and print how long it took.
+ * @result false if the result is not as expected.
+ */
+static bool
+benchmark_with_queue(const std::string& name, const CsrGraph& graph,
+  BellmanFordCycleCheck cycle_check, const ShortestPaths& expected,
+  bool expected_has_negative_cycles, double plain_seconds) {
+  bool has_negative_cycles = false;
+  ShortestPaths shortest_paths;
+  const auto seconds = benchmark_seconds([&] {
+    shortest_paths = bellman_ford_single_source_shortest_paths_with_queue(
+      graph, 0, has_negative_cycles, cycle_check);
+  });
+  std::cout << "  with queue, " << name << ": " << seconds << "s";
+  if (plain_seconds > 0) {
+    std::cout << ", speedup: " << plain_seconds / seconds;
+  }
+  std::cout << std::endl;
+
+  if (has_negative_cycles != expected_has_negative_cycles) {
+    std::cerr << "The negative cycle check was wrong." << std::endl;
+    return false;
+  }
+
+  if (!has_negative_cycles &&
+      shortest_paths.get_length(graph.size() - 1) !=
+        expected.get_length(graph.size() - 1)) {
+    std::cerr << "The results were not the same." << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Usage: murrayc_bellman_ford_benchmark [max_vertices_count_for_slow_checks]
+ *
+ * Checking for a negative cycle after every pop takes O(V) time per pop,
+ * and checking the edge counts can take many passes around a negative cycle
+ * to notice it, so those are only run for graphs with up to
+ * max_vertices_count_for_slow_checks vertices.
+ */
+int
+main(int argc, char** argv) {
+  const auto max_vertices_count_for_slow_checks =
+    benchmark_get_arg<type_num>(argc, argv, 1, 10000);
+
+  for (const type_num vertices_count : {10000, 100000, 1000000}) {
+    std::cout << "vertices: " << vertices_count
+              << ", edges: " << 10 * vertices_count << std::endl;
+
+    // Negative edges only from higher to lower numbered vertices,
+    // with the edges back long enough to avoid negative cycles.
+    // The plain version relaxes the vertices in order, so it needs an
+    // iteration for each negative edge along a path, as it would in a graph
+    // whose vertices are not numbered in any useful order.
+    auto vertices = make_random_graph(vertices_count, 10 * vertices_count, 100);
+    for (type_num i = 0; i < vertices_count; ++i) {
+      for (auto& edge : vertices[i].edges_) {
+        if (edge.destination_vertex_ < i) {
+          edge.length_ -= 20;
+        } else {
+          edge.length_ += 20 * vertices_count;
+        }
+      }
+    }
+
+    const CsrGraph graph(vertices);
+
+    bool has_negative_cycles = false;
+    ShortestPaths expected;
+    const auto plain_seconds = benchmark_seconds([&] {
+      expected = bellman_ford_single_source_shortest_paths(
+        graph, 0, has_negative_cycles);
+    });
+    std::cout << "  bellman_ford_single_source_shortest_paths(): "
+              << plain_seconds << "s" << std::endl;
+
+    if (vertices_count <= max_vertices_count_for_slow_checks &&
+        !benchmark_with_queue("every pop", graph,
+          BellmanFordCycleCheck::EVERY_POP, expected, false, plain_seconds)) {
+      return EXIT_FAILURE;
+    }
+
+    if (!benchmark_with_queue("amortized", graph,
+          BellmanFordCycleCheck::AMORTIZED, expected, false, plain_seconds) ||
+        !benchmark_with_queue("edge counts", graph,
+          BellmanFordCycleCheck::EDGE_COUNTS, expected, false,
+          plain_seconds)) {
+      return EXIT_FAILURE;
+    }
+
+    // How long it takes to find a negative cycle, reachable from vertex 0.
+    // The plain version would take V - 1 iterations before checking, so it is
+    // not compared.
+    std::cout << "  with a negative cycle:" << std::endl;
+    vertices[vertices_count - 1].edges_.emplace_back(vertices_count - 2, -10);
+    vertices[vertices_count - 2].edges_.emplace_back(vertices_count - 1, -10);
+    const CsrGraph cycle_graph(vertices);
+
+    if (vertices_count <= max_vertices_count_for_slow_checks &&
+        !benchmark_with_queue("every pop", cycle_graph,
+          BellmanFordCycleCheck::EVERY_POP, expected, true, 0)) {
+      return EXIT_FAILURE;
+    }
+
+    if (!benchmark_with_queue("amortized", cycle_graph,
+          BellmanFordCycleCheck::AMORTIZED, expected, true, 0)) {
+      return EXIT_FAILURE;
+    }
+
+    if (vertices_count <= max_vertices_count_for_slow_checks &&
+        !benchmark_with_queue("edge counts", cycle_graph,
+          BellmanFordCycleCheck::EDGE_COUNTS, expected, true, 0)) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
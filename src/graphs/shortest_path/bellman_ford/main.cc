@@ -1,6 +1,8 @@
 #include "bellman_ford.h"
 #include "bellman_ford_with_queue.h"
+#include "utils/csr_graph.h"
 #include "utils/example_graphs.h"
+#include "utils/random_graphs.h"
 #include <cassert>
 #include <cstdlib>
 #include <iostream>
@@ -18,7 +20,7 @@ test_bellman_ford() {
     const auto& shortest_path = shortest_paths[dest_vertex_num];
     std::cout << "shortest path from " << start_vertex << " to "
               << dest_vertex_num << ": " << shortest_path.length_
-              << ", path: " << shortest_path.path_ << std::endl;
+              << ", path: " << shortest_path.get_path_string() << std::endl;
   }
 
   assert(!has_negative_cycles);
@@ -28,6 +30,9 @@ test_bellman_ford() {
   assert(shortest_paths[1].length_ == -5);
   assert(shortest_paths[2].length_ == -4);
   assert(shortest_paths[3].length_ == -3);
+
+  assert(shortest_paths.get_path(3) == ShortestPath::type_path({0, 1, 2, 3}));
+  assert(shortest_paths.get_path(5) == ShortestPath::type_path({0, 5}));
 }
 
 static void
@@ -45,7 +50,7 @@ test_bellman_ford_with_queue() {
     const auto& shortest_path = shortest_paths[dest_vertex_num];
     std::cout << "shortest path from " << start_vertex << " to "
               << dest_vertex_num << ": " << shortest_path.length_
-              << ", path: " << shortest_path.path_ << std::endl;
+              << ", path: " << shortest_path.get_path_string() << std::endl;
   }
 
   assert(!has_negative_cycles);
@@ -57,10 +62,105 @@ test_bellman_ford_with_queue() {
   assert(shortest_paths[3].length_ == -3);
 }
 
+/**
+ * Check that each cycle check gives the same results as
+ * bellman_ford_single_source_shortest_paths(), on a graph with negative
+ * edges, but without negative cycles.
+ */
+static void
+test_bellman_ford_with_queue_cycle_checks() {
+  // Negative edges only from lower to higher numbered vertices,
+  // with the edges back long enough to avoid negative cycles:
+  auto vertices = make_random_graph(500, 3000, 100);
+  for (type_num i = 0; i < vertices.size(); ++i) {
+    for (auto& edge : vertices[i].edges_) {
+      if (edge.destination_vertex_ > i) {
+        edge.length_ -= 50;
+      } else {
+        edge.length_ += 50 * vertices.size();
+      }
+    }
+  }
+
+  bool has_negative_cycles = false;
+  const auto expected =
+    bellman_ford_single_source_shortest_paths(vertices, 0, has_negative_cycles);
+  assert(!has_negative_cycles);
+
+  const CsrGraph graph(vertices);
+  for (const auto cycle_check :
+    {BellmanFordCycleCheck::EVERY_POP, BellmanFordCycleCheck::AMORTIZED,
+      BellmanFordCycleCheck::EDGE_COUNTS}) {
+    const auto shortest_paths =
+      bellman_ford_single_source_shortest_paths_with_queue(
+        vertices, 0, has_negative_cycles, cycle_check);
+    assert(!has_negative_cycles);
+
+    const auto csr_shortest_paths =
+      bellman_ford_single_source_shortest_paths_with_queue(
+        graph, 0, has_negative_cycles, cycle_check);
+    assert(!has_negative_cycles);
+
+    for (type_num v = 0; v < vertices.size(); ++v) {
+      assert(shortest_paths.get_length(v) == expected.get_length(v));
+      assert(csr_shortest_paths.get_length(v) == expected.get_length(v));
+    }
+  }
+
+  // A negative cycle, reachable from vertex 0:
+  vertices[0].edges_.emplace_back(1, 1);
+  vertices[1].edges_.emplace_back(2, -5);
+  vertices[2].edges_.emplace_back(1, 1);
+  bellman_ford_single_source_shortest_paths(vertices, 0, has_negative_cycles);
+  assert(has_negative_cycles);
+
+  for (const auto cycle_check :
+    {BellmanFordCycleCheck::EVERY_POP, BellmanFordCycleCheck::AMORTIZED,
+      BellmanFordCycleCheck::EDGE_COUNTS}) {
+    has_negative_cycles = false;
+    bellman_ford_single_source_shortest_paths_with_queue(
+      vertices, 0, has_negative_cycles, cycle_check);
+    assert(has_negative_cycles);
+  }
+}
+
+static void
+test_bellman_ford_csr() {
+  const CsrGraph graph(EXAMPLE_GRAPH_SMALL_WITH_NEGATIVE_EDGES);
+
+  bool has_negative_cycles = false;
+  const auto shortest_paths =
+    bellman_ford_single_source_shortest_paths(graph, 0, has_negative_cycles);
+
+  assert(!has_negative_cycles);
+  assert(!shortest_paths.empty());
+
+  assert(shortest_paths[0].length_ == 0);
+  assert(shortest_paths[1].length_ == -5);
+  assert(shortest_paths[2].length_ == -4);
+  assert(shortest_paths[3].length_ == -3);
+}
+
+static void
+test_bellman_ford_compact_edges() {
+  const auto graph =
+    convert_vertices<CompactEdge>(EXAMPLE_GRAPH_SMALL_WITH_NEGATIVE_EDGES);
+
+  bool has_negative_cycles = false;
+  const auto shortest_paths =
+    bellman_ford_single_source_shortest_paths(graph, 0, has_negative_cycles);
+
+  assert(!has_negative_cycles);
+  assert(shortest_paths[3].length_ == -3);
+}
+
 int
 main() {
   test_bellman_ford();
+  test_bellman_ford_csr();
+  test_bellman_ford_compact_edges();
   test_bellman_ford_with_queue();
+  test_bellman_ford_with_queue_cycle_checks();
 
   return EXIT_SUCCESS;
 }
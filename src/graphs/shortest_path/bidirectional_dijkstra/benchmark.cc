@@ -0,0 +1,72 @@
+#include "bidirectional_dijkstra.h"
+#include "utils/benchmark.h"
+#include "utils/random_graphs.h"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+/**
+ * Usage: murrayc_bidirectional_dijkstra_benchmark [grid_width]
+ * [queries_count]
+ *
+ * This uses a grid graph, which, like a road network, has a large diameter.
+ */
+int
+main(int argc, char** argv) {
+  const auto width = benchmark_get_arg<type_num>(argc, argv, 1, 300);
+  const auto queries_count = benchmark_get_arg<type_num>(argc, argv, 2, 300);
+  const auto vertices_count = width * width;
+  std::cout << "vertices: " << vertices_count << ", queries: " << queries_count
+            << std::endl;
+
+  const auto vertices = make_random_grid_graph(width, width, 1000);
+  const BidirectionalGraph graph(vertices);
+
+  std::mt19937 generator(1);
+  std::uniform_int_distribution<type_num> vertex_distribution(
+    0, vertices_count - 1);
+  std::vector<std::pair<type_num, type_num>> queries;
+  for (type_num i = 0; i < queries_count; ++i) {
+    queries.emplace_back(
+      vertex_distribution(generator), vertex_distribution(generator));
+  }
+
+  // Sum the lengths, so we can check that both versions give the same
+  // results, and so the compiler can't skip the work.
+  type_length checksum_dijkstra = 0;
+  DijkstraWorkspace workspace;
+  const auto dijkstra_seconds = benchmark_seconds([&] {
+    for (const auto& query : queries) {
+      checksum_dijkstra += dijkstra_compute_shortest_path(
+        graph.forward_, query.first, query.second, workspace)
+                             .length_;
+    }
+  });
+
+  std::cout << "dijkstra, CsrGraph: " << queries.size() / dijkstra_seconds
+            << " queries/s" << std::endl;
+
+  type_length checksum_bidirectional = 0;
+  std::size_t settled_count = 0;
+  BidirectionalDijkstraWorkspace bidirectional_workspace;
+  const auto bidirectional_seconds = benchmark_seconds([&] {
+    for (const auto& query : queries) {
+      checksum_bidirectional += bidirectional_dijkstra_compute_shortest_path(
+        graph, query.first, query.second, bidirectional_workspace)
+                                  .length_;
+      settled_count += bidirectional_workspace.settled_count_;
+    }
+  });
+
+  std::cout << "bidirectional dijkstra: "
+            << queries.size() / bidirectional_seconds << " queries/s, "
+            << static_cast<double>(settled_count) / queries.size()
+            << " vertices settled per query" << std::endl;
+
+  if (checksum_dijkstra != checksum_bidirectional) {
+    std::cerr << "The results were not the same." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,232 @@
+#ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_BIDIRECTIONAL_DIJKSTRA
+#define MURRAYC_ALGORITHMS_EXPERIMENTS_BIDIRECTIONAL_DIJKSTRA
+
+#include "shortest_path/dijkstra/dijkstra.h"
+#include "utils/csr_graph.h"
+#include "utils/shortest_path.h"
+#include <iostream>
+#include <vector>
+
+/**
+ * A graph, as a BasicCsrGraph, along with its reverse graph,
+ * so that a search can go backwards from the end vertex too.
+ *
+ * The reverse graph is built once, when this is constructed,
+ * so many queries can use it without rebuilding it.
+ */
+template <typename T_Num, typename T_Length>
+class BasicBidirectionalGraph {
+public:
+  using type_num = T_Num;
+  using type_length = T_Length;
+  using type_csr_graph = BasicCsrGraph<T_Num, T_Length>;
+
+  BasicBidirectionalGraph() {}
+
+  template <typename T_Edge>
+  explicit BasicBidirectionalGraph(
+    const std::vector<BasicVertex<T_Edge>>& vertices)
+  : forward_(vertices), backward_(make_reverse_csr_graph(forward_)) {}
+
+  explicit BasicBidirectionalGraph(const type_csr_graph& graph)
+  : forward_(graph), backward_(make_reverse_csr_graph(forward_)) {}
+
+  /**
+   * The number of vertices.
+   */
+  std::size_t
+  size() const {
+    return forward_.size();
+  }
+
+  type_csr_graph forward_;
+
+  // The same graph, with all of its edges reversed.
+  type_csr_graph backward_;
+};
+
+using BidirectionalGraph =
+  BasicBidirectionalGraph<Edge::type_num, Edge::type_length>;
+
+/**
+ * The arrays used by bidirectional_dijkstra_compute_shortest_path(),
+ * for the searches from each end, which can be reused by many calls.
+ *
+ * @tparam T_Queue The priority queue, such as DijkstraBinaryHeap.
+ */
+template <typename T_Queue = DijkstraBinaryHeap>
+class BasicBidirectionalDijkstraWorkspace {
+public:
+  BasicBidirectionalDijkstraWorkspace() : settled_count_(0) {}
+
+  BasicDijkstraWorkspace<T_Queue> forward_;
+  BasicDijkstraWorkspace<T_Queue> backward_;
+
+  // The number of vertices that the last query settled, from either end.
+  std::size_t settled_count_;
+};
+
+using BidirectionalDijkstraWorkspace = BasicBidirectionalDijkstraWorkspace<>;
+
+/**
+ * Settle the next vertex of one of the searches, relaxing its edges.
+ * If an edge leads to a vertex that the other search has reached,
+ * that gives a path from the start vertex to the end vertex, so update
+ * @a best_length and @a meeting_vertex if it is the shortest path so far.
+ *
+ * @param radius The length of the path to the settled vertex.
+ * No vertex that this search settles later can be closer.
+ * @result false if there are no more vertices for this search to settle.
+ */
+template <typename T_Graph, typename T_Queue>
+bool
+bidirectional_dijkstra_settle_next(const T_Graph& graph,
+  BasicDijkstraWorkspace<T_Queue>& workspace,
+  const BasicDijkstraWorkspace<T_Queue>& other_workspace, type_length& radius,
+  type_length& best_length, type_num& meeting_vertex) {
+  auto& queue = workspace.queue_;
+  while (!queue.empty()) {
+    const auto best = queue.pop();
+    const auto best_vertex = best.vertex_;
+
+    if (best.total_length_ > workspace.distances_[best_vertex]) {
+      // A stale entry. See dijkstra_compute().
+      continue;
+    }
+
+    radius = best.total_length_;
+
+    for (const auto& edge : graph[best_vertex].edges_) {
+      const type_num edge_destination_vertex = edge.destination_vertex_;
+      const type_length total_length = radius + edge.length_;
+
+      if (other_workspace.is_reached(edge_destination_vertex)) {
+        const auto length_via_edge =
+          total_length + other_workspace.distances_[edge_destination_vertex];
+        if (length_via_edge < best_length) {
+          best_length = length_via_edge;
+          meeting_vertex = edge_destination_vertex;
+        }
+      }
+
+      // Ignore edges that don't give us a shorter path:
+      if (workspace.is_reached(edge_destination_vertex) &&
+          total_length >= workspace.distances_[edge_destination_vertex]) {
+        continue;
+      }
+
+      workspace.set_length(
+        edge_destination_vertex, total_length, best_vertex /* predecessor */);
+      queue.push(edge_destination_vertex, total_length);
+    }
+
+    return true;
+  }
+
+  return false;
+}
+
+/**
+ * Get the shortest path from @a start_vertex to @a end_vertex,
+ * by searching forwards from @a start_vertex and backwards from
+ * @a end_vertex, alternately, until the searches meet.
+ *
+ * This stops when the radii of the two searches add up to at least the
+ * length of the shortest path found so far, because any shorter path would
+ * need a vertex that is closer than those radii to one of the ends,
+ * which would already have been settled.
+ * Each search settles only the vertices within about half of the
+ * shortest path's length, so, on a large sparse graph, such as a road
+ * network, this settles far fewer vertices than dijkstra_compute().
+ *
+ * Like dijkstra_compute(), this needs the edge lengths to be non-negative.
+ *
+ * @param workspace The arrays for the searches, reused from previous calls.
+ */
+template <typename T_Num, typename T_Length, typename T_Queue>
+ShortestPath
+bidirectional_dijkstra_compute_shortest_path(
+  const BasicBidirectionalGraph<T_Num, T_Length>& graph, type_num start_vertex,
+  type_num end_vertex,
+  BasicBidirectionalDijkstraWorkspace<T_Queue>& workspace) {
+  const auto vertices_size = graph.size();
+  workspace.settled_count_ = 0;
+
+  if (start_vertex >= vertices_size) {
+    std::cerr << "start vertex not found in vertices: " << start_vertex
+              << std::endl;
+    return ShortestPath();
+  }
+
+  if (end_vertex >= vertices_size) {
+    std::cerr << "end vertex not found in vertices: " << end_vertex
+              << std::endl;
+    return ShortestPath();
+  }
+
+  if (start_vertex == end_vertex) {
+    return ShortestPath(0, ShortestPath::type_path({start_vertex}));
+  }
+
+  auto& forward = workspace.forward_;
+  auto& backward = workspace.backward_;
+
+  forward.start(vertices_size);
+  forward.set_length(start_vertex, 0, start_vertex);
+  forward.queue_.push(start_vertex, 0);
+
+  backward.start(vertices_size);
+  backward.set_length(end_vertex, 0, end_vertex);
+  backward.queue_.push(end_vertex, 0);
+
+  type_length forward_radius = 0;
+  type_length backward_radius = 0;
+  type_length best_length = Edge::LENGTH_INFINITY;
+  type_num meeting_vertex = start_vertex;
+
+  bool search_forward = true;
+  while (forward_radius + backward_radius < best_length) {
+    // When either search has run out of vertices,
+    // it has already seen all the paths that it could contribute to.
+    const auto settled = search_forward
+      ? bidirectional_dijkstra_settle_next(graph.forward_, forward, backward,
+          forward_radius, best_length, meeting_vertex)
+      : bidirectional_dijkstra_settle_next(graph.backward_, backward, forward,
+          backward_radius, best_length, meeting_vertex);
+    if (!settled) {
+      break;
+    }
+
+    ++workspace.settled_count_;
+    search_forward = !search_forward;
+  }
+
+  if (best_length == Edge::LENGTH_INFINITY) {
+    return ShortestPath();
+  }
+
+  // The forward path from the start vertex to the meeting vertex,
+  // followed by the backward path from the meeting vertex to the end vertex,
+  // without repeating the meeting vertex:
+  auto path = get_path_vertices_from_predecessors(
+    start_vertex, meeting_vertex, forward.predecessors_);
+  const auto backward_path = get_path_vertices_from_predecessors(
+    end_vertex, meeting_vertex, backward.predecessors_);
+  if (!backward_path.empty()) {
+    path.insert(path.end(), backward_path.rbegin() + 1, backward_path.rend());
+  }
+
+  return ShortestPath(best_length, std::move(path));
+}
+
+template <typename T_Num, typename T_Length>
+ShortestPath
+bidirectional_dijkstra_compute_shortest_path(
+  const BasicBidirectionalGraph<T_Num, T_Length>& graph, type_num start_vertex,
+  type_num end_vertex) {
+  BidirectionalDijkstraWorkspace workspace;
+  return bidirectional_dijkstra_compute_shortest_path(
+    graph, start_vertex, end_vertex, workspace);
+}
+
+#endif // MURRAYC_ALGORITHMS_EXPERIMENTS_BIDIRECTIONAL_DIJKSTRA
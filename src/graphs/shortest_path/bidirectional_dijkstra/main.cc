@@ -0,0 +1,109 @@
+#include "bidirectional_dijkstra.h"
+#include "utils/example_graphs.h"
+#include "utils/random_graphs.h"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * Check that the path really has the length,
+ * using the shortest edge between each pair of vertices along it.
+ */
+static bool
+check_path_length(const type_vec_nodes& vertices, const ShortestPath& path) {
+  type_length length = 0;
+  for (std::size_t i = 1; i < path.path_.size(); ++i) {
+    type_length edge_length = Edge::LENGTH_INFINITY;
+    for (const auto& edge : vertices[path.path_[i - 1]].edges_) {
+      if (edge.destination_vertex_ == path.path_[i]) {
+        edge_length = std::min(edge_length, edge.length_);
+      }
+    }
+
+    if (edge_length == Edge::LENGTH_INFINITY) {
+      return false;
+    }
+
+    length += edge_length;
+  }
+
+  return length == path.length_;
+}
+
+static void
+test_reverse_csr_graph() {
+  const CsrGraph graph(EXAMPLE_GRAPH_SMALL);
+  const auto reverse = make_reverse_csr_graph(graph);
+  assert(reverse.size() == graph.size());
+  assert(reverse.edges_count() == graph.edges_count());
+
+  // The edges leading to vertex 3, from 1 and 2:
+  const auto edges = reverse[3].edges_;
+  assert(edges.size() == 2);
+  assert(edges[0].destination_vertex_ == 1);
+  assert(edges[0].length_ == 2);
+  assert(edges[1].destination_vertex_ == 2);
+  assert(edges[1].length_ == 50);
+
+  assert(reverse[0].edges_.empty());
+}
+
+static void
+test_compare_with_dijkstra(const type_vec_nodes& vertices) {
+  const BidirectionalGraph graph(vertices);
+  BidirectionalDijkstraWorkspace workspace;
+
+  const auto vertices_count = vertices.size();
+  for (type_num start = 0; start < vertices_count; ++start) {
+    const auto expected = dijkstra_compute_shortest_paths(vertices, start);
+    for (type_num end = 0; end < vertices_count; ++end) {
+      const auto shortest_path = bidirectional_dijkstra_compute_shortest_path(
+        graph, start, end, workspace);
+      assert(shortest_path.length_ == expected.get_length(end));
+
+      if (shortest_path.length_ == Edge::LENGTH_INFINITY) {
+        assert(shortest_path.path_.empty());
+      } else {
+        assert(shortest_path.path_.front() == start);
+        assert(shortest_path.path_.back() == end);
+        assert(check_path_length(vertices, shortest_path));
+      }
+    }
+  }
+}
+
+static void
+test_small() {
+  const BidirectionalGraph graph(EXAMPLE_GRAPH_SMALL);
+
+  const auto shortest_path =
+    bidirectional_dijkstra_compute_shortest_path(graph, 0, 3);
+  assert(shortest_path.length_ == 5);
+  assert(shortest_path.path_ == ShortestPath::type_path({0, 1, 3}));
+
+  // There is no path back to vertex 0:
+  assert(bidirectional_dijkstra_compute_shortest_path(graph, 3, 0).length_ ==
+         Edge::LENGTH_INFINITY);
+}
+
+int
+main() {
+  const BidirectionalGraph graph(EXAMPLE_GRAPH_SMALL);
+  const auto start_vertex = 0;
+  const auto dest_vertices = {0, 1, 2, 3};
+  for (auto dest_vertex_num : dest_vertices) {
+    const auto shortest_path = bidirectional_dijkstra_compute_shortest_path(
+      graph, start_vertex, dest_vertex_num);
+    std::cout << "shortest path from " << start_vertex << " to "
+              << dest_vertex_num << ": " << shortest_path.length_
+              << ", path: " << shortest_path.get_path_string() << std::endl;
+  }
+
+  test_reverse_csr_graph();
+  test_small();
+  test_compare_with_dijkstra(EXAMPLE_GRAPH_SMALL);
+  test_compare_with_dijkstra(make_random_graph(100, 300, 20));
+  test_compare_with_dijkstra(make_random_grid_graph(8, 6, 10));
+
+  return EXIT_SUCCESS;
+}
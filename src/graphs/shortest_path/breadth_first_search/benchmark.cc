@@ -0,0 +1,51 @@
+#include "breadth_first_search.h"
+#include "utils/benchmark.h"
+#include "utils/csr_graph.h"
+#include "utils/random_graphs.h"
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * Usage: murrayc_breadth_first_search_benchmark [vertices_count]
+ * [edges_per_vertex]
+ */
+int
+main(int argc, char** argv) {
+  const auto vertices_count =
+    benchmark_get_arg<type_num>(argc, argv, 1, 1000000);
+  const auto edges_per_vertex = benchmark_get_arg<type_num>(argc, argv, 2, 16);
+  std::cout << "vertices: " << vertices_count
+            << ", edges: " << vertices_count * edges_per_vertex << std::endl;
+
+  // A random graph has a low diameter, like a social network:
+  const CsrGraph graph(make_random_graph(
+    vertices_count, vertices_count * edges_per_vertex, 1000));
+
+  BfsReverseGraph reverse_graph;
+  const auto reverse_seconds =
+    benchmark_seconds([&] { reverse_graph = BfsReverseGraph(graph); });
+  std::cout << "building BfsReverseGraph: " << reverse_seconds << "s"
+            << std::endl;
+
+  BfsWorkspace top_down_workspace;
+  const auto top_down_seconds = benchmark_seconds(
+    [&] { bfs_compute(graph, 0, 0, false, top_down_workspace); });
+  std::cout << "top-down: " << top_down_seconds
+            << "s, edges inspected: " << top_down_workspace.edges_inspected_
+            << std::endl;
+
+  BfsWorkspace workspace;
+  const auto seconds = benchmark_seconds(
+    [&] { bfs_compute(graph, &reverse_graph, 0, 0, false, workspace); });
+  std::cout << "direction-optimizing: " << seconds
+            << "s, edges inspected: " << workspace.edges_inspected_
+            << ", bottom-up steps: " << workspace.bottom_up_steps_
+            << ", speedup: " << top_down_seconds / seconds << std::endl;
+
+  if (workspace.depths_ != top_down_workspace.depths_) {
+    std::cerr << "The depths were not the same." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
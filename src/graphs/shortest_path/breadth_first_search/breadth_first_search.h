@@ -1,94 +1,216 @@
 #ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_BFS
 #define MURRAYC_ALGORITHMS_EXPERIMENTS_BFS
 
+#include "utils/bit_scan.h"
 #include "utils/shortest_path.h"
 #include "utils/source_and_edge.h"
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
-#include <queue>
-#include <unordered_map>
+#include <limits>
+#include <vector>
 
 using type_num = Edge::type_num;
 
+/**
+ * Get the edges along the path to @a dest_vertex, from the edge used to
+ * reach each vertex, indexed by vertex.
+ */
 static type_vec_path
 get_path_from_predecessors(type_num start_vertex, type_num dest_vertex,
-  const std::unordered_map<type_num, SourceAndEdge>& map_path_predecessor) {
+  const std::vector<SourceAndEdge>& predecessors) {
   type_vec_path path;
 
-  type_num predecessor = dest_vertex;
-  while (predecessor != start_vertex) {
-    const auto iter = map_path_predecessor.find(predecessor);
-    if (iter == map_path_predecessor.end()) {
-      // This is normal if there is no path to this vertex.
-      /*
-      std::cerr << "get_path_from_predecessors(): predecessor not found for
-      vertex:"
-        << predecessor
-        << ", start_vertex=" << start_vertex << ", dest_vertex=" << dest_vertex
-      << std::endl;
-      */
-      break;
+  type_num v = dest_vertex;
+  while (v != start_vertex) {
+    const auto& predecessor = predecessors[v];
+    path.emplace_back(predecessor);
+    v = predecessor.source_;
+  }
+
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+// The depth of a vertex that has not been reached.
+constexpr type_num BFS_DEPTH_UNREACHED = std::numeric_limits<type_num>::max();
+
+/**
+ * The incoming edges of each vertex, for the bottom-up steps of
+ * bfs_compute(), which look for a parent of each unvisited vertex, instead of
+ * looking for the children of each vertex in the frontier.
+ *
+ * Like bfs_compute(), this ignores zero-length edges, so it must be rebuilt
+ * if the graph's edges change to or from zero length.
+ */
+class BfsReverseGraph {
+public:
+  BfsReverseGraph() {}
+
+  /**
+   * @tparam T_Graph For instance, type_vec_nodes or CsrGraph.
+   */
+  template <typename T_Graph>
+  explicit BfsReverseGraph(const T_Graph& vertices) {
+    const auto vertices_count = vertices.size();
+
+    // Count the incoming edges of each vertex,
+    // then use the counts as the offsets of each vertex's incoming edges:
+    offsets_.assign(vertices_count + 1, 0);
+    for (type_num u = 0; u < vertices_count; ++u) {
+      for (const auto& edge : vertices[u].edges_) {
+        if (edge.length_ != 0) {
+          ++offsets_[edge.destination_vertex_ + 1];
+        }
+      }
     }
 
-    path.emplace_back(iter->second);
+    for (type_num v = 0; v < vertices_count; ++v) {
+      offsets_[v + 1] += offsets_[v];
+    }
 
-    if (predecessor == iter->second.edge_) {
-      std::cerr << "get_path_from_predecessors(): avoiding infinite loop."
-                << std::endl;
-      break;
+    sources_.resize(offsets_.back());
+    auto next = offsets_;
+    for (type_num u = 0; u < vertices_count; ++u) {
+      const auto& vertex = vertices[u];
+      const auto& edges = vertex.edges_;
+      const auto edges_count = edges.size();
+      for (type_num e = 0; e < edges_count; ++e) {
+        const auto& edge = edges[e];
+        if (edge.length_ != 0) {
+          sources_[next[edge.destination_vertex_]++] = SourceAndEdge(u, e);
+        }
+      }
     }
+  }
 
-    predecessor = iter->second.source_;
+  /**
+   * The number of vertices.
+   */
+  std::size_t
+  size() const {
+    return offsets_.empty() ? 0 : offsets_.size() - 1;
   }
 
-  // path.emplace_back(start_vertex, 0);
+  // The incoming edges of vertex v are at sources_[offsets_[v]] up to
+  // sources_[offsets_[v + 1]], each with the edge's index in its source
+  // vertex's edges, so bfs_compute() can record it as the predecessor.
+  std::vector<std::size_t> offsets_;
+  std::vector<SourceAndEdge> sources_;
+};
 
-  std::reverse(path.begin(), path.end());
-  return path;
-}
+/**
+ * The arrays used by bfs_compute(), which can be reused by many calls,
+ * so repeated searches don't allocate any memory.
+ */
+class BfsWorkspace {
+public:
+  BfsWorkspace() : edges_inspected_(0), bottom_up_steps_(0) {}
 
-bool
-bfs_compute_path(const type_vec_nodes& vertices, type_num start_vertex,
-  type_num dest_vertex, type_vec_path& path) {
-  type_vec_path result;
+  /**
+   * Forget the results of the previous search.
+   */
+  void
+  start(std::size_t vertices_count) {
+    depths_.assign(vertices_count, BFS_DEPTH_UNREACHED);
+    predecessors_.resize(vertices_count);
 
-  const auto vertices_size = vertices.size();
+    const auto words_count = (vertices_count + 63) / 64;
+    visited_.assign(words_count, 0);
+    frontier_bitmap_.assign(words_count, 0);
+    next_frontier_bitmap_.assign(words_count, 0);
 
-  if (start_vertex >= vertices_size) {
-    std::cerr << "start vertex not found in vertices: " << start_vertex
-              << std::endl;
-    path = result;
-    return false;
+    frontier_.clear();
+    next_frontier_.clear();
+
+    edges_inspected_ = 0;
+    bottom_up_steps_ = 0;
   }
 
-  if (dest_vertex >= vertices_size) {
-    std::cerr << "end vertex not found in vertices: " << dest_vertex
-              << std::endl;
-    path = result;
-    return false;
+  /**
+   * Whether there is a path to the vertex.
+   */
+  bool
+  is_reached(type_num v) const {
+    return depths_[v] != BFS_DEPTH_UNREACHED;
+  }
+
+  /**
+   * The edges along the path with the fewest edges to the vertex,
+   * or an empty path if there is no path.
+   */
+  type_vec_path
+  get_path(type_num start_vertex, type_num v) const {
+    if (!is_reached(v)) {
+      return type_vec_path();
+    }
+
+    return get_path_from_predecessors(start_vertex, v, predecessors_);
   }
 
-  std::vector<bool> discovered(vertices_size);
-  std::unordered_map<type_num, SourceAndEdge> predecessors;
+  static bool
+  get_bit(const std::vector<std::uint64_t>& bitmap, type_num v) {
+    return bitmap[v / 64] & (std::uint64_t(1) << (v % 64));
+  }
+
+  static void
+  set_bit(std::vector<std::uint64_t>& bitmap, type_num v) {
+    bitmap[v / 64] |= std::uint64_t(1) << (v % 64);
+  }
 
-  std::queue<type_num> queue;
-  queue.emplace(start_vertex);
-  discovered[start_vertex] = true;
+  void
+  set_depth(type_num v, type_num depth, const SourceAndEdge& predecessor) {
+    depths_[v] = depth;
+    predecessors_[v] = predecessor;
+    set_bit(visited_, v);
+  }
 
-  bool found = false;
+  // The number of edges from the start vertex, or BFS_DEPTH_UNREACHED.
+  std::vector<type_num> depths_;
 
-  while (!queue.empty()) {
-    const auto i = queue.front();
-    queue.pop();
-    const auto& vertex = vertices[i];
+  // The edge used to reach each vertex. Only valid for reached vertices,
+  // other than the start vertex.
+  std::vector<SourceAndEdge> predecessors_;
 
-    if (i == dest_vertex) {
-      found = true;
-      break;
-    }
+  // A bit per vertex, so checking whether a vertex has been visited reads
+  // much less memory than checking its depth.
+  std::vector<std::uint64_t> visited_;
 
+  // The current and next levels, as lists of vertices for top-down steps,
+  // or as bitmaps for bottom-up steps.
+  std::vector<type_num> frontier_;
+  std::vector<type_num> next_frontier_;
+  std::vector<std::uint64_t> frontier_bitmap_;
+  std::vector<std::uint64_t> next_frontier_bitmap_;
+
+  // Statistics about the last search, for benchmarks:
+  std::size_t edges_inspected_;
+  std::size_t bottom_up_steps_;
+};
+
+// bfs_compute() switches to bottom-up steps when the frontier's edges are
+// more than 1/BFS_TOP_DOWN_ALPHA of the unvisited vertices' edges,
+// and back to top-down steps when the frontier has fewer than
+// 1/BFS_BOTTOM_UP_BETA of the vertices. These are the values suggested by
+// Beamer et al., in "Direction-Optimizing Breadth-First Search".
+constexpr std::size_t BFS_TOP_DOWN_ALPHA = 14;
+constexpr std::size_t BFS_BOTTOM_UP_BETA = 24;
+
+/**
+ * Find the vertices of the next level, by checking the edges of each vertex
+ * in the frontier.
+ * @result The number of edges of the vertices in the next level.
+ */
+template <typename T_Graph>
+std::size_t
+bfs_step_top_down(
+  const T_Graph& vertices, type_num depth, BfsWorkspace& workspace) {
+  std::size_t next_edges_count = 0;
+  for (const auto u : workspace.frontier_) {
+    const auto& vertex = vertices[u];
     const auto& edges = vertex.edges_;
     const auto edges_count = edges.size();
+    workspace.edges_inspected_ += edges_count;
     for (type_num e = 0; e < edges_count; ++e) {
       const auto& edge = edges[e];
 
@@ -97,25 +219,225 @@ bfs_compute_path(const type_vec_nodes& vertices, type_num start_vertex,
         continue;
       }
 
-      const auto edge_dest = edge.destination_vertex_;
-      if (discovered[edge_dest])
+      const type_num v = edge.destination_vertex_;
+      if (BfsWorkspace::get_bit(workspace.visited_, v)) {
         continue;
+      }
+
+      workspace.set_depth(v, depth, SourceAndEdge(u, e));
+      workspace.next_frontier_.emplace_back(v);
+      next_edges_count += vertices[v].edges_.size();
+    }
+  }
+
+  return next_edges_count;
+}
+
+/**
+ * Find the vertices of the next level, by checking the incoming edges of each
+ * unvisited vertex, until one of them comes from the frontier.
+ * When most vertices are in the frontier, this finds each vertex's parent
+ * after checking only a few of its edges, while a top-down step would check
+ * every edge of every vertex in the frontier.
+ * @result The number of vertices in the next level.
+ */
+template <typename T_Graph>
+std::size_t
+bfs_step_bottom_up(const T_Graph& vertices,
+  const BfsReverseGraph& reverse_graph, type_num depth,
+  BfsWorkspace& workspace, std::size_t& next_edges_count) {
+  const auto vertices_count = reverse_graph.size();
+  auto& next_frontier_bitmap = workspace.next_frontier_bitmap_;
+  std::fill(next_frontier_bitmap.begin(), next_frontier_bitmap.end(), 0);
+
+  std::size_t next_count = 0;
+  const auto words_count = workspace.visited_.size();
+  for (std::size_t w = 0; w < words_count; ++w) {
+    // Skip 64 visited vertices at a time:
+    auto unvisited = ~workspace.visited_[w];
+    while (unvisited) {
+      const type_num v = w * 64 + count_trailing_zeros(unvisited);
+      unvisited &= unvisited - 1;
+      if (v >= vertices_count) {
+        break;
+      }
+
+      const auto end = reverse_graph.offsets_[v + 1];
+      for (auto i = reverse_graph.offsets_[v]; i < end; ++i) {
+        ++workspace.edges_inspected_;
+        const auto& source = reverse_graph.sources_[i];
+        if (BfsWorkspace::get_bit(workspace.frontier_bitmap_, source.source_)) {
+          workspace.set_depth(v, depth, source);
+          BfsWorkspace::set_bit(next_frontier_bitmap, v);
+          ++next_count;
+          next_edges_count += vertices[v].edges_.size();
+          break;
+        }
+      }
+    }
+  }
+
+  return next_count;
+}
+
+/**
+ * Calculate the number of edges on the paths with the fewest edges from
+ * @a start_vertex, leaving the depths and predecessors in the
+ * @a workspace. This ignores zero-length edges, so it can be used on the
+ * residual graphs of the max-flow algorithms.
+ *
+ * This visits one level at a time, keeping each level in a dense array,
+ * and uses a bitmap to check whether a vertex has been visited.
+ *
+ * If @a reverse_graph is not null, this is a direction-optimizing BFS:
+ * When the frontier's edges are a large part of the remaining edges, which
+ * happens after a few levels in graphs with a low diameter, it switches to
+ * bottom-up steps, which look for a parent of each unvisited vertex instead.
+ * Those can stop at the first parent found, so they check far fewer edges.
+ * When the frontier is small again, it switches back to top-down steps.
+ *
+ * @param reverse_graph The incoming edges of the same graph, or nullptr to
+ * always use top-down steps.
+ * @param stop_at_end Stop after the level that reaches @a end_vertex,
+ * instead of visiting all reachable vertices.
+ * @result false if the start or end vertex is not in the graph.
+ *
+ * @tparam T_Graph For instance, type_vec_nodes or CsrGraph.
+ */
+template <typename T_Graph>
+bool
+bfs_compute(const T_Graph& vertices, const BfsReverseGraph* reverse_graph,
+  type_num start_vertex, type_num end_vertex, bool stop_at_end,
+  BfsWorkspace& workspace) {
+  const auto vertices_count = vertices.size();
+
+  if (start_vertex >= vertices_count) {
+    std::cerr << "start vertex not found in vertices: " << start_vertex
+              << std::endl;
+    return false;
+  }
+
+  if (end_vertex >= vertices_count) {
+    std::cerr << "end vertex not found in vertices: " << end_vertex
+              << std::endl;
+    return false;
+  }
 
-      discovered[edge_dest] = true;
-      queue.emplace(edge_dest);
+  if (reverse_graph && reverse_graph->size() != vertices_count) {
+    std::cerr << "bfs_compute(): the reverse graph is for a different graph."
+              << std::endl;
+    return false;
+  }
 
-      // std::cout << "predecessor of " << edge_dest << " is " << i <<
-      // std::endl;
-      predecessors[edge_dest] = SourceAndEdge(i, e);
+  workspace.start(vertices_count);
+  workspace.set_depth(start_vertex, 0, SourceAndEdge());
+  workspace.frontier_.emplace_back(start_vertex);
+
+  // The number of vertices, and edges, in the frontier,
+  // and the number of edges of unvisited vertices:
+  std::size_t frontier_count = 1;
+  std::size_t frontier_edges_count = vertices[start_vertex].edges_.size();
+  std::size_t unvisited_edges_count =
+    reverse_graph ? reverse_graph->sources_.size() : 0;
+
+  bool bottom_up = false;
+  type_num depth = 0;
+  while (frontier_count != 0) {
+    if (stop_at_end && workspace.is_reached(end_vertex)) {
+      break;
+    }
+
+    ++depth;
+
+    if (reverse_graph) {
+      unvisited_edges_count -=
+        std::min(unvisited_edges_count, frontier_edges_count);
+
+      if (!bottom_up &&
+          frontier_edges_count > unvisited_edges_count / BFS_TOP_DOWN_ALPHA) {
+        // Switch to bottom-up steps:
+        bottom_up = true;
+        std::fill(workspace.frontier_bitmap_.begin(),
+          workspace.frontier_bitmap_.end(), 0);
+        for (const auto v : workspace.frontier_) {
+          BfsWorkspace::set_bit(workspace.frontier_bitmap_, v);
+        }
+      } else if (bottom_up &&
+                 frontier_count < vertices_count / BFS_BOTTOM_UP_BETA) {
+        // Switch back to top-down steps:
+        bottom_up = false;
+        workspace.frontier_.clear();
+        const auto words_count = workspace.frontier_bitmap_.size();
+        for (std::size_t w = 0; w < words_count; ++w) {
+          auto bits = workspace.frontier_bitmap_[w];
+          while (bits) {
+            workspace.frontier_.emplace_back(
+              w * 64 + count_trailing_zeros(bits));
+            bits &= bits - 1;
+          }
+        }
+      }
+    }
+
+    frontier_edges_count = 0;
+    if (bottom_up) {
+      ++workspace.bottom_up_steps_;
+      frontier_count = bfs_step_bottom_up(
+        vertices, *reverse_graph, depth, workspace, frontier_edges_count);
+      std::swap(workspace.frontier_bitmap_, workspace.next_frontier_bitmap_);
+    } else {
+      workspace.next_frontier_.clear();
+      frontier_edges_count = bfs_step_top_down(vertices, depth, workspace);
+      std::swap(workspace.frontier_, workspace.next_frontier_);
+      frontier_count = workspace.frontier_.size();
     }
   }
 
-  if (found)
-    result =
-      get_path_from_predecessors(start_vertex, dest_vertex, predecessors);
+  return true;
+}
+
+/**
+ * Like bfs_compute(), always using top-down steps.
+ */
+template <typename T_Graph>
+bool
+bfs_compute(const T_Graph& vertices, type_num start_vertex,
+  type_num end_vertex, bool stop_at_end, BfsWorkspace& workspace) {
+  return bfs_compute(
+    vertices, nullptr, start_vertex, end_vertex, stop_at_end, workspace);
+}
 
-  path = result;
-  return found;
+/**
+ * Get the path with the fewest edges from @a start_vertex to
+ * @a dest_vertex, ignoring zero-length edges.
+ *
+ * @tparam T_Graph For instance, type_vec_nodes or CsrGraph.
+ */
+template <typename T_Graph>
+bool
+bfs_compute_path(const T_Graph& vertices, type_num start_vertex,
+  type_num dest_vertex, type_vec_path& path, BfsWorkspace& workspace) {
+  path.clear();
+
+  if (!bfs_compute(vertices, start_vertex, dest_vertex, true /* stop_at_end */,
+        workspace)) {
+    return false;
+  }
+
+  if (!workspace.is_reached(dest_vertex)) {
+    return false;
+  }
+
+  path = workspace.get_path(start_vertex, dest_vertex);
+  return true;
+}
+
+template <typename T_Graph>
+bool
+bfs_compute_path(const T_Graph& vertices, type_num start_vertex,
+  type_num dest_vertex, type_vec_path& path) {
+  BfsWorkspace workspace;
+  return bfs_compute_path(vertices, start_vertex, dest_vertex, path, workspace);
 }
 
 #endif // MURRAYC_ALGORITHMS_EXPERIMENTS_BFS
@@ -1,8 +1,11 @@
 #include "breadth_first_search.h"
+#include "utils/csr_graph.h"
 #include "utils/example_graphs.h"
+#include "utils/random_graphs.h"
 #include <cassert>
 #include <cstdlib>
 #include <iostream>
+#include <queue>
 
 static void
 test_small(type_num source_vertex_num, type_num dest_vertex_num,
@@ -28,6 +31,122 @@ test_small(type_num source_vertex_num, type_num dest_vertex_num,
   assert(path_vertices == expected_path);
 }
 
+static void
+test_small_csr(type_num source_vertex_num, type_num dest_vertex_num,
+  const std::vector<type_num>& expected_path) {
+  const CsrGraph graph(EXAMPLE_GRAPH_SMALL);
+
+  std::vector<type_num> path_vertices;
+  type_vec_path path;
+  if (bfs_compute_path(graph, source_vertex_num, dest_vertex_num, path)) {
+    path_vertices = get_vertices_for_path(source_vertex_num, path, graph);
+  }
+
+  assert(path_vertices == expected_path);
+}
+
+/**
+ * A simple BFS, with a queue, to check bfs_compute() against.
+ */
+static std::vector<type_num>
+calculate_depths(const type_vec_nodes& vertices, type_num start_vertex) {
+  std::vector<type_num> result(vertices.size(), BFS_DEPTH_UNREACHED);
+  std::queue<type_num> queue;
+  queue.emplace(start_vertex);
+  result[start_vertex] = 0;
+
+  while (!queue.empty()) {
+    const auto u = queue.front();
+    queue.pop();
+    for (const auto& edge : vertices[u].edges_) {
+      const auto v = edge.destination_vertex_;
+      if (edge.length_ != 0 && result[v] == BFS_DEPTH_UNREACHED) {
+        result[v] = result[u] + 1;
+        queue.emplace(v);
+      }
+    }
+  }
+
+  return result;
+}
+
+/**
+ * Check the depths, and that each vertex's predecessor is an edge from a
+ * vertex in the previous level.
+ */
+template <typename T_Graph>
+static void
+check_workspace(const T_Graph& vertices, type_num start_vertex,
+  const std::vector<type_num>& expected_depths,
+  const BfsWorkspace& workspace) {
+  assert(workspace.depths_ == expected_depths);
+
+  const auto vertices_count = vertices.size();
+  for (type_num v = 0; v < vertices_count; ++v) {
+    if (v == start_vertex || !workspace.is_reached(v)) {
+      continue;
+    }
+
+    const auto& predecessor = workspace.predecessors_[v];
+    assert(workspace.depths_[predecessor.source_] + 1 == workspace.depths_[v]);
+
+    const auto& source = vertices[predecessor.source_];
+    const auto& edge = source.edges_[predecessor.edge_];
+    assert(edge.destination_vertex_ == v);
+    assert(edge.length_ != 0);
+
+    const auto path = workspace.get_path(start_vertex, v);
+    assert(path.size() == workspace.depths_[v]);
+  }
+}
+
+static void
+test_random(type_num vertices_count, type_num edges_count) {
+  auto vertices = make_random_graph(vertices_count, edges_count, 10);
+
+  // Some zero-length edges, which should be ignored:
+  for (auto& vertex : vertices) {
+    for (auto& edge : vertex.edges_) {
+      if (edge.length_ == 1) {
+        edge.length_ = 0;
+      }
+    }
+  }
+
+  const CsrGraph csr_graph(vertices);
+  const BfsReverseGraph reverse_graph(vertices);
+
+  BfsWorkspace workspace;
+  for (const type_num start_vertex : {0, 1, 7}) {
+    const auto expected = calculate_depths(vertices, start_vertex);
+
+    assert(bfs_compute(vertices, start_vertex, 0, false, workspace));
+    check_workspace(vertices, start_vertex, expected, workspace);
+    assert(workspace.bottom_up_steps_ == 0);
+
+    assert(bfs_compute(
+      vertices, &reverse_graph, start_vertex, 0, false, workspace));
+    check_workspace(vertices, start_vertex, expected, workspace);
+
+    assert(bfs_compute(
+      csr_graph, &reverse_graph, start_vertex, 0, false, workspace));
+    check_workspace(csr_graph, start_vertex, expected, workspace);
+
+    // The shortest path to the last vertex:
+    const auto end_vertex = vertices_count - 1;
+    type_vec_path path;
+    const auto found =
+      bfs_compute_path(vertices, start_vertex, end_vertex, path, workspace);
+    assert(found == (expected[end_vertex] != BFS_DEPTH_UNREACHED));
+    if (found) {
+      assert(path.size() == expected[end_vertex]);
+      const auto path_vertices =
+        get_vertices_for_path(start_vertex, path, vertices);
+      assert(path_vertices.back() == end_vertex);
+    }
+  }
+}
+
 int
 main() {
   /*
@@ -50,5 +169,16 @@ main() {
   test_small(2, 3, {2, 3});
   test_small(0, 3, {0, 1, 3});
 
+  test_small_csr(0, 0, {0});
+  test_small_csr(0, 1, {0, 1});
+  test_small_csr(1, 3, {1, 3});
+  test_small_csr(2, 3, {2, 3});
+  test_small_csr(0, 3, {0, 1, 3});
+
+  // With enough edges per vertex to use bottom-up steps:
+  test_random(1000, 16000);
+  test_random(1000, 1500);
+  test_random(3000, 3000);
+
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,88 @@
+#include "contraction_hierarchies.h"
+#include "utils/benchmark.h"
+#include "utils/random_graphs.h"
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+
+/**
+ * Usage: murrayc_contraction_hierarchies_benchmark [grid_width]
+ * [queries_count]
+ *
+ * This uses a grid graph, which, like a road network, has a large diameter.
+ */
+int
+main(int argc, char** argv) {
+  const auto width = benchmark_get_arg<type_num>(argc, argv, 1, 100);
+  const auto queries_count = benchmark_get_arg<type_num>(argc, argv, 2, 1000);
+  const auto vertices_count = width * width;
+  std::cout << "vertices: " << vertices_count << ", queries: " << queries_count
+            << std::endl;
+
+  const auto vertices = make_random_grid_graph(width, width, 1000);
+  const CsrGraph graph(vertices);
+
+  std::unique_ptr<ContractionHierarchy> hierarchy;
+  const auto preprocessing_seconds = benchmark_seconds(
+    [&] { hierarchy = std::make_unique<ContractionHierarchy>(vertices); });
+
+  const auto graph_size = sizeof(std::size_t) * graph.offsets_.size() +
+                          sizeof(type_num) * graph.destinations_.size() +
+                          sizeof(type_length) * graph.lengths_.size();
+  std::cout << "preprocessing: " << preprocessing_seconds << "s" << std::endl
+            << "edges: " << graph.edges_count()
+            << ", with shortcuts: " << hierarchy->edges_count() << std::endl
+            << "size: " << graph_size << " bytes (CsrGraph), "
+            << hierarchy->get_memory_size() << " bytes (hierarchy)"
+            << std::endl;
+
+  std::mt19937 generator(1);
+  std::uniform_int_distribution<type_num> vertex_distribution(
+    0, vertices_count - 1);
+  std::vector<std::pair<type_num, type_num>> queries;
+  for (type_num i = 0; i < queries_count; ++i) {
+    queries.emplace_back(
+      vertex_distribution(generator), vertex_distribution(generator));
+  }
+
+  // Sum the lengths, so we can check that both versions give the same
+  // results, and so the compiler can't skip the work.
+  type_length checksum_dijkstra = 0;
+  DijkstraWorkspace workspace;
+  const auto dijkstra_seconds = benchmark_seconds([&] {
+    for (const auto& query : queries) {
+      checksum_dijkstra += dijkstra_compute_shortest_path(
+        graph, query.first, query.second, workspace)
+                             .length_;
+    }
+  });
+
+  std::cout << "dijkstra: " << dijkstra_seconds * 1000000 / queries.size()
+            << " microseconds per query" << std::endl;
+
+  type_length checksum_ch = 0;
+  std::size_t settled_count = 0;
+  BidirectionalDijkstraWorkspace ch_workspace;
+  const auto ch_seconds = benchmark_seconds([&] {
+    for (const auto& query : queries) {
+      checksum_ch += ch_compute_shortest_path(
+        *hierarchy, query.first, query.second, ch_workspace)
+                       .length_;
+      settled_count += ch_workspace.settled_count_;
+    }
+  });
+
+  std::cout << "contraction hierarchy: "
+            << ch_seconds * 1000000 / queries.size()
+            << " microseconds per query, "
+            << static_cast<double>(settled_count) / queries.size()
+            << " vertices settled per query" << std::endl;
+
+  if (checksum_dijkstra != checksum_ch) {
+    std::cerr << "The results were not the same." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
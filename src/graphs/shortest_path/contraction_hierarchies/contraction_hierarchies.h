@@ -0,0 +1,572 @@
+#ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_CONTRACTION_HIERARCHIES
+#define MURRAYC_ALGORITHMS_EXPERIMENTS_CONTRACTION_HIERARCHIES
+
+#include "shortest_path/bidirectional_dijkstra/bidirectional_dijkstra.h"
+#include "shortest_path/dijkstra/dijkstra.h"
+#include "utils/csr_graph.h"
+#include "utils/shortest_path.h"
+#include "utils/vertex.h"
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <vector>
+
+/**
+ * Contracts the vertices of a graph, one at a time, for ContractionHierarchy.
+ *
+ * Contracting a vertex v removes it from the graph, adding a shortcut edge
+ * from u to w, for each pair of edges u->v and v->w, unless a "witness"
+ * search finds another path from u to w that is no longer than the path via
+ * v. Each shortcut remembers v, so the path can be unpacked later.
+ */
+class ContractionHierarchyBuilder {
+public:
+  /**
+   * An edge, or shortcut, to or from a vertex, while building the hierarchy.
+   */
+  class Arc {
+  public:
+    Arc(type_num vertex, type_length length, type_num middle)
+    : vertex_(vertex), length_(length), middle_(middle) {}
+
+    // The vertex at the other end of the edge.
+    type_num vertex_;
+    type_length length_;
+
+    // The contracted vertex that this shortcut skips,
+    // or INVALID_PREDECESSOR if this is an edge of the original graph.
+    type_num middle_;
+  };
+
+  using type_arcs = std::vector<Arc>;
+
+  /**
+   * @param witness_settled_limit The maximum number of vertices that each
+   * witness search may settle. If a search gives up before finding a
+   * witness, we add the shortcut anyway, which is never wrong, but makes
+   * the hierarchy bigger.
+   */
+  template <typename T_Edge>
+  ContractionHierarchyBuilder(const std::vector<BasicVertex<T_Edge>>& vertices,
+    std::size_t witness_settled_limit)
+  : out_(vertices.size()),
+    in_(vertices.size()),
+    contracted_(vertices.size(), false),
+    contracted_neighbours_(vertices.size(), 0),
+    witness_settled_limit_(witness_settled_limit),
+    shortcuts_count_(0) {
+    const auto vertices_count = vertices.size();
+    for (type_num u = 0; u < vertices_count; ++u) {
+      for (const auto& edge : vertices[u].edges_) {
+        const type_num w = edge.destination_vertex_;
+
+        // A loop can never be part of a shortest path:
+        if (w == u) {
+          continue;
+        }
+
+        add_arc(u, w, edge.length_, INVALID_PREDECESSOR);
+      }
+    }
+  }
+
+  /**
+   * Contract all the vertices, least important first.
+   *
+   * The importance of a vertex is mostly its "edge difference": the number of
+   * shortcuts that contracting it would add, minus the number of edges that
+   * it would remove. We also add the number of neighbours that have already
+   * been contracted, so the contracted vertices are spread evenly across the
+   * graph.
+   * Contracting a vertex changes the importance of its neighbours, so we only
+   * recalculate the importance of a vertex when it reaches the top of the
+   * priority queue, putting it back if it is no longer the least important.
+   *
+   * @result The rank of each vertex, which is the order in which it was
+   * contracted.
+   */
+  std::vector<type_num>
+  contract_all() {
+    const auto vertices_count = out_.size();
+    std::vector<type_num> ranks(vertices_count);
+
+    using type_entry = std::pair<long, type_num>;
+    std::priority_queue<type_entry, std::vector<type_entry>,
+      std::greater<type_entry>>
+      queue;
+    for (type_num v = 0; v < vertices_count; ++v) {
+      queue.emplace(get_importance(v), v);
+    }
+
+    type_num rank = 0;
+    while (!queue.empty()) {
+      const auto v = queue.top().second;
+      queue.pop();
+
+      const auto importance = get_importance(v);
+      if (!queue.empty() && importance > queue.top().first) {
+        queue.emplace(importance, v);
+        continue;
+      }
+
+      contract(v, false /* simulate */);
+      contracted_[v] = true;
+      ranks[v] = rank++;
+
+      for (const auto& arc : out_[v]) {
+        ++contracted_neighbours_[arc.vertex_];
+      }
+
+      for (const auto& arc : in_[v]) {
+        ++contracted_neighbours_[arc.vertex_];
+      }
+    }
+
+    return ranks;
+  }
+
+  // The edges from each vertex, including shortcuts,
+  // and including edges to vertices that have been contracted.
+  std::vector<type_arcs> out_;
+
+  // The same edges, to each vertex.
+  std::vector<type_arcs> in_;
+
+  std::size_t
+  get_shortcuts_count() const {
+    return shortcuts_count_;
+  }
+
+private:
+  /**
+   * Add an edge, or make an existing edge shorter.
+   *
+   * @result true if a new edge was added.
+   */
+  bool
+  add_arc(type_num u, type_num w, type_length length, type_num middle) {
+    for (auto& arc : out_[u]) {
+      if (arc.vertex_ != w) {
+        continue;
+      }
+
+      if (length < arc.length_) {
+        arc.length_ = length;
+        arc.middle_ = middle;
+
+        for (auto& in_arc : in_[w]) {
+          if (in_arc.vertex_ == u) {
+            in_arc.length_ = length;
+            in_arc.middle_ = middle;
+            break;
+          }
+        }
+      }
+
+      return false;
+    }
+
+    out_[u].emplace_back(w, length, middle);
+    in_[w].emplace_back(u, length, middle);
+    return true;
+  }
+
+  /**
+   * Find the shortest paths from @a start_vertex, up to @a max_length,
+   * that don't go through @a excluded_vertex or any contracted vertex,
+   * leaving the results in workspace_.
+   */
+  void
+  witness_search(
+    type_num start_vertex, type_num excluded_vertex, type_length max_length) {
+    workspace_.start(out_.size());
+    workspace_.set_length(start_vertex, 0, start_vertex);
+
+    auto& queue = workspace_.queue_;
+    queue.push(start_vertex, 0);
+
+    std::size_t settled_count = 0;
+    while (!queue.empty()) {
+      const auto best = queue.pop();
+      const auto best_vertex = best.vertex_;
+      if (best.total_length_ > workspace_.distances_[best_vertex]) {
+        // A stale entry. See dijkstra_compute().
+        continue;
+      }
+
+      if (best.total_length_ > max_length ||
+          ++settled_count > witness_settled_limit_) {
+        break;
+      }
+
+      for (const auto& arc : out_[best_vertex]) {
+        const auto v = arc.vertex_;
+        if (v == excluded_vertex || contracted_[v]) {
+          continue;
+        }
+
+        const auto total_length = best.total_length_ + arc.length_;
+        if (workspace_.is_reached(v) &&
+            total_length >= workspace_.distances_[v]) {
+          continue;
+        }
+
+        workspace_.set_length(v, total_length, best_vertex);
+        queue.push(v, total_length);
+      }
+    }
+  }
+
+  /**
+   * Add the shortcuts needed to contract the vertex,
+   * or just count them if @a simulate is true.
+   *
+   * @result The number of shortcuts.
+   */
+  std::size_t
+  contract(type_num v, bool simulate) {
+    std::size_t result = 0;
+
+    for (const auto& in_arc : in_[v]) {
+      const auto u = in_arc.vertex_;
+      if (contracted_[u]) {
+        continue;
+      }
+
+      // We only need to search as far as the longest path via v:
+      type_length max_length = -1;
+      for (const auto& out_arc : out_[v]) {
+        const auto w = out_arc.vertex_;
+        if (!contracted_[w] && w != u) {
+          max_length = std::max(max_length, in_arc.length_ + out_arc.length_);
+        }
+      }
+
+      if (max_length < 0) {
+        continue;
+      }
+
+      witness_search(u, v, max_length);
+
+      for (const auto& out_arc : out_[v]) {
+        const auto w = out_arc.vertex_;
+        if (contracted_[w] || w == u) {
+          continue;
+        }
+
+        const auto length_via_v = in_arc.length_ + out_arc.length_;
+        if (workspace_.is_reached(w) &&
+            workspace_.distances_[w] <= length_via_v) {
+          // There is a witness path, which is no longer.
+          continue;
+        }
+
+        ++result;
+        if (!simulate && add_arc(u, w, length_via_v, v)) {
+          ++shortcuts_count_;
+        }
+      }
+    }
+
+    return result;
+  }
+
+  long
+  get_importance(type_num v) {
+    long removed_edges_count = 0;
+    for (const auto& arc : out_[v]) {
+      if (!contracted_[arc.vertex_]) {
+        ++removed_edges_count;
+      }
+    }
+
+    for (const auto& arc : in_[v]) {
+      if (!contracted_[arc.vertex_]) {
+        ++removed_edges_count;
+      }
+    }
+
+    const auto shortcuts_count = static_cast<long>(contract(v, true));
+    return shortcuts_count - removed_edges_count + contracted_neighbours_[v];
+  }
+
+  std::vector<bool> contracted_;
+  std::vector<long> contracted_neighbours_;
+
+  std::size_t witness_settled_limit_;
+  std::size_t shortcuts_count_;
+
+  DijkstraWorkspace workspace_;
+};
+
+/**
+ * A Contraction Hierarchy, for answering many shortest path queries on the
+ * same graph, without searching most of the graph for each query.
+ *
+ * The vertices are ranked by the order in which they were contracted,
+ * by ContractionHierarchyBuilder. Every shortest path then has an
+ * equally short path, using the original edges and the shortcuts,
+ * that only goes up in rank, and then only down in rank.
+ * So a query only needs a forward search from the start vertex, using only
+ * edges that go up, and a backward search from the end vertex, using only
+ * edges that come down, and each of those searches only sees a small part of
+ * the graph.
+ *
+ * The edges are stored as two CsrGraphs, along with the vertex that each
+ * shortcut skips, so the shortcuts can be unpacked into the original path.
+ */
+class ContractionHierarchy {
+public:
+  using type_csr_graph = BasicCsrGraph<type_num, type_length>;
+
+  /**
+   * Contract the graph.
+   * This takes much longer than a query, but only needs to be done once.
+   *
+   * @param witness_settled_limit See ContractionHierarchyBuilder.
+   */
+  template <typename T_Edge>
+  explicit ContractionHierarchy(
+    const std::vector<BasicVertex<T_Edge>>& vertices,
+    std::size_t witness_settled_limit = 500) {
+    ContractionHierarchyBuilder builder(vertices, witness_settled_limit);
+    ranks_ = builder.contract_all();
+    shortcuts_count_ = builder.get_shortcuts_count();
+
+    const auto vertices_count = vertices.size();
+    type_vec_nodes upward(vertices_count);
+    type_vec_nodes downward(vertices_count);
+    std::vector<std::vector<type_num>> upward_middles(vertices_count);
+    std::vector<std::vector<type_num>> downward_middles(vertices_count);
+    for (type_num u = 0; u < vertices_count; ++u) {
+      for (const auto& arc : builder.out_[u]) {
+        const auto w = arc.vertex_;
+        if (ranks_[u] < ranks_[w]) {
+          upward[u].edges_.emplace_back(w, arc.length_);
+          upward_middles[u].emplace_back(arc.middle_);
+        } else {
+          downward[w].edges_.emplace_back(u, arc.length_);
+          downward_middles[w].emplace_back(arc.middle_);
+        }
+      }
+    }
+
+    upward_ = type_csr_graph(upward);
+    downward_ = type_csr_graph(downward);
+
+    // In the same order as the CsrGraphs' edges:
+    for (const auto& middles : upward_middles) {
+      upward_middles_.insert(
+        upward_middles_.end(), middles.begin(), middles.end());
+    }
+
+    for (const auto& middles : downward_middles) {
+      downward_middles_.insert(
+        downward_middles_.end(), middles.begin(), middles.end());
+    }
+  }
+
+  /**
+   * The number of vertices.
+   */
+  std::size_t
+  size() const {
+    return ranks_.size();
+  }
+
+  /**
+   * The number of edges, including shortcuts.
+   */
+  std::size_t
+  edges_count() const {
+    return upward_.edges_count() + downward_.edges_count();
+  }
+
+  std::size_t
+  get_shortcuts_count() const {
+    return shortcuts_count_;
+  }
+
+  /**
+   * The number of bytes used by the arrays.
+   */
+  std::size_t
+  get_memory_size() const {
+    return sizeof(type_num) * ranks_.size() + get_memory_size(upward_) +
+           get_memory_size(downward_) +
+           sizeof(type_num) *
+             (upward_middles_.size() + downward_middles_.size());
+  }
+
+  /**
+   * Append the vertices along the edge, or shortcut, from @a u to @a w,
+   * not including @a u, to the @a path.
+   */
+  void
+  unpack_edge(type_num u, type_num w, ShortestPath::type_path& path) const {
+    // The edge is stored with the lower-ranked vertex:
+    const auto upward = ranks_[u] < ranks_[w];
+    const auto& graph = upward ? upward_ : downward_;
+    const auto& middles = upward ? upward_middles_ : downward_middles_;
+    const auto from = upward ? u : w;
+    const auto to = upward ? w : u;
+
+    auto middle = INVALID_PREDECESSOR;
+    for (auto e = graph.offsets_[from]; e < graph.offsets_[from + 1]; ++e) {
+      if (graph.destinations_[e] == to) {
+        middle = middles[e];
+        break;
+      }
+    }
+
+    if (middle == INVALID_PREDECESSOR) {
+      path.emplace_back(w);
+      return;
+    }
+
+    unpack_edge(u, middle, path);
+    unpack_edge(middle, w, path);
+  }
+
+  // The order in which each vertex was contracted.
+  std::vector<type_num> ranks_;
+
+  // The edges that go from each vertex to a higher-ranked vertex.
+  type_csr_graph upward_;
+
+  // The edges that come to each vertex from a higher-ranked vertex,
+  // reversed, for the backward search.
+  type_csr_graph downward_;
+
+  // The vertex skipped by each shortcut, in the same order as the edges,
+  // or INVALID_PREDECESSOR for the original edges.
+  std::vector<type_num> upward_middles_;
+  std::vector<type_num> downward_middles_;
+
+private:
+  static std::size_t
+  get_memory_size(const type_csr_graph& graph) {
+    return sizeof(std::size_t) * graph.offsets_.size() +
+           sizeof(type_num) * graph.destinations_.size() +
+           sizeof(type_length) * graph.lengths_.size();
+  }
+
+  std::size_t shortcuts_count_;
+};
+
+/**
+ * Get the shortest path from @a start_vertex to @a end_vertex,
+ * with a bidirectional search that only goes up in the hierarchy.
+ *
+ * Unlike bidirectional_dijkstra_compute_shortest_path(), neither search can
+ * stop when the searches first meet, because the searches don't settle the
+ * vertices in order of their distance from the start vertex,
+ * so each search continues until its radius reaches the length of the
+ * shortest path found so far.
+ *
+ * @param workspace The arrays for the searches, reused from previous calls.
+ */
+template <typename T_Queue>
+ShortestPath
+ch_compute_shortest_path(const ContractionHierarchy& hierarchy,
+  type_num start_vertex, type_num end_vertex,
+  BasicBidirectionalDijkstraWorkspace<T_Queue>& workspace) {
+  const auto vertices_size = hierarchy.size();
+  workspace.settled_count_ = 0;
+
+  if (start_vertex >= vertices_size) {
+    std::cerr << "start vertex not found in vertices: " << start_vertex
+              << std::endl;
+    return ShortestPath();
+  }
+
+  if (end_vertex >= vertices_size) {
+    std::cerr << "end vertex not found in vertices: " << end_vertex
+              << std::endl;
+    return ShortestPath();
+  }
+
+  if (start_vertex == end_vertex) {
+    return ShortestPath(0, ShortestPath::type_path({start_vertex}));
+  }
+
+  auto& forward = workspace.forward_;
+  auto& backward = workspace.backward_;
+
+  forward.start(vertices_size);
+  forward.set_length(start_vertex, 0, start_vertex);
+  forward.queue_.push(start_vertex, 0);
+
+  backward.start(vertices_size);
+  backward.set_length(end_vertex, 0, end_vertex);
+  backward.queue_.push(end_vertex, 0);
+
+  type_length forward_radius = 0;
+  type_length backward_radius = 0;
+  type_length best_length = Edge::LENGTH_INFINITY;
+  type_num meeting_vertex = start_vertex;
+
+  bool forward_done = false;
+  bool backward_done = false;
+  bool search_forward = true;
+  while (!forward_done || !backward_done) {
+    if (search_forward ? forward_done : backward_done) {
+      search_forward = !search_forward;
+      continue;
+    }
+
+    auto& radius = search_forward ? forward_radius : backward_radius;
+    const auto settled = search_forward
+      ? bidirectional_dijkstra_settle_next(hierarchy.upward_, forward,
+          backward, radius, best_length, meeting_vertex)
+      : bidirectional_dijkstra_settle_next(hierarchy.downward_, backward,
+          forward, radius, best_length, meeting_vertex);
+    if (settled) {
+      ++workspace.settled_count_;
+    }
+
+    // No vertex that this search settles later could give a shorter path:
+    if (!settled || radius >= best_length) {
+      (search_forward ? forward_done : backward_done) = true;
+    }
+
+    search_forward = !search_forward;
+  }
+
+  if (best_length == Edge::LENGTH_INFINITY) {
+    return ShortestPath();
+  }
+
+  // The vertices, in the hierarchy, from the start vertex up to the meeting
+  // vertex, and then down to the end vertex:
+  auto hierarchy_path = get_path_vertices_from_predecessors(
+    start_vertex, meeting_vertex, forward.predecessors_);
+  const auto backward_path = get_path_vertices_from_predecessors(
+    end_vertex, meeting_vertex, backward.predecessors_);
+  if (!backward_path.empty()) {
+    hierarchy_path.insert(
+      hierarchy_path.end(), backward_path.rbegin() + 1, backward_path.rend());
+  }
+
+  if (hierarchy_path.empty()) {
+    return ShortestPath();
+  }
+
+  // Replace the shortcuts with the original edges:
+  ShortestPath::type_path path = {start_vertex};
+  for (std::size_t i = 1; i < hierarchy_path.size(); ++i) {
+    hierarchy.unpack_edge(hierarchy_path[i - 1], hierarchy_path[i], path);
+  }
+
+  return ShortestPath(best_length, std::move(path));
+}
+
+inline ShortestPath
+ch_compute_shortest_path(const ContractionHierarchy& hierarchy,
+  type_num start_vertex, type_num end_vertex) {
+  BidirectionalDijkstraWorkspace workspace;
+  return ch_compute_shortest_path(
+    hierarchy, start_vertex, end_vertex, workspace);
+}
+
+#endif // MURRAYC_ALGORITHMS_EXPERIMENTS_CONTRACTION_HIERARCHIES
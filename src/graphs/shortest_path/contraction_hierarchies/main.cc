@@ -0,0 +1,109 @@
+#include "contraction_hierarchies.h"
+#include "utils/example_graphs.h"
+#include "utils/random_graphs.h"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * Check that the path really has the length,
+ * using the shortest edge between each pair of vertices along it.
+ */
+static bool
+check_path_length(const type_vec_nodes& vertices, const ShortestPath& path) {
+  type_length length = 0;
+  for (std::size_t i = 1; i < path.path_.size(); ++i) {
+    type_length edge_length = Edge::LENGTH_INFINITY;
+    for (const auto& edge : vertices[path.path_[i - 1]].edges_) {
+      if (edge.destination_vertex_ == path.path_[i]) {
+        edge_length = std::min(edge_length, edge.length_);
+      }
+    }
+
+    if (edge_length == Edge::LENGTH_INFINITY) {
+      return false;
+    }
+
+    length += edge_length;
+  }
+
+  return length == path.length_;
+}
+
+static void
+test_compare_with_dijkstra(
+  const type_vec_nodes& vertices, std::size_t witness_settled_limit) {
+  const ContractionHierarchy hierarchy(vertices, witness_settled_limit);
+  assert(hierarchy.size() == vertices.size());
+
+  BidirectionalDijkstraWorkspace workspace;
+
+  const auto vertices_count = vertices.size();
+  for (type_num start = 0; start < vertices_count; ++start) {
+    const auto expected = dijkstra_compute_shortest_paths(vertices, start);
+    for (type_num end = 0; end < vertices_count; ++end) {
+      const auto shortest_path =
+        ch_compute_shortest_path(hierarchy, start, end, workspace);
+      assert(shortest_path.length_ == expected.get_length(end));
+
+      if (shortest_path.length_ == Edge::LENGTH_INFINITY) {
+        assert(shortest_path.path_.empty());
+      } else {
+        assert(shortest_path.path_.front() == start);
+        assert(shortest_path.path_.back() == end);
+        assert(check_path_length(vertices, shortest_path));
+      }
+    }
+  }
+}
+
+static void
+test_small() {
+  const ContractionHierarchy hierarchy(EXAMPLE_GRAPH_SMALL);
+
+  const auto shortest_path = ch_compute_shortest_path(hierarchy, 0, 3);
+  assert(shortest_path.length_ == 5);
+  assert(shortest_path.path_ == ShortestPath::type_path({0, 1, 3}));
+
+  // There is no path back to vertex 0:
+  assert(ch_compute_shortest_path(hierarchy, 3, 0).length_ ==
+         Edge::LENGTH_INFINITY);
+}
+
+static void
+test_shortcuts() {
+  // A path, 0 -> 1 -> 2 -> 3 -> 4, with no other way around,
+  // so any shortcuts must be unpacked to give the whole path.
+  const type_vec_nodes vertices = {Vertex({Edge(1, 1)}), Vertex({Edge(2, 2)}),
+    Vertex({Edge(3, 3)}), Vertex({Edge(4, 4)}), Vertex()};
+  const ContractionHierarchy hierarchy(vertices);
+
+  const auto shortest_path = ch_compute_shortest_path(hierarchy, 0, 4);
+  assert(shortest_path.length_ == 10);
+  assert(shortest_path.path_ == ShortestPath::type_path({0, 1, 2, 3, 4}));
+}
+
+int
+main() {
+  const ContractionHierarchy hierarchy(EXAMPLE_GRAPH_SMALL);
+  const auto start_vertex = 0;
+  const auto dest_vertices = {0, 1, 2, 3};
+  for (auto dest_vertex_num : dest_vertices) {
+    const auto shortest_path =
+      ch_compute_shortest_path(hierarchy, start_vertex, dest_vertex_num);
+    std::cout << "shortest path from " << start_vertex << " to "
+              << dest_vertex_num << ": " << shortest_path.length_
+              << ", path: " << shortest_path.get_path_string() << std::endl;
+  }
+
+  test_small();
+  test_shortcuts();
+  test_compare_with_dijkstra(EXAMPLE_GRAPH_SMALL, 500);
+  test_compare_with_dijkstra(make_random_graph(100, 300, 20), 500);
+  test_compare_with_dijkstra(make_random_grid_graph(10, 8, 10), 500);
+
+  // With small witness searches, which add unnecessary shortcuts:
+  test_compare_with_dijkstra(make_random_grid_graph(10, 8, 10), 2);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,63 @@
+#include "delta_stepping.h"
+#include "shortest_path/dijkstra/dijkstra.h"
+#include "utils/benchmark.h"
+#include "utils/csr_graph.h"
+#include "utils/random_graphs.h"
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+/**
+ * Usage: murrayc_delta_stepping_benchmark [vertices_count] [edges_count]
+ * [delta] [max_threads_count]
+ */
+int
+main(int argc, char** argv) {
+  const auto vertices_count =
+    benchmark_get_arg<type_num>(argc, argv, 1, 1000000);
+  const auto edges_count =
+    benchmark_get_arg<type_num>(argc, argv, 2, 10 * vertices_count);
+  const type_length max_length = 1000;
+
+  // The maximum length divided by the average number of edges per vertex:
+  const auto delta = benchmark_get_arg<type_length>(argc, argv, 3,
+    std::max<type_length>(1, max_length * vertices_count / edges_count));
+  const auto max_threads_count = benchmark_get_arg<std::size_t>(
+    argc, argv, 4, std::max(1u, std::thread::hardware_concurrency()));
+  std::cout << "vertices: " << vertices_count << ", edges: " << edges_count
+            << ", delta: " << delta << std::endl;
+
+  const CsrGraph graph(
+    make_random_graph(vertices_count, edges_count, max_length));
+
+  ShortestPaths expected;
+  const auto dijkstra_seconds = benchmark_seconds(
+    [&] { expected = dijkstra_compute_shortest_paths(graph, 0); });
+  std::cout << "dijkstra: " << dijkstra_seconds << "s" << std::endl;
+
+  double one_thread_seconds = 0;
+  for (std::size_t threads_count = 1; threads_count <= max_threads_count;
+       threads_count *= 2) {
+    ThreadPool thread_pool(threads_count);
+
+    ShortestPaths shortest_paths;
+    const auto seconds = benchmark_seconds([&] {
+      shortest_paths =
+        delta_stepping_compute_shortest_paths(graph, 0, delta, thread_pool);
+    });
+
+    if (threads_count == 1) {
+      one_thread_seconds = seconds;
+    }
+
+    std::cout << "delta-stepping, " << threads_count << " threads: " << seconds
+              << "s, speedup: " << one_thread_seconds / seconds << std::endl;
+
+    if (shortest_paths.lengths_ != expected.lengths_) {
+      std::cerr << "The results were not the same." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
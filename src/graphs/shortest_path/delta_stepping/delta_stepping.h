@@ -0,0 +1,255 @@
+#ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_DELTA_STEPPING
+#define MURRAYC_ALGORITHMS_EXPERIMENTS_DELTA_STEPPING
+
+#include "utils/shortest_path.h"
+#include "utils/thread_pool.h"
+#include "utils/vertex.h"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+using type_num = Edge::type_num;
+using type_length = Edge::type_length;
+
+/**
+ * A request, from one thread to the thread that owns a vertex,
+ * to relax the vertex's length via an edge.
+ */
+class DeltaSteppingRequest {
+public:
+  DeltaSteppingRequest(
+    type_num vertex, type_length length, type_num predecessor)
+  : vertex_(vertex), length_(length), predecessor_(predecessor) {}
+
+  type_num vertex_;
+  type_length length_;
+  type_num predecessor_;
+};
+
+/**
+ * The buckets and requests of one thread in
+ * delta_stepping_compute_shortest_paths().
+ */
+class DeltaSteppingThreadState {
+public:
+  // The vertices owned by this thread, in buckets of lengths, reused
+  // cyclically. These can contain stale entries, for vertices whose length
+  // has since been decreased into an earlier bucket.
+  std::vector<std::vector<type_num>> buckets_;
+
+  // The vertices taken from the current bucket, being processed.
+  std::vector<type_num> frontier_;
+
+  // The vertices settled in the current bucket,
+  // whose heavy edges are relaxed after the bucket is empty.
+  std::vector<type_num> settled_;
+
+  // The requests for each thread, by the thread that owns their vertex.
+  std::vector<std::vector<DeltaSteppingRequest>> outboxes_;
+};
+
+/**
+ * Get the shortest paths from @a start_vertex to all vertices, like
+ * dijkstra_compute_shortest_paths(), but sharing the work between the
+ * @a thread_pool's threads, with the delta-stepping algorithm.
+ *
+ * Instead of settling one vertex at a time, in order of length, this puts
+ * the vertices into buckets, each covering a range of @a delta lengths,
+ * and settles all the vertices in the lowest non-empty bucket at once.
+ * "Light" edges, no longer than @a delta, can put vertices back into the
+ * current bucket, so their relaxation is repeated until the bucket stays
+ * empty. "Heavy" edges can only reach later buckets, so they are relaxed only
+ * once per vertex, after the bucket is finished.
+ * A small @a delta is like Dijkstra's algorithm, with little parallelism,
+ * while a large @a delta is like Bellman-Ford, with more wasted work.
+ * The maximum edge length divided by the average number of edges per vertex
+ * is a reasonable start.
+ *
+ * Each vertex is owned by one thread, which keeps the vertex in its own
+ * buckets and is the only thread that changes the vertex's length, so the
+ * threads don't need locks or atomic operations. Each thread relaxes the
+ * edges of its own vertices by sending requests to the owners of the edges'
+ * destination vertices, which apply them in the next phase.
+ *
+ * This needs the edge lengths to be non-negative.
+ *
+ * @tparam T_Graph For instance, type_vec_nodes or CsrGraph.
+ */
+template <typename T_Graph>
+ShortestPaths
+delta_stepping_compute_shortest_paths(const T_Graph& vertices,
+  type_num start_vertex, type_length delta, ThreadPool& thread_pool) {
+  const auto vertices_count = vertices.size();
+  if (start_vertex >= vertices_count) {
+    std::cerr << "start vertex not found in vertices: " << start_vertex
+              << std::endl;
+    return ShortestPaths();
+  }
+
+  if (delta < 1) {
+    std::cerr << "delta must be at least 1: " << delta << std::endl;
+    return ShortestPaths();
+  }
+
+  type_length max_length = 0;
+  for (std::size_t v = 0; v < vertices_count; ++v) {
+    for (const auto& edge : vertices[v].edges_) {
+      if (edge.length_ < 0) {
+        std::cerr << "delta_stepping_compute_shortest_paths(): "
+                     "negative edge lengths are not supported."
+                  << std::endl;
+        return ShortestPaths();
+      }
+
+      max_length = std::max<type_length>(max_length, edge.length_);
+    }
+  }
+
+  // The lengths in the buckets are never more than max_length past the
+  // current bucket, so we only need enough buckets to cover that range.
+  const std::size_t buckets_count = max_length / delta + 2;
+
+  const auto threads_count = thread_pool.size();
+  const auto get_owner = [threads_count](
+                           type_num v) { return v % threads_count; };
+
+  std::vector<type_length> lengths(vertices_count, Edge::LENGTH_INFINITY);
+  std::vector<type_num> predecessors(vertices_count, INVALID_PREDECESSOR);
+
+  // The bucket in which each vertex was last settled:
+  std::vector<type_length> settled_buckets(vertices_count, -1);
+
+  std::vector<DeltaSteppingThreadState> states(threads_count);
+  for (auto& state : states) {
+    state.buckets_.resize(buckets_count);
+    state.outboxes_.resize(threads_count);
+  }
+
+  lengths[start_vertex] = 0;
+  states[get_owner(start_vertex)].buckets_[0].emplace_back(start_vertex);
+
+  // Let each thread apply the requests for its own vertices,
+  // putting them into its buckets if they are now shorter:
+  const auto apply_requests = [&](std::size_t thread_index) {
+    auto& state = states[thread_index];
+    for (auto& sender : states) {
+      auto& requests = sender.outboxes_[thread_index];
+      for (const auto& request : requests) {
+        const auto v = request.vertex_;
+        if (request.length_ < lengths[v]) {
+          lengths[v] = request.length_;
+          predecessors[v] = request.predecessor_;
+          state.buckets_[(request.length_ / delta) % buckets_count]
+            .emplace_back(v);
+        }
+      }
+
+      requests.clear();
+    }
+  };
+
+  type_length current = 0;
+  while (true) {
+    // Find the next non-empty bucket:
+    bool found = false;
+    for (std::size_t i = 0; i < buckets_count && !found; ++i) {
+      const auto slot = (current + i) % buckets_count;
+      for (const auto& state : states) {
+        if (!state.buckets_[slot].empty()) {
+          current += i;
+          found = true;
+          break;
+        }
+      }
+    }
+
+    if (!found) {
+      break;
+    }
+
+    const auto slot = current % buckets_count;
+
+    // Relax the light edges, until the bucket stays empty:
+    while (true) {
+      thread_pool.run([&](std::size_t thread_index) {
+        auto& state = states[thread_index];
+        std::swap(state.frontier_, state.buckets_[slot]);
+
+        for (const auto v : state.frontier_) {
+          const auto length = lengths[v];
+          if (length / delta != current) {
+            // A stale entry.
+            continue;
+          }
+
+          if (settled_buckets[v] != current) {
+            settled_buckets[v] = current;
+            state.settled_.emplace_back(v);
+          }
+
+          for (const auto& edge : vertices[v].edges_) {
+            if (edge.length_ <= delta) {
+              const type_num w = edge.destination_vertex_;
+              state.outboxes_[get_owner(w)].emplace_back(
+                w, length + edge.length_, v);
+            }
+          }
+        }
+
+        state.frontier_.clear();
+      });
+
+      thread_pool.run(apply_requests);
+
+      bool empty = true;
+      for (const auto& state : states) {
+        if (!state.buckets_[slot].empty()) {
+          empty = false;
+          break;
+        }
+      }
+
+      if (empty) {
+        break;
+      }
+    }
+
+    // Relax the heavy edges of the vertices settled in this bucket:
+    thread_pool.run([&](std::size_t thread_index) {
+      auto& state = states[thread_index];
+      for (const auto v : state.settled_) {
+        const auto length = lengths[v];
+        for (const auto& edge : vertices[v].edges_) {
+          if (edge.length_ > delta) {
+            const type_num w = edge.destination_vertex_;
+            state.outboxes_[get_owner(w)].emplace_back(
+              w, length + edge.length_, v);
+          }
+        }
+      }
+
+      state.settled_.clear();
+    });
+
+    thread_pool.run(apply_requests);
+
+    ++current;
+  }
+
+  return ShortestPaths(
+    start_vertex, std::move(lengths), std::move(predecessors));
+}
+
+/**
+ * Like delta_stepping_compute_shortest_paths(), using all cores.
+ */
+template <typename T_Graph>
+ShortestPaths
+delta_stepping_compute_shortest_paths(
+  const T_Graph& vertices, type_num start_vertex, type_length delta) {
+  ThreadPool thread_pool;
+  return delta_stepping_compute_shortest_paths(
+    vertices, start_vertex, delta, thread_pool);
+}
+
+#endif // MURRAYC_ALGORITHMS_EXPERIMENTS_DELTA_STEPPING
@@ -0,0 +1,87 @@
+#include "delta_stepping.h"
+#include "shortest_path/dijkstra/dijkstra.h"
+#include "utils/csr_graph.h"
+#include "utils/example_graphs.h"
+#include "utils/random_graphs.h"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * Check that the lengths are the same as from Dijkstra's algorithm,
+ * and that each predecessor is on a shortest path.
+ */
+template <typename T_Graph>
+static void
+test_compare_with_dijkstra(const T_Graph& vertices, type_num start_vertex,
+  type_length delta, ThreadPool& thread_pool) {
+  const auto expected = dijkstra_compute_shortest_paths(vertices, start_vertex);
+  const auto shortest_paths = delta_stepping_compute_shortest_paths(
+    vertices, start_vertex, delta, thread_pool);
+  assert(shortest_paths.lengths_ == expected.lengths_);
+
+  for (type_num v = 0; v < vertices.size(); ++v) {
+    const auto predecessor = shortest_paths.predecessors_[v];
+    if (v == start_vertex || predecessor == INVALID_PREDECESSOR) {
+      continue;
+    }
+
+    bool found = false;
+    for (const auto& edge : vertices[predecessor].edges_) {
+      if (edge.destination_vertex_ == v &&
+          shortest_paths.get_length(predecessor) + edge.length_ ==
+            shortest_paths.get_length(v)) {
+        found = true;
+      }
+    }
+
+    assert(found);
+  }
+}
+
+static void
+test_small() {
+  ThreadPool thread_pool(2);
+  const auto shortest_paths = delta_stepping_compute_shortest_paths(
+    EXAMPLE_GRAPH_SMALL, 0, 2, thread_pool);
+  assert(shortest_paths.get_length(3) == 5);
+  assert(shortest_paths.get_path(3) == ShortestPath::type_path({0, 1, 3}));
+
+  // There is no path back to vertex 0:
+  assert(delta_stepping_compute_shortest_paths(
+           EXAMPLE_GRAPH_SMALL, 3, 2, thread_pool)
+           .get_length(0) == Edge::LENGTH_INFINITY);
+}
+
+int
+main() {
+  const auto shortest_paths =
+    delta_stepping_compute_shortest_paths(EXAMPLE_GRAPH_SMALL, 0, 2);
+  for (type_num v = 0; v < shortest_paths.size(); ++v) {
+    std::cout << "shortest path from 0 to " << v << ": "
+              << shortest_paths.get_length(v)
+              << ", path: " << shortest_paths[v].get_path_string() << std::endl;
+  }
+
+  test_small();
+
+  const auto random_graph = make_random_graph(1000, 5000, 100);
+  const CsrGraph random_csr_graph(random_graph);
+  for (const std::size_t threads_count : {1, 2, 3, 4}) {
+    ThreadPool thread_pool(threads_count);
+
+    for (type_num start = 0; start < EXAMPLE_GRAPH_SMALL.size(); ++start) {
+      for (const type_length delta : {1, 2, 3, 100}) {
+        test_compare_with_dijkstra(
+          EXAMPLE_GRAPH_SMALL, start, delta, thread_pool);
+      }
+    }
+
+    for (const type_length delta : {1, 10, 50, 1000}) {
+      test_compare_with_dijkstra(random_graph, 0, delta, thread_pool);
+      test_compare_with_dijkstra(random_csr_graph, 7, delta, thread_pool);
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
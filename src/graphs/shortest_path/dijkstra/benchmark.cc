@@ -0,0 +1,144 @@
+#include "dijkstra.h"
+#include "utils/benchmark.h"
+#include "utils/csr_graph.h"
+#include "utils/random_graphs.h"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+using type_queries = std::vector<std::pair<type_num, type_num>>;
+
+/**
+ * Run all the @a queries with @a func, and print the queries per second.
+ */
+template <typename T_Func>
+static type_length
+benchmark_queries(
+  const std::string& name, const type_queries& queries, T_Func func) {
+  // Sum the lengths, so we can check that all the versions give the same
+  // results, and so the compiler can't skip the work.
+  type_length checksum = 0;
+  const auto seconds = benchmark_seconds([&] {
+    for (const auto& query : queries) {
+      checksum += func(query.first, query.second).length_;
+    }
+  });
+
+  std::cout << name << ": " << queries.size() / seconds << " queries/s"
+            << std::endl;
+  return checksum;
+}
+
+/**
+ * Compare the priority queues on random graphs whose edge lengths are at most
+ * @a max_length, because the RadixHeap's speed depends on the size of the
+ * keys, while the binary heap's speed does not.
+ *
+ * @result false if the results were not the same.
+ */
+static bool
+compare_queues(type_num vertices_count, type_num edges_count,
+  type_length max_length, const type_queries& queries) {
+  std::cout << std::endl << "max edge length: " << max_length << std::endl;
+
+  const CsrGraph csr_graph(
+    make_random_graph(vertices_count, edges_count, max_length));
+
+  DijkstraWorkspace binary_heap_workspace;
+  const auto checksum_binary_heap = benchmark_queries(
+    "  binary heap", queries, [&](type_num start, type_num end) {
+      return dijkstra_compute_shortest_path(
+        csr_graph, start, end, binary_heap_workspace);
+    });
+
+  DijkstraIndexedHeapWorkspace<4> indexed_heap_workspace;
+  const auto checksum_indexed_heap = benchmark_queries(
+    "  indexed 4-ary heap", queries, [&](type_num start, type_num end) {
+      return dijkstra_compute_shortest_path(
+        csr_graph, start, end, indexed_heap_workspace);
+    });
+
+  DijkstraRadixHeapWorkspace radix_heap_workspace;
+  const auto checksum_radix_heap = benchmark_queries(
+    "  radix heap", queries, [&](type_num start, type_num end) {
+      return dijkstra_compute_shortest_path(
+        csr_graph, start, end, radix_heap_workspace);
+    });
+
+  return checksum_binary_heap == checksum_indexed_heap &&
+         checksum_binary_heap == checksum_radix_heap;
+}
+
+/**
+ * Usage: murrayc_dijkstra_benchmark [vertices_count] [edges_count]
+ * [queries_count]
+ */
+int
+main(int argc, char** argv) {
+  const auto vertices_count =
+    benchmark_get_arg<type_num>(argc, argv, 1, 10000);
+  const auto edges_count =
+    benchmark_get_arg<type_num>(argc, argv, 2, 10 * vertices_count);
+  const auto queries_count = benchmark_get_arg<type_num>(argc, argv, 3, 1000);
+  std::cout << "vertices: " << vertices_count << ", edges: " << edges_count
+            << ", queries: " << queries_count << std::endl;
+
+  const auto vertices = make_random_graph(vertices_count, edges_count, 1000);
+  const CsrGraph csr_graph(vertices);
+
+  std::mt19937 generator(1);
+  std::uniform_int_distribution<type_num> vertex_distribution(
+    0, vertices_count - 1);
+  type_queries queries;
+  for (type_num i = 0; i < queries_count; ++i) {
+    queries.emplace_back(
+      vertex_distribution(generator), vertex_distribution(generator));
+  }
+
+  const auto checksum_new_workspace = benchmark_queries(
+    "new workspace per query", queries, [&](type_num start, type_num end) {
+      return dijkstra_compute_shortest_path(vertices, start, end);
+    });
+
+  DijkstraWorkspace workspace;
+  const auto checksum_reused = benchmark_queries(
+    "reused workspace", queries, [&](type_num start, type_num end) {
+      return dijkstra_compute_shortest_path(vertices, start, end, workspace);
+    });
+
+  const auto checksum_reused_csr = benchmark_queries(
+    "reused workspace, CsrGraph", queries, [&](type_num start, type_num end) {
+      return dijkstra_compute_shortest_path(csr_graph, start, end, workspace);
+    });
+
+  DijkstraIndexedHeapWorkspace<4> indexed_heap_workspace;
+  const auto checksum_indexed_heap_csr =
+    benchmark_queries("reused indexed 4-ary heap workspace, CsrGraph", queries,
+      [&](type_num start, type_num end) {
+        return dijkstra_compute_shortest_path(
+          csr_graph, start, end, indexed_heap_workspace);
+      });
+
+  // The paths are not built until they are requested,
+  // so this takes about as long as a query that explores the whole graph.
+  const auto all_seconds = benchmark_seconds(
+    [&] { dijkstra_compute_shortest_paths(csr_graph, 0, workspace); });
+  std::cout << "all destinations, CsrGraph: " << all_seconds << "s"
+            << std::endl;
+
+  if (checksum_new_workspace != checksum_reused ||
+      checksum_new_workspace != checksum_reused_csr ||
+      checksum_new_workspace != checksum_indexed_heap_csr) {
+    std::cerr << "The results were not the same." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  for (const type_length max_length : {10, 1000, 1000000}) {
+    if (!compare_queues(vertices_count, edges_count, max_length, queries)) {
+      std::cerr << "The results were not the same." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
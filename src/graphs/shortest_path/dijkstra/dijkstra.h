@@ -1,12 +1,13 @@
 #ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_DIJKSTRA
 #define MURRAYC_ALGORITHMS_EXPERIMENTS_DIJKSTRA
 
+#include "utils/indexed_d_ary_heap.h"
+#include "utils/radix_heap.h"
 #include "utils/shortest_path.h"
 #include "utils/vertex.h"
+#include <algorithm>
 #include <iostream>
-#include <queue>
-#include <unordered_map>
-#include <unordered_set>
+#include <vector>
 
 // A set of vertices and their edges.
 using type_vec_nodes = std::vector<Vertex>;
@@ -19,15 +20,13 @@ using type_length = Edge::type_length;
  */
 class VertexAndLength {
 public:
-  VertexAndLength() : vertex_(0), total_length_(0), predecessor_(0) {}
+  VertexAndLength() : vertex_(0), total_length_(0) {}
 
-  VertexAndLength(
-    type_num vertex, type_length total_length, type_num predecessor)
-  : vertex_(vertex), total_length_(total_length), predecessor_(predecessor) {}
+  VertexAndLength(type_num vertex, type_length total_length)
+  : vertex_(vertex), total_length_(total_length) {}
 
   type_num vertex_;
   type_length total_length_;
-  type_num predecessor_;
 };
 
 static_assert(std::is_copy_assignable<VertexAndLength>::value,
@@ -39,163 +38,430 @@ static_assert(std::is_move_assignable<VertexAndLength>::value,
 static_assert(std::is_move_constructible<VertexAndLength>::value,
   "VertexAndLength should be move constructible.");
 
-static std::string
-get_path_from_predecessors(type_num start_vertex, type_num end_vertex,
-  const std::unordered_map<type_num, type_num>& map_path_predecessor) {
-  std::string path;
-
-  type_num predecessor = end_vertex;
-  while (predecessor != start_vertex) {
-    path = std::to_string(predecessor) + ", " + path;
-
-    const auto iter = map_path_predecessor.find(predecessor);
-    if (iter == map_path_predecessor.end()) {
-      // This is normal if there is no path to this vertex.
-      /*
-      std::cerr << "get_path_from_predecessors(): predecessor not found for
-      vertex:"
-        << predecessor
-        << ", start_vertex=" << start_vertex << ", end_vertex=" << end_vertex <<
-      std::endl;
-      */
-      break;
+/**
+ * The default priority queue for dijkstra_compute().
+ *
+ * This is a binary heap that can contain several entries for the same vertex,
+ * because we add a new entry when we find a shorter path to a vertex,
+ * instead of removing (or decreasing) the old one.
+ * dijkstra_compute() skips the stale entries when it pops them.
+ */
+class DijkstraBinaryHeap {
+public:
+  void
+  resize(std::size_t /* vertices_count */) {}
+
+  void
+  clear() {
+    heap_.clear();
+  }
+
+  bool
+  empty() const {
+    return heap_.empty();
+  }
+
+  void
+  push(type_num vertex, type_length total_length) {
+    heap_.emplace_back(vertex, total_length);
+    std::push_heap(heap_.begin(), heap_.end(), compare);
+  }
+
+  /**
+   * Remove and return the entry with the smallest length.
+   */
+  VertexAndLength
+  pop() {
+    std::pop_heap(heap_.begin(), heap_.end(), compare);
+    const auto result = heap_.back();
+    heap_.pop_back();
+    return result;
+  }
+
+private:
+  static bool
+  compare(const VertexAndLength& a, const VertexAndLength& b) {
+    return a.total_length_ > b.total_length_;
+  }
+
+  std::vector<VertexAndLength> heap_;
+};
+
+/**
+ * A priority queue for dijkstra_compute() that uses an IndexedDAryHeap,
+ * decreasing the length of a vertex's existing entry when we find a shorter
+ * path to it. So it never holds more than one entry per vertex,
+ * and its memory use doesn't grow with the number of edges.
+ *
+ * @tparam T_Arity The number of children of each node in the heap.
+ */
+template <unsigned int T_Arity = 4>
+class DijkstraIndexedHeap {
+public:
+  void
+  resize(std::size_t vertices_count) {
+    heap_.resize(vertices_count);
+  }
+
+  void
+  clear() {
+    heap_.clear();
+  }
+
+  bool
+  empty() const {
+    return heap_.empty();
+  }
+
+  void
+  push(type_num vertex, type_length total_length) {
+    heap_.push_or_decrease_key(vertex, total_length);
+  }
+
+  VertexAndLength
+  pop() {
+    const VertexAndLength result(heap_.top(), heap_.top_key());
+    heap_.pop();
+    return result;
+  }
+
+private:
+  IndexedDAryHeap<type_length, T_Arity> heap_;
+};
+
+/**
+ * A priority queue for dijkstra_compute() that uses a RadixHeap,
+ * which is faster than a binary heap when the edge lengths are small
+ * integers, because it doesn't need to compare the entries when they are
+ * pushed. Like DijkstraBinaryHeap, this can contain stale entries.
+ *
+ * This needs the edge lengths to be non-negative, so the lengths that
+ * dijkstra_compute() pushes never decrease below the last popped length.
+ */
+class DijkstraRadixHeap {
+public:
+  void
+  resize(std::size_t /* vertices_count */) {}
+
+  void
+  clear() {
+    heap_.clear();
+  }
+
+  bool
+  empty() const {
+    return heap_.empty();
+  }
+
+  void
+  push(type_num vertex, type_length total_length) {
+    heap_.push(total_length, vertex);
+  }
+
+  VertexAndLength
+  pop() {
+    const auto entry = heap_.pop();
+    return VertexAndLength(entry.second, entry.first);
+  }
+
+private:
+  RadixHeap<type_length, type_num> heap_;
+};
+
+/**
+ * The arrays used by dijkstra_compute(), which can be reused by many
+ * calls, for the same graph, so repeated queries don't allocate any memory.
+ *
+ * Instead of clearing the arrays for each query, we increment epoch_,
+ * and only trust the values for vertices whose visited_epoch_ is the current
+ * epoch_.
+ *
+ * @tparam T_Queue The priority queue, such as DijkstraBinaryHeap,
+ * DijkstraIndexedHeap or DijkstraRadixHeap.
+ */
+template <typename T_Queue = DijkstraBinaryHeap>
+class BasicDijkstraWorkspace {
+public:
+  BasicDijkstraWorkspace() : epoch_(0) {}
+
+  explicit BasicDijkstraWorkspace(std::size_t vertices_count) : epoch_(0) {
+    resize(vertices_count);
+  }
+
+  void
+  resize(std::size_t vertices_count) {
+    distances_.resize(vertices_count);
+    predecessors_.resize(vertices_count);
+    visited_epoch_.resize(vertices_count);
+    queue_.resize(vertices_count);
+  }
+
+  /**
+   * Forget the results of the previous query.
+   */
+  void
+  start(std::size_t vertices_count) {
+    if (visited_epoch_.size() != vertices_count) {
+      resize(vertices_count);
     }
 
-    if (predecessor == iter->second) {
-      std::cerr << "get_path_from_predecessors(): avoiding infinite loop."
-                << std::endl;
-      break;
+    queue_.clear();
+
+    ++epoch_;
+    if (epoch_ == 0) {
+      // The epoch has wrapped around, so older values could seem current:
+      std::fill(visited_epoch_.begin(), visited_epoch_.end(), 0);
+      epoch_ = 1;
     }
+  }
 
-    predecessor = iter->second;
+  /**
+   * Whether there is a path to the vertex.
+   */
+  bool
+  is_reached(type_num v) const {
+    return visited_epoch_[v] == epoch_;
   }
 
-  path = std::to_string(start_vertex) + ", " + path;
-  return path;
-}
+  /**
+   * The length of the shortest path so far to the vertex,
+   * or Edge::LENGTH_INFINITY if there is no path.
+   */
+  type_length
+  get_length(type_num v) const {
+    return is_reached(v) ? distances_[v] : Edge::LENGTH_INFINITY;
+  }
+
+  /**
+   * The vertices along the shortest path so far to the vertex,
+   * or an empty path if there is no path.
+   */
+  ShortestPath::type_path
+  get_path(type_num start_vertex, type_num v) const {
+    if (!is_reached(v)) {
+      return ShortestPath::type_path();
+    }
+
+    return get_path_vertices_from_predecessors(start_vertex, v, predecessors_);
+  }
+
+  /**
+   * Copy the lengths and predecessors to all vertices.
+   */
+  ShortestPaths
+  get_shortest_paths(type_num start_vertex) const {
+    const auto vertices_count = distances_.size();
+    std::vector<type_length> lengths(vertices_count, Edge::LENGTH_INFINITY);
+    std::vector<type_num> predecessors(vertices_count, INVALID_PREDECESSOR);
+    for (std::size_t i = 0; i < vertices_count; ++i) {
+      if (is_reached(i) && i != start_vertex) {
+        lengths[i] = distances_[i];
+        predecessors[i] = predecessors_[i];
+      }
+    }
+
+    lengths[start_vertex] = 0;
+
+    return ShortestPaths(
+      start_vertex, std::move(lengths), std::move(predecessors));
+  }
+
+  void
+  set_length(type_num v, type_length length, type_num predecessor) {
+    distances_[v] = length;
+    predecessors_[v] = predecessor;
+    visited_epoch_[v] = epoch_;
+  }
+
+  std::vector<type_length> distances_;
+  std::vector<type_num> predecessors_;
+  std::vector<unsigned int> visited_epoch_;
+  unsigned int epoch_;
+
+  T_Queue queue_;
+};
+
+using DijkstraWorkspace = BasicDijkstraWorkspace<>;
+
+// A workspace that makes dijkstra_compute() use an IndexedDAryHeap.
+template <unsigned int T_Arity = 4>
+using DijkstraIndexedHeapWorkspace =
+  BasicDijkstraWorkspace<DijkstraIndexedHeap<T_Arity>>;
+
+// A workspace that makes dijkstra_compute() use a RadixHeap,
+// for graphs with non-negative integer edge lengths.
+using DijkstraRadixHeapWorkspace = BasicDijkstraWorkspace<DijkstraRadixHeap>;
 
-static std::vector<ShortestPath>
-dijkstra_compute_shortest_paths(const type_vec_nodes& vertices,
-  type_num start_vertex, type_num end_vertex, bool stop_at_end = false) {
-  std::vector<ShortestPath> result;
+/**
+ * The default edge filter for dijkstra_compute(), which uses all edges.
+ */
+class DijkstraAllEdges {
+public:
+  template <typename T_Edge>
+  bool
+  operator()(type_num /* source_vertex */, const T_Edge& /* edge */) const {
+    return true;
+  }
+};
 
+/**
+ * Calculate the shortest paths from @a start_vertex, leaving the lengths and
+ * predecessors in the @a workspace, using only the edges accepted by
+ * @a edge_filter.
+ *
+ * The filter lets callers hide vertices or edges, for instance to find paths
+ * that avoid parts of an earlier path, without copying the graph.
+ *
+ * @param stop_at_end Stop when we have the shortest path to @a end_vertex,
+ * instead of calculating the shortest paths to all vertices.
+ * @param edge_filter Called with the source vertex and the edge, returning
+ * false to ignore the edge.
+ * @result false if the start or end vertex is not in the graph.
+ *
+ * @tparam T_Graph For instance, type_vec_nodes or CsrGraph.
+ * @tparam T_Queue The workspace's priority queue.
+ */
+template <typename T_Graph, typename T_Queue, typename T_EdgeFilter>
+bool
+dijkstra_compute(const T_Graph& vertices, type_num start_vertex,
+  type_num end_vertex, bool stop_at_end,
+  BasicDijkstraWorkspace<T_Queue>& workspace,
+  const T_EdgeFilter& edge_filter) {
   const auto vertices_size = vertices.size();
 
   if (start_vertex >= vertices_size) {
     std::cerr << "start vertex not found in vertices: " << start_vertex
               << std::endl;
-    return result;
+    return false;
   }
 
   if (end_vertex >= vertices_size) {
     std::cerr << "end vertex not found in vertices: " << end_vertex
               << std::endl;
-    return result;
+    return false;
   }
 
-  // std::cout << " dijkstra_compute_shortest_path(): start_vertex: " <<
-  // start_vertex << ", end_vertex: " << end_vertex << std::endl;
-  // TODO: A simple vector would probably be more efficient,
-  // as long as we need to explore almost all the vertices.
-  std::unordered_map<type_num, type_num> map_path_predecessor;
-  map_path_predecessor[start_vertex] = 0; // Invalid
-
-  // TODO: A simple vector would probably be more efficient,
-  // as long as we need to explore almost all the vertices.
-  std::unordered_set<type_num> explored;
-
-  const auto comparator = [](
-    const auto& a, const auto& b) { return a.total_length_ > b.total_length_; };
-  std::priority_queue<VertexAndLength, std::vector<VertexAndLength>,
-    decltype(comparator)>
-    heap(comparator);
-  heap.emplace(start_vertex, 0, 0);
+  workspace.start(vertices_size);
+  workspace.set_length(start_vertex, 0, start_vertex);
 
-  // Optionally, store the shortest paths for all destination vertices:
-  std::unordered_map<type_num, VertexAndLength> total_lengths;
+  auto& queue = workspace.queue_;
+  queue.push(start_vertex, 0);
 
-  while (!heap.empty()) {
+  while (!queue.empty()) {
     // Get the vertex which has an edge leading to it from the explored set,
     // of minimum length:
-    const auto best = heap.top();
-    heap.pop();
+    const auto best = queue.pop();
     const auto best_vertex = best.vertex_;
 
-    if (explored.count(best_vertex) > 0) {
-      // std::cout << "    best_vertex is in explored." << std::endl;
+    if (best.total_length_ > workspace.distances_[best_vertex]) {
       // This must be an invalid entry in the heap,
-      // which we left to check later, instead of removing.
+      // which we left to check later, instead of removing,
+      // because we later found a shorter path to the same vertex.
       // Ignore it.
+      // (This doesn't happen with DijkstraIndexedHeap.)
       continue;
     }
 
-    map_path_predecessor[best_vertex] = best.predecessor_;
-
-    // Optionally, remember the shortest path to all destination vertices:
-    if (!stop_at_end) {
-      total_lengths.emplace(best_vertex, best);
-    }
-
     // Optionally, stop if we've found the destination vertex.
     // No other path can be shorter,
     // because every part of the path must be the shortest way to get to that
     // part.
     // Or, optionally, continue to get the shortest paths to all vertices.
     if (stop_at_end && best_vertex == end_vertex) {
-      const auto path = get_path_from_predecessors(
-        start_vertex, end_vertex, map_path_predecessor);
-      result.emplace_back(best.total_length_, path);
-      return result;
+      return true;
     }
 
-    // Move it to explored:
-    explored.emplace(best_vertex);
+    for (const auto& edge : vertices[best_vertex].edges_) {
+      if (!edge_filter(best_vertex, edge)) {
+        continue;
+      }
 
-    const auto& vertex = vertices[best_vertex];
-    for (const auto& edge : vertex.edges_) {
-      const auto edge_destination_vertex = edge.destination_vertex_;
+      const type_num edge_destination_vertex = edge.destination_vertex_;
+      const auto total_length = best.total_length_ + edge.length_;
 
-      // Ignore edges leading into the already-explored set:
-      if (explored.count(edge_destination_vertex) > 0)
+      // Ignore edges that don't give us a shorter path:
+      if (workspace.is_reached(edge_destination_vertex) &&
+          total_length >= workspace.distances_[edge_destination_vertex]) {
         continue;
+      }
 
-      const auto total_length = best.total_length_ + edge.length_;
-      heap.emplace(
+      workspace.set_length(
         edge_destination_vertex, total_length, best_vertex /* predecessor */);
+      queue.push(edge_destination_vertex, total_length);
     }
   }
 
-  result.reserve(vertices_size);
-  for (type_num i = 0; i < vertices_size; ++i) {
-    const auto& dest_shortest = total_lengths[i];
-    const auto path =
-      get_path_from_predecessors(start_vertex, i, map_path_predecessor);
-    result.emplace_back(dest_shortest.total_length_, path);
+  return true;
+}
+
+/**
+ * Calculate the shortest paths from @a start_vertex, using all edges.
+ */
+template <typename T_Graph, typename T_Queue>
+bool
+dijkstra_compute(const T_Graph& vertices, type_num start_vertex,
+  type_num end_vertex, bool stop_at_end,
+  BasicDijkstraWorkspace<T_Queue>& workspace) {
+  return dijkstra_compute(vertices, start_vertex, end_vertex, stop_at_end,
+    workspace, DijkstraAllEdges());
+}
+
+/**
+ * Get the shortest paths to all vertices,
+ * reusing the @a workspace from previous calls.
+ * Vertices with no path from @a start_vertex have a length of
+ * Edge::LENGTH_INFINITY.
+ */
+template <typename T_Graph, typename T_Queue>
+ShortestPaths
+dijkstra_compute_shortest_paths(const T_Graph& vertices,
+  type_num start_vertex, BasicDijkstraWorkspace<T_Queue>& workspace) {
+  if (!dijkstra_compute(vertices, start_vertex, start_vertex,
+        false /* stop at end_vertex */, workspace)) {
+    return ShortestPaths();
   }
 
-  return result;
+  return workspace.get_shortest_paths(start_vertex);
 }
 
-std::vector<ShortestPath>
+/**
+ * @tparam T_Graph For instance, type_vec_nodes or CsrGraph.
+ */
+template <typename T_Graph>
+ShortestPaths
 dijkstra_compute_shortest_paths(
-  const type_vec_nodes& vertices, type_num start_vertex) {
-  return dijkstra_compute_shortest_paths(vertices, start_vertex,
-    0 /* not used, when passing false */, false /* stop at end_vertex */);
+  const T_Graph& vertices, type_num start_vertex) {
+  DijkstraWorkspace workspace;
+  return dijkstra_compute_shortest_paths(vertices, start_vertex, workspace);
 }
 
+/**
+ * Get the shortest path, reusing the @a workspace from previous calls,
+ * so that many queries on the same graph don't need to allocate memory.
+ */
+template <typename T_Graph, typename T_Queue>
 ShortestPath
-dijkstra_compute_shortest_path(
-  const type_vec_nodes& vertices, type_num start_vertex, type_num end_vertex) {
-  const auto shortest_paths = dijkstra_compute_shortest_paths(
-    vertices, start_vertex, end_vertex, true /* stop at end_vertex */);
-  if (shortest_paths.empty()) {
+dijkstra_compute_shortest_path(const T_Graph& vertices, type_num start_vertex,
+  type_num end_vertex, BasicDijkstraWorkspace<T_Queue>& workspace) {
+  if (!dijkstra_compute(vertices, start_vertex, end_vertex,
+        true /* stop at end_vertex */, workspace)) {
     std::cerr << "dijkstra_compute_shortest_path(): "
-                 "dijkstra_compute_shortest_path() failed."
+                 "dijkstra_compute() failed."
               << std::endl;
-    return ShortestPath(0, "");
+    return ShortestPath();
   }
 
-  return shortest_paths[0];
+  return ShortestPath(workspace.get_length(end_vertex),
+    workspace.get_path(start_vertex, end_vertex));
+}
+
+template <typename T_Graph>
+ShortestPath
+dijkstra_compute_shortest_path(
+  const T_Graph& vertices, type_num start_vertex, type_num end_vertex) {
+  DijkstraWorkspace workspace;
+  return dijkstra_compute_shortest_path(
+    vertices, start_vertex, end_vertex, workspace);
 }
 
 #endif // MURRAYC_ALGORITHMS_EXPERIMENTS_DIJKSTRA
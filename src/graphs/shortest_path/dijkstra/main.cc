@@ -1,4 +1,5 @@
 #include "dijkstra.h"
+#include "utils/csr_graph.h"
 #include "utils/example_graphs.h"
 #include <cassert>
 #include <cstdlib>
@@ -12,6 +13,147 @@ test_small_dest(
   assert(shortest_path.length_ == expected_shortest_path);
 }
 
+static void
+test_small_dest_csr(
+  type_num dest_vertex_num, Edge::type_length expected_shortest_path) {
+  const CsrGraph graph(EXAMPLE_GRAPH_SMALL);
+  const auto shortest_path =
+    dijkstra_compute_shortest_path(graph, 0, dest_vertex_num);
+  assert(shortest_path.length_ == expected_shortest_path);
+}
+
+static void
+test_all_dests_csr() {
+  const auto expected = dijkstra_compute_shortest_paths(EXAMPLE_GRAPH_SMALL, 0);
+
+  const CsrGraph graph(EXAMPLE_GRAPH_SMALL);
+  const auto shortest_paths = dijkstra_compute_shortest_paths(graph, 0);
+  assert(shortest_paths.size() == expected.size());
+  for (type_num i = 0; i < expected.size(); ++i) {
+    assert(shortest_paths[i].length_ == expected[i].length_);
+    assert(shortest_paths[i].path_ == expected[i].path_);
+  }
+}
+
+static void
+test_compact_edges() {
+  const auto graph = convert_vertices<CompactEdge>(EXAMPLE_GRAPH_SMALL);
+  assert(dijkstra_compute_shortest_path(graph, 0, 3).length_ == 5);
+
+  const BasicCsrGraph<std::uint32_t, std::int32_t> csr_graph(graph);
+  assert(dijkstra_compute_shortest_path(csr_graph, 0, 3).length_ == 5);
+}
+
+static void
+test_reuse_workspace() {
+  DijkstraWorkspace workspace;
+
+  // Use the same workspace for several queries,
+  // making sure that it doesn't remember the results of the previous queries:
+  for (int i = 0; i < 2; ++i) {
+    assert(dijkstra_compute_shortest_path(
+             EXAMPLE_GRAPH_SMALL, 0, 3, workspace).length_ == 5);
+    assert(dijkstra_compute_shortest_path(
+             EXAMPLE_GRAPH_SMALL, 1, 2, workspace).length_ == 1);
+    assert(dijkstra_compute_shortest_path(
+             EXAMPLE_GRAPH_SMALL, 2, 1, workspace).length_ ==
+           Edge::LENGTH_INFINITY);
+
+    const auto shortest_paths =
+      dijkstra_compute_shortest_paths(EXAMPLE_GRAPH_SMALL, 1, workspace);
+    assert(shortest_paths.get_length(0) == Edge::LENGTH_INFINITY);
+    assert(shortest_paths.get_length(1) == 0);
+    assert(shortest_paths.get_length(3) == 2);
+  }
+}
+
+static void
+test_paths() {
+  const auto shortest_path =
+    dijkstra_compute_shortest_path(EXAMPLE_GRAPH_SMALL, 0, 3);
+  assert(shortest_path.path_ == ShortestPath::type_path({0, 1, 3}));
+  assert(shortest_path.get_path_string() == "0, 1, 3, ");
+
+  // There is no path from 3 to 0:
+  const auto no_path =
+    dijkstra_compute_shortest_path(EXAMPLE_GRAPH_SMALL, 3, 0);
+  assert(no_path.length_ == Edge::LENGTH_INFINITY);
+  assert(no_path.path_.empty());
+
+  const auto shortest_paths =
+    dijkstra_compute_shortest_paths(EXAMPLE_GRAPH_SMALL, 0);
+  assert(shortest_paths.get_path(0) == ShortestPath::type_path({0}));
+  assert(shortest_paths.get_path(2) == ShortestPath::type_path({0, 2}));
+  assert(shortest_paths[3].path_ == ShortestPath::type_path({0, 1, 3}));
+}
+
+static void
+test_edge_filter() {
+  DijkstraWorkspace workspace;
+
+  // Ignore the edge from 1 to 3:
+  const auto edge_filter = [](type_num source_vertex, const Edge& edge) {
+    return source_vertex != 1 || edge.destination_vertex_ != 3;
+  };
+  assert(dijkstra_compute(
+    EXAMPLE_GRAPH_SMALL, 0, 3, true, workspace, edge_filter));
+  assert(workspace.get_length(3) == 53);
+  assert(workspace.get_path(0, 3) == ShortestPath::type_path({0, 2, 3}));
+
+  // Ignore all edges to 2 as well:
+  const auto edge_filter_without_2 = [](
+                                       type_num source_vertex,
+                                       const Edge& edge) {
+    return edge.destination_vertex_ != 2 &&
+           (source_vertex != 1 || edge.destination_vertex_ != 3);
+  };
+  assert(dijkstra_compute(
+    EXAMPLE_GRAPH_SMALL, 0, 3, true, workspace, edge_filter_without_2));
+  assert(!workspace.is_reached(3));
+  assert(workspace.get_length(1) == 3);
+}
+
+template <typename T_Workspace>
+static void
+test_indexed_heap() {
+  T_Workspace workspace;
+  assert(dijkstra_compute_shortest_path(EXAMPLE_GRAPH_SMALL, 0, 3, workspace)
+           .length_ == 5);
+
+  const auto& graph = EXAMPLE_GRAPH_LARGER_WITH_NEGATIVE_EDGES;
+  const auto expected = dijkstra_compute_shortest_paths(graph, 4);
+  const auto shortest_paths =
+    dijkstra_compute_shortest_paths(graph, 4, workspace);
+  assert(shortest_paths.lengths_ == expected.lengths_);
+}
+
+static void
+test_radix_heap() {
+  DijkstraRadixHeapWorkspace workspace;
+  for (type_num start = 0; start < EXAMPLE_GRAPH_SMALL.size(); ++start) {
+    const auto expected =
+      dijkstra_compute_shortest_paths(EXAMPLE_GRAPH_SMALL, start);
+    const auto shortest_paths =
+      dijkstra_compute_shortest_paths(EXAMPLE_GRAPH_SMALL, start, workspace);
+    assert(shortest_paths.lengths_ == expected.lengths_);
+  }
+
+  // Large lengths, whose keys differ in high bits,
+  // and several paths of the same length:
+  const type_vec_nodes graph = {Vertex({Edge(1, 1000000), Edge(2, 3)}),
+    Vertex({Edge(3, 1)}),
+    Vertex({Edge(1, 999998), Edge(3, 1000000), Edge(4, 1 << 30)}),
+    Vertex({Edge(4, 5)}), Vertex()};
+  const CsrGraph csr_graph(graph);
+  const auto expected = dijkstra_compute_shortest_paths(graph, 0);
+  const auto shortest_paths =
+    dijkstra_compute_shortest_paths(csr_graph, 0, workspace);
+  assert(shortest_paths.lengths_ == expected.lengths_);
+  assert(shortest_paths.get_length(4) == 1000006);
+  assert(dijkstra_compute_shortest_path(graph, 0, 1, workspace).length_ ==
+         1000000);
+}
+
 int
 main() {
   const auto start_vertex = 0;
@@ -21,7 +163,7 @@ main() {
       EXAMPLE_GRAPH_SMALL, start_vertex, dest_vertex_num);
     std::cout << "shortest path from " << start_vertex << " to "
               << dest_vertex_num << ": " << shortest_path.length_
-              << ", path: " << shortest_path.path_ << std::endl;
+              << ", path: " << shortest_path.get_path_string() << std::endl;
   }
 
   test_small_dest(0, 0);
@@ -29,5 +171,20 @@ main() {
   test_small_dest(2, 3);
   test_small_dest(3, 5);
 
+  test_small_dest_csr(0, 0);
+  test_small_dest_csr(1, 3);
+  test_small_dest_csr(2, 3);
+  test_small_dest_csr(3, 5);
+
+  test_all_dests_csr();
+
+  test_compact_edges();
+  test_reuse_workspace();
+  test_paths();
+  test_edge_filter();
+  test_indexed_heap<DijkstraIndexedHeapWorkspace<>>();
+  test_indexed_heap<DijkstraIndexedHeapWorkspace<8>>();
+  test_radix_heap();
+
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,99 @@
+#include "dynamic_shortest_paths.h"
+#include "utils/benchmark.h"
+#include "utils/random_graphs.h"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+/**
+ * Change @a changes_count random edges of the graph, and compare the time
+ * to repair the shortest paths with the time to recalculate them all.
+ * @result false if the results were not the same.
+ */
+static bool
+benchmark_changes(const std::string& name, const type_vec_nodes& vertices,
+  type_num changes_count) {
+  std::cout << name << ", vertices: " << vertices.size()
+            << ", changes per batch: " << changes_count << std::endl;
+
+  DynamicShortestPaths shortest_paths(vertices, 0);
+
+  std::mt19937 generator(1);
+  std::uniform_int_distribution<type_num> vertex_distribution(
+    0, vertices.size() - 1);
+  std::uniform_int_distribution<type_length> factor_distribution(1, 4);
+
+  double update_seconds = 0;
+  double recalculate_seconds = 0;
+  std::size_t affected_count = 0;
+  const int batches_count = 10;
+  for (int batch = 0; batch < batches_count; ++batch) {
+    // Make some existing edges longer or shorter:
+    std::vector<DynamicShortestPathsEdgeChange> changes;
+    while (changes.size() < changes_count) {
+      const auto u = vertex_distribution(generator);
+      const auto& edges = shortest_paths.vertices_[u].edges_;
+      if (edges.empty()) {
+        continue;
+      }
+
+      const auto& edge = edges[vertex_distribution(generator) % edges.size()];
+      const auto length = batch % 2 == 0
+                            ? edge.length_ * factor_distribution(generator)
+                            : edge.length_ / factor_distribution(generator);
+      changes.emplace_back(u, edge.destination_vertex_, length);
+    }
+
+    update_seconds +=
+      benchmark_seconds([&] { shortest_paths.update_edges(changes); });
+    affected_count += shortest_paths.affected_count_;
+
+    ShortestPaths expected;
+    recalculate_seconds += benchmark_seconds([&] {
+      expected = dijkstra_compute_shortest_paths(shortest_paths.vertices_, 0);
+    });
+
+    for (type_num v = 0; v < vertices.size(); ++v) {
+      if (shortest_paths.get_length(v) != expected.get_length(v)) {
+        std::cerr << "The results were not the same." << std::endl;
+        return false;
+      }
+    }
+  }
+
+  std::cout << "  update_edges(): " << update_seconds / batches_count
+            << "s per batch, affected vertices per batch: "
+            << affected_count / batches_count << std::endl;
+  std::cout << "  dijkstra_compute_shortest_paths(): "
+            << recalculate_seconds / batches_count
+            << "s per batch, speedup: " << recalculate_seconds / update_seconds
+            << std::endl;
+  return true;
+}
+
+/**
+ * Usage: murrayc_dynamic_shortest_paths_benchmark [vertices_count]
+ * [changes_count]
+ */
+int
+main(int argc, char** argv) {
+  const auto vertices_count =
+    benchmark_get_arg<type_num>(argc, argv, 1, 1000000);
+  const auto changes_count = benchmark_get_arg<type_num>(argc, argv, 2, 2000);
+
+  if (!benchmark_changes("random graph",
+        make_random_graph(vertices_count, 10 * vertices_count, 1000),
+        changes_count)) {
+    return EXIT_FAILURE;
+  }
+
+  // A road-like network, with a large diameter:
+  const type_num width = 1000;
+  if (!benchmark_changes("grid graph",
+        make_random_grid_graph(width, vertices_count / width, 1000),
+        changes_count)) {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,374 @@
+#ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_DYNAMIC_SHORTEST_PATHS
+#define MURRAYC_ALGORITHMS_EXPERIMENTS_DYNAMIC_SHORTEST_PATHS
+
+#include "shortest_path/dijkstra/dijkstra.h"
+#include "utils/shortest_path.h"
+#include "utils/vertex.h"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+/**
+ * A change to the edge from source_ to destination_, for
+ * DynamicShortestPaths::update_edges().
+ */
+class DynamicShortestPathsEdgeChange {
+public:
+  /**
+   * @param length The new length of the edge, adding the edge if it doesn't
+   * exist yet, or Edge::LENGTH_INFINITY to remove the edge.
+   */
+  DynamicShortestPathsEdgeChange(
+    type_num source, type_num destination, type_length length)
+  : source_(source), destination_(destination), length_(length) {}
+
+  type_num source_;
+  type_num destination_;
+  type_length length_;
+};
+
+/**
+ * The shortest paths from one start vertex to all vertices, kept up to date
+ * while the graph's edges change, by repairing only the paths that are
+ * affected by the changes, instead of recalculating all of them, like the
+ * Ramalingam-Reps algorithm.
+ *
+ * This keeps its own copy of the graph, with the incoming edges of each
+ * vertex as well as its outgoing edges, because repairing a vertex's path
+ * needs its incoming edges. There is at most one edge from any vertex to
+ * another vertex, so a change to an edge is a change to that single edge.
+ *
+ * This needs the edge lengths to be non-negative.
+ */
+class DynamicShortestPaths {
+public:
+  /**
+   * Calculate the initial shortest paths, with Dijkstra's algorithm.
+   * If there are several edges from one vertex to another, only the
+   * shortest is kept.
+   * If @a start_vertex is not valid, there are no paths, and update_edges()
+   * does nothing.
+   */
+  DynamicShortestPaths(const type_vec_nodes& vertices, type_num start_vertex)
+  : start_vertex_(start_vertex),
+    vertices_(vertices.size()),
+    reverse_vertices_(vertices.size()),
+    lengths_(vertices.size(), Edge::LENGTH_INFINITY),
+    predecessors_(vertices.size(), INVALID_PREDECESSOR),
+    affected_count_(0),
+    affected_(vertices.size()) {
+    const auto vertices_count = vertices.size();
+    if (start_vertex >= vertices_count) {
+      std::cerr << "start vertex not found in vertices: " << start_vertex
+                << std::endl;
+      return;
+    }
+
+    for (type_num u = 0; u < vertices_count; ++u) {
+      for (const auto& edge : vertices[u].edges_) {
+        const auto existing = find_edge(u, edge.destination_vertex_);
+        if (existing == Edge::LENGTH_INFINITY || edge.length_ < existing) {
+          set_edge(u, edge.destination_vertex_, edge.length_);
+        }
+      }
+    }
+
+    DijkstraWorkspace workspace;
+    dijkstra_compute(
+      vertices_, start_vertex, start_vertex, false /* stop_at_end */,
+      workspace);
+
+    for (type_num v = 0; v < vertices_count; ++v) {
+      lengths_[v] = workspace.get_length(v);
+      if (v != start_vertex && workspace.is_reached(v)) {
+        predecessors_[v] = workspace.predecessors_[v];
+      }
+    }
+  }
+
+  /**
+   * The number of vertices.
+   */
+  std::size_t
+  size() const {
+    return vertices_.size();
+  }
+
+  /**
+   * The length of the shortest path to @a v,
+   * or Edge::LENGTH_INFINITY if there is no path.
+   */
+  type_length
+  get_length(type_num v) const {
+    return lengths_[v];
+  }
+
+  /**
+   * The vertices along the shortest path to @a v.
+   * This is empty if there is no path.
+   */
+  ShortestPath::type_path
+  get_path(type_num v) const {
+    if (lengths_[v] == Edge::LENGTH_INFINITY) {
+      return ShortestPath::type_path();
+    }
+
+    return get_path_vertices_from_predecessors(start_vertex_, v, predecessors_);
+  }
+
+  /**
+   * The length of the edge from @a u to @a v,
+   * or Edge::LENGTH_INFINITY if there is no such edge.
+   */
+  type_length
+  find_edge(type_num u, type_num v) const {
+    for (const auto& edge : vertices_[u].edges_) {
+      if (edge.destination_vertex_ == v) {
+        return edge.length_;
+      }
+    }
+
+    return Edge::LENGTH_INFINITY;
+  }
+
+  /**
+   * Change the length of the edge from @a u to @a v, adding the edge if
+   * necessary, and repair the shortest paths.
+   */
+  void
+  set_edge_length(type_num u, type_num v, type_length length) {
+    update_edges({DynamicShortestPathsEdgeChange(u, v, length)});
+  }
+
+  /**
+   * Remove the edge from @a u to @a v, and repair the shortest paths.
+   */
+  void
+  remove_edge(type_num u, type_num v) {
+    update_edges({DynamicShortestPathsEdgeChange(u, v, Edge::LENGTH_INFINITY)});
+  }
+
+  /**
+   * Change several edges, and then repair the shortest paths once,
+   * which is cheaper than repairing them after each change.
+   *
+   * First, the vertices whose shortest paths used an edge that is now longer,
+   * or removed, are "affected": They and their descendants in the tree of
+   * shortest paths lose their paths. The other vertices keep their paths,
+   * whose lengths can only decrease.
+   * Then each affected vertex gets the best path via its incoming edges from
+   * unaffected vertices, and each edge that is now shorter, or new, can give
+   * its destination a shorter path. Those vertices are put into a priority
+   * queue, and Dijkstra's algorithm continues from them, only reaching the
+   * vertices whose paths change.
+   *
+   * @result false if a change was not valid, or the start vertex was not
+   * valid, in which case no changes are made.
+   */
+  bool
+  update_edges(const std::vector<DynamicShortestPathsEdgeChange>& changes) {
+    const auto vertices_count = size();
+    if (start_vertex_ >= vertices_count) {
+      std::cerr << "update_edges(): start vertex not found in vertices: "
+                << start_vertex_ << std::endl;
+      return false;
+    }
+
+    for (const auto& change : changes) {
+      if (change.source_ >= vertices_count ||
+          change.destination_ >= vertices_count) {
+        std::cerr << "update_edges(): vertex not found: " << change.source_
+                  << " -> " << change.destination_ << std::endl;
+        return false;
+      }
+
+      if (change.length_ < 0) {
+        std::cerr << "update_edges(): negative edge lengths are not supported."
+                  << std::endl;
+        return false;
+      }
+    }
+
+    queue_.clear();
+    affected_vertices_.clear();
+
+    // Change the edges, noting which of them were used by shortest paths,
+    // but are now longer, or removed:
+    for (const auto& change : changes) {
+      const auto u = change.source_;
+      const auto v = change.destination_;
+      const auto old_length = find_edge(u, v);
+      if (change.length_ == Edge::LENGTH_INFINITY) {
+        unset_edge(u, v);
+      } else {
+        set_edge(u, v, change.length_);
+      }
+
+      if (change.length_ > old_length && predecessors_[v] == u &&
+          !affected_[v]) {
+        affect_subtree(v);
+      }
+    }
+
+    affected_count_ = affected_vertices_.size();
+
+    // Give each affected vertex its best path via unaffected vertices:
+    for (const auto v : affected_vertices_) {
+      for (const auto& edge : reverse_vertices_[v].edges_) {
+        const auto u = edge.destination_vertex_;
+        if (!affected_[u]) {
+          relax(u, v, edge.length_);
+        }
+      }
+    }
+
+    for (const auto v : affected_vertices_) {
+      affected_[v] = false;
+    }
+
+    // Let the shorter, or new, edges give shorter paths to their
+    // destinations:
+    for (const auto& change : changes) {
+      if (change.length_ != Edge::LENGTH_INFINITY) {
+        relax(change.source_, change.destination_,
+          find_edge(change.source_, change.destination_));
+      }
+    }
+
+    // Continue Dijkstra's algorithm from the changed vertices:
+    while (!queue_.empty()) {
+      const auto best = queue_.pop();
+      const auto u = best.vertex_;
+      if (best.total_length_ > lengths_[u]) {
+        // A stale entry. See dijkstra_compute().
+        continue;
+      }
+
+      for (const auto& edge : vertices_[u].edges_) {
+        relax(u, edge.destination_vertex_, edge.length_);
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * Copy the lengths and predecessors, for instance to compare them with the
+   * result of dijkstra_compute_shortest_paths().
+   */
+  ShortestPaths
+  get_shortest_paths() const {
+    auto lengths = lengths_;
+    auto predecessors = predecessors_;
+    return ShortestPaths(
+      start_vertex_, std::move(lengths), std::move(predecessors));
+  }
+
+  type_num start_vertex_;
+
+  // The outgoing edges of each vertex.
+  type_vec_nodes vertices_;
+
+  // The incoming edges of each vertex, with each edge's destination_vertex_
+  // being the source of the edge.
+  type_vec_nodes reverse_vertices_;
+
+  std::vector<type_length> lengths_;
+  std::vector<type_num> predecessors_;
+
+  // The number of vertices that lost their paths in the last update_edges(),
+  // for benchmarks.
+  std::size_t affected_count_;
+
+private:
+  void
+  set_edge(type_num u, type_num v, type_length length) {
+    set_edge_in(vertices_[u].edges_, v, length);
+    set_edge_in(reverse_vertices_[v].edges_, u, length);
+  }
+
+  void
+  unset_edge(type_num u, type_num v) {
+    unset_edge_in(vertices_[u].edges_, v);
+    unset_edge_in(reverse_vertices_[v].edges_, u);
+  }
+
+  static void
+  set_edge_in(std::vector<Edge>& edges, type_num v, type_length length) {
+    for (auto& edge : edges) {
+      if (edge.destination_vertex_ == v) {
+        edge.length_ = length;
+        return;
+      }
+    }
+
+    edges.emplace_back(v, length);
+  }
+
+  static void
+  unset_edge_in(std::vector<Edge>& edges, type_num v) {
+    const auto iter = std::find_if(edges.begin(), edges.end(),
+      [v](const Edge& edge) { return edge.destination_vertex_ == v; });
+    if (iter != edges.end()) {
+      // The order of the edges doesn't matter.
+      std::swap(*iter, edges.back());
+      edges.pop_back();
+    }
+  }
+
+  /**
+   * Mark @a v, and all the vertices whose shortest paths go through it,
+   * as affected, removing their paths.
+   */
+  void
+  affect_subtree(type_num v) {
+    const auto begin = affected_vertices_.size();
+    affected_[v] = true;
+    affected_vertices_.emplace_back(v);
+
+    // affected_vertices_ grows while we look at the children of its
+    // vertices, like a BFS queue:
+    for (auto i = begin; i < affected_vertices_.size(); ++i) {
+      const auto u = affected_vertices_[i];
+      for (const auto& edge : vertices_[u].edges_) {
+        const auto w = edge.destination_vertex_;
+        if (predecessors_[w] == u && !affected_[w]) {
+          affected_[w] = true;
+          affected_vertices_.emplace_back(w);
+        }
+      }
+    }
+
+    for (auto i = begin; i < affected_vertices_.size(); ++i) {
+      const auto u = affected_vertices_[i];
+      lengths_[u] = Edge::LENGTH_INFINITY;
+      predecessors_[u] = INVALID_PREDECESSOR;
+    }
+  }
+
+  /**
+   * Use the edge from @a u to @a v, if it gives @a v a shorter path.
+   */
+  void
+  relax(type_num u, type_num v, type_length length) {
+    if (lengths_[u] == Edge::LENGTH_INFINITY ||
+        length == Edge::LENGTH_INFINITY) {
+      return;
+    }
+
+    const auto total_length = lengths_[u] + length;
+    if (total_length < lengths_[v]) {
+      lengths_[v] = total_length;
+      predecessors_[v] = u;
+      queue_.push(v, total_length);
+    }
+  }
+
+  // Whether each vertex is affected, during update_edges().
+  std::vector<bool> affected_;
+  std::vector<type_num> affected_vertices_;
+
+  DijkstraBinaryHeap queue_;
+};
+
+#endif // MURRAYC_ALGORITHMS_EXPERIMENTS_DYNAMIC_SHORTEST_PATHS
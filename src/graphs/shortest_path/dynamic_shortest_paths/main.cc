@@ -0,0 +1,133 @@
+#include "dynamic_shortest_paths.h"
+#include "utils/example_graphs.h"
+#include "utils/random_graphs.h"
+#include <cassert>
+#include <cstdlib>
+#include <random>
+
+/**
+ * Check the lengths against dijkstra_compute_shortest_paths() on the current
+ * graph, and that each path uses existing edges that add up to its length.
+ */
+static void
+check_paths(const DynamicShortestPaths& shortest_paths) {
+  const auto& vertices = shortest_paths.vertices_;
+  const auto start_vertex = shortest_paths.start_vertex_;
+  const auto expected =
+    dijkstra_compute_shortest_paths(vertices, start_vertex);
+
+  const auto vertices_count = vertices.size();
+  for (type_num v = 0; v < vertices_count; ++v) {
+    const auto length = shortest_paths.get_length(v);
+    assert(length == expected.get_length(v));
+    if (length == Edge::LENGTH_INFINITY) {
+      assert(shortest_paths.get_path(v).empty());
+      continue;
+    }
+
+    const auto path = shortest_paths.get_path(v);
+    assert(path.front() == start_vertex);
+    assert(path.back() == v);
+
+    type_length path_length = 0;
+    for (std::size_t i = 0; i + 1 < path.size(); ++i) {
+      const auto edge_length = shortest_paths.find_edge(path[i], path[i + 1]);
+      assert(edge_length != Edge::LENGTH_INFINITY);
+      path_length += edge_length;
+    }
+
+    assert(path_length == length);
+  }
+}
+
+static void
+test_small() {
+  DynamicShortestPaths shortest_paths(EXAMPLE_GRAPH_SMALL, 0);
+  check_paths(shortest_paths);
+
+  // Make the path to 3 go via 2 instead of 1:
+  assert(shortest_paths.get_path(3) == ShortestPath::type_path({0, 1, 3}));
+  shortest_paths.set_edge_length(1, 3, 100);
+  check_paths(shortest_paths);
+  assert(shortest_paths.get_path(3) == ShortestPath::type_path({0, 2, 3}));
+
+  // Disconnect 3:
+  shortest_paths.remove_edge(1, 3);
+  shortest_paths.remove_edge(2, 3);
+  check_paths(shortest_paths);
+  assert(shortest_paths.get_length(3) == Edge::LENGTH_INFINITY);
+
+  // Connect it again, with a new edge:
+  shortest_paths.set_edge_length(0, 3, 1);
+  check_paths(shortest_paths);
+  assert(shortest_paths.get_path(3) == ShortestPath::type_path({0, 3}));
+
+  // An invalid change:
+  assert(!shortest_paths.update_edges(
+    {DynamicShortestPathsEdgeChange(0, 1, -1)}));
+  check_paths(shortest_paths);
+}
+
+static void
+test_invalid_start_vertex() {
+  const auto vertices_count = EXAMPLE_GRAPH_SMALL.size();
+  DynamicShortestPaths shortest_paths(EXAMPLE_GRAPH_SMALL, vertices_count);
+  for (type_num v = 0; v < vertices_count; ++v) {
+    assert(shortest_paths.get_length(v) == Edge::LENGTH_INFINITY);
+    assert(shortest_paths.get_path(v).empty());
+  }
+
+  assert(!shortest_paths.update_edges(
+    {DynamicShortestPathsEdgeChange(0, 1, 1)}));
+  assert(shortest_paths.find_edge(0, 1) == Edge::LENGTH_INFINITY);
+}
+
+static void
+test_random() {
+  const type_num vertices_count = 2000;
+  DynamicShortestPaths shortest_paths(
+    make_random_graph(vertices_count, 6000, 100), 0);
+  check_paths(shortest_paths);
+
+  std::mt19937 generator(1);
+  std::uniform_int_distribution<type_num> vertex_distribution(
+    0, vertices_count - 1);
+  std::uniform_int_distribution<type_length> length_distribution(0, 100);
+  std::uniform_int_distribution<int> kind_distribution(0, 3);
+
+  for (int batch = 0; batch < 50; ++batch) {
+    // Increase, decrease, remove, or add some edges,
+    // preferring edges that are in the tree of shortest paths:
+    std::vector<DynamicShortestPathsEdgeChange> changes;
+    for (int i = 0; i < 20; ++i) {
+      const auto v = vertex_distribution(generator);
+      auto u = shortest_paths.predecessors_[v];
+      if (u == INVALID_PREDECESSOR) {
+        u = vertex_distribution(generator);
+      }
+
+      const auto kind = kind_distribution(generator);
+      const auto old_length = shortest_paths.find_edge(u, v);
+      type_length length = length_distribution(generator);
+      if (kind == 0) {
+        length = Edge::LENGTH_INFINITY;
+      } else if (kind == 1 && old_length != Edge::LENGTH_INFINITY) {
+        length = old_length + length;
+      }
+
+      changes.emplace_back(u, v, length);
+    }
+
+    assert(shortest_paths.update_edges(changes));
+    check_paths(shortest_paths);
+  }
+}
+
+int
+main() {
+  test_small();
+  test_invalid_start_vertex();
+  test_random();
+
+  return EXIT_SUCCESS;
+}
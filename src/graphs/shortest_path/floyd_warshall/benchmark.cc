@@ -0,0 +1,83 @@
+#include "floyd_warshall.h"
+#include "utils/benchmark.h"
+#include "utils/random_graphs.h"
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+/**
+ * Usage: murrayc_floyd_warshall_benchmark [max_vertices_count_for_original]
+ * [max_threads_count]
+ *
+ * The original implementation takes minutes for the largest graph,
+ * so it is only run for graphs with up to max_vertices_count_for_original
+ * vertices.
+ */
+int
+main(int argc, char** argv) {
+  const auto max_vertices_count_for_original =
+    benchmark_get_arg<type_num>(argc, argv, 1, 4000);
+  const auto max_threads_count = benchmark_get_arg<std::size_t>(
+    argc, argv, 2, std::max(1u, std::thread::hardware_concurrency()));
+
+  for (const type_num vertices_count : {1000, 2000, 4000}) {
+    std::cout << "vertices: " << vertices_count << std::endl;
+
+    const auto vertices =
+      make_random_graph(vertices_count, 10 * vertices_count, 1000);
+
+    bool has_negative_cycles = false;
+    type_length blocked_result = 0;
+    const auto blocked_seconds = benchmark_seconds([&] {
+      blocked_result = floyd_warshall_blocked_calc_all_pairs_shortest_path(
+        vertices, has_negative_cycles);
+    });
+    std::cout << "  blocked, in place: " << blocked_seconds << "s"
+              << std::endl;
+
+    BasicDistanceMatrix<std::int32_t> matrix_32;
+    const auto blocked_32_seconds = benchmark_seconds(
+      [&] { floyd_warshall_blocked_compute(vertices, matrix_32); });
+    std::cout << "  blocked, in place, 32-bit lengths: " << blocked_32_seconds
+              << "s" << std::endl;
+
+    for (std::size_t threads_count = 2; threads_count <= max_threads_count;
+         threads_count *= 2) {
+      ThreadPool thread_pool(threads_count);
+      type_length threaded_result = 0;
+      const auto threaded_seconds = benchmark_seconds([&] {
+        threaded_result = floyd_warshall_blocked_calc_all_pairs_shortest_path(
+          vertices, has_negative_cycles, thread_pool);
+      });
+      std::cout << "  blocked, in place, " << threads_count
+                << " threads: " << threaded_seconds
+                << "s, speedup: " << blocked_seconds / threaded_seconds
+                << std::endl;
+
+      if (threaded_result != blocked_result) {
+        std::cerr << "The results were not the same." << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    if (vertices_count > max_vertices_count_for_original) {
+      continue;
+    }
+
+    type_length original_result = 0;
+    const auto original_seconds = benchmark_seconds([&] {
+      original_result = floyd_warshall_calc_all_pairs_shortest_path(
+        vertices, has_negative_cycles);
+    });
+    std::cout << "  original: " << original_seconds
+              << "s, speedup: " << original_seconds / blocked_seconds
+              << std::endl;
+
+    if (original_result != blocked_result) {
+      std::cerr << "The results were not the same." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -1,4 +1,6 @@
+#include "utils/distance_matrix.h"
 #include "utils/example_graphs.h"
+#include "utils/thread_pool.h"
 #include <algorithm>
 #include <cassert>
 #include <cstdlib>
@@ -60,11 +62,13 @@ calc_with_cache(const type_vec_nodes& vertices,
   // "]:" << case1 << std::endl;
 
   // Avoid adding infinity to infinity, which would overflow.
+  // k counts the vertices that may be used as intermediates, so step k adds
+  // vertex k - 1, because the vertices are 0-indexed.
   type_length case2 = LENGTH_INFINITY;
-  const auto i_to_k = shortest_paths_k_minus_1[i][k];
+  const auto i_to_k = shortest_paths_k_minus_1[i][k - 1];
   // std::cout << "    i_to_k: shortest_paths[" << i << "][" << k << "][" << k -
   // 1 << "]:" << i_to_k << std::endl;
-  const auto k_to_j = shortest_paths_k_minus_1[k][j];
+  const auto k_to_j = shortest_paths_k_minus_1[k - 1][j];
   // std::cout << "    k_to_j: shortest_paths[" << k << "][" << j << "][" << k -
   // 1 << "]:" << k_to_j << std::endl;
 
@@ -167,3 +171,226 @@ floyd_warshall_calc_all_pairs_shortest_path(
 
   return shortest_path_so_far;
 }
+
+// The number of rows and columns in each block of
+// floyd_warshall_blocked_compute(), so that the 3 blocks used by each step
+// fit in the L1 or L2 cache.
+constexpr std::size_t FLOYD_WARSHALL_BLOCK_SIZE = 64;
+
+/**
+ * Relax the paths in block @a c via the vertices of the current k block,
+ * with the lengths to those vertices in block @a a, and the lengths from
+ * those vertices in block @a b: c[i][j] = min(c[i][j], a[i][k] + b[k][j]).
+ *
+ * This is for the blocks in the same row or column as the k block,
+ * for which @a c is the same block as @a a or @a b (or both),
+ * so k must be the outer loop, as in the unblocked algorithm.
+ */
+template <typename T_Length>
+static void
+floyd_warshall_relax_block(T_Length* c, const T_Length* a, const T_Length* b,
+  std::size_t stride) {
+  for (std::size_t k = 0; k < FLOYD_WARSHALL_BLOCK_SIZE; ++k) {
+    const auto b_row = b + k * stride;
+    for (std::size_t i = 0; i < FLOYD_WARSHALL_BLOCK_SIZE; ++i) {
+      const auto a_ik = a[i * stride + k];
+
+      // Skip the whole row if there is no path via k:
+      if (BasicDistanceMatrix<T_Length>::is_infinity(a_ik)) {
+        continue;
+      }
+
+      const auto c_row = c + i * stride;
+      for (std::size_t j = 0; j < FLOYD_WARSHALL_BLOCK_SIZE; ++j) {
+        c_row[j] = std::min(c_row[j], static_cast<T_Length>(a_ik + b_row[j]));
+      }
+    }
+  }
+}
+
+/**
+ * Like floyd_warshall_relax_block(), for the blocks that are in neither the
+ * row nor the column of the k block, which is most of them.
+ *
+ * Block @a c is then separate from @a a and @a b, which don't change,
+ * so the loops can be in any order. With i as the outer loop, each row of
+ * @a c stays in the cache while it is relaxed via every k.
+ * __restrict tells the compiler that the blocks don't overlap, so it can
+ * vectorize the inner loop, which has no branches, without checking at
+ * runtime.
+ */
+template <typename T_Length>
+static void
+floyd_warshall_relax_separate_block(T_Length* __restrict c,
+  const T_Length* __restrict a, const T_Length* __restrict b,
+  std::size_t stride) {
+  for (std::size_t i = 0; i < FLOYD_WARSHALL_BLOCK_SIZE; ++i) {
+    T_Length* __restrict c_row = c + i * stride;
+    const auto a_row = a + i * stride;
+    for (std::size_t k = 0; k < FLOYD_WARSHALL_BLOCK_SIZE; ++k) {
+      const auto a_ik = a_row[k];
+
+      // Skip the whole row if there is no path via k:
+      if (BasicDistanceMatrix<T_Length>::is_infinity(a_ik)) {
+        continue;
+      }
+
+      const T_Length* __restrict b_row = b + k * stride;
+      for (std::size_t j = 0; j < FLOYD_WARSHALL_BLOCK_SIZE; ++j) {
+        c_row[j] = std::min(c_row[j], static_cast<T_Length>(a_ik + b_row[j]));
+      }
+    }
+  }
+}
+
+/**
+ * Calculate the lengths of the shortest paths between all pairs of vertices,
+ * in place, in one flat matrix.
+ *
+ * Unlike floyd_warshall_calc_all_pairs_shortest_path(), this doesn't keep
+ * separate matrices for k and k - 1, because relaxing a path via k can't
+ * change the lengths to or from k, unless there is a negative cycle.
+ *
+ * The matrix is processed in blocks, so each block is reused from the cache
+ * for a whole block of k values, instead of streaming the whole matrix from
+ * memory for each k. For each block of k values, we first relax the block on
+ * the diagonal, then the other blocks in the same row and column, which only
+ * depend on the diagonal block, and then all the other blocks, which only
+ * depend on the blocks in their row and column.
+ *
+ * The blocks of each of the last two steps are independent,
+ * so they are shared between the @a thread_pool's threads.
+ *
+ * @result false if there is a negative cycle.
+ *
+ * @tparam T_Graph For instance, type_vec_nodes or CsrGraph.
+ * @tparam T_Length The type of the lengths in the matrix.
+ */
+template <typename T_Graph, typename T_Length>
+bool
+floyd_warshall_blocked_compute(const T_Graph& vertices,
+  BasicDistanceMatrix<T_Length>& result, ThreadPool& thread_pool) {
+  const auto vertices_count = vertices.size();
+  const auto block_size = FLOYD_WARSHALL_BLOCK_SIZE;
+  const auto blocks_count = (vertices_count + block_size - 1) / block_size;
+  const auto stride = blocks_count * block_size;
+  result.resize(vertices_count, stride);
+
+  for (std::size_t i = 0; i < vertices_count; ++i) {
+    auto row = result.get_row(i);
+    row[i] = 0;
+
+    for (const auto& edge : vertices[i].edges_) {
+      auto& length = row[edge.destination_vertex_];
+      length = std::min(length, static_cast<T_Length>(edge.length_));
+    }
+  }
+
+  const auto get_block = [&result](std::size_t block_i, std::size_t block_j) {
+    return result.get_row(block_i * FLOYD_WARSHALL_BLOCK_SIZE) +
+           block_j * FLOYD_WARSHALL_BLOCK_SIZE;
+  };
+
+  for (std::size_t block_k = 0; block_k < blocks_count; ++block_k) {
+    const auto diagonal = get_block(block_k, block_k);
+    floyd_warshall_relax_block(diagonal, diagonal, diagonal, stride);
+
+    // The blocks in the same row and column only depend on the diagonal
+    // block, so they can be relaxed in parallel:
+    thread_pool.parallel_for(blocks_count,
+      [&](std::size_t block, std::size_t /* thread_index */) {
+        if (block == block_k) {
+          return;
+        }
+
+        const auto row_block = get_block(block_k, block);
+        floyd_warshall_relax_block(row_block, diagonal, row_block, stride);
+
+        const auto column_block = get_block(block, block_k);
+        floyd_warshall_relax_block(
+          column_block, column_block, diagonal, stride);
+      },
+      1);
+
+    // The other blocks only depend on the blocks in their row and column,
+    // so they can be relaxed in parallel too, one row of blocks per call:
+    thread_pool.parallel_for(blocks_count,
+      [&](std::size_t block_i, std::size_t /* thread_index */) {
+        if (block_i == block_k) {
+          return;
+        }
+
+        const auto column_block = get_block(block_i, block_k);
+        for (std::size_t block_j = 0; block_j < blocks_count; ++block_j) {
+          if (block_j != block_k) {
+            floyd_warshall_relax_separate_block(get_block(block_i, block_j),
+              column_block, get_block(block_k, block_j), stride);
+          }
+        }
+      },
+      1);
+
+    // Stop as soon as there is a negative cycle,
+    // before the lengths can become so negative that they overflow.
+    for (std::size_t i = 0; i < vertices_count; ++i) {
+      if (result.get_row(i)[i] < 0) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Like floyd_warshall_blocked_compute(), using only the calling thread.
+ */
+template <typename T_Graph, typename T_Length>
+bool
+floyd_warshall_blocked_compute(
+  const T_Graph& vertices, BasicDistanceMatrix<T_Length>& result) {
+  ThreadPool thread_pool(1);
+  return floyd_warshall_blocked_compute(vertices, result, thread_pool);
+}
+
+/**
+ * Like floyd_warshall_calc_all_pairs_shortest_path(),
+ * but using floyd_warshall_blocked_compute(), with the @a thread_pool.
+ *
+ * @result The length of the shortest path between any pair of vertices.
+ */
+template <typename T_Graph>
+type_length
+floyd_warshall_blocked_calc_all_pairs_shortest_path(const T_Graph& vertices,
+  bool& has_negative_cycles, ThreadPool& thread_pool) {
+  has_negative_cycles = false;
+
+  if (vertices.empty()) {
+    return LENGTH_INFINITY;
+  }
+
+  DistanceMatrix matrix;
+  if (!floyd_warshall_blocked_compute(vertices, matrix, thread_pool)) {
+    has_negative_cycles = true;
+    return 0;
+  }
+
+  type_length result = LENGTH_INFINITY;
+  for (std::size_t i = 0; i < matrix.size(); ++i) {
+    const auto row = matrix.get_row(i);
+    for (std::size_t j = 0; j < matrix.size(); ++j) {
+      result = std::min(result, row[j]);
+    }
+  }
+
+  return result;
+}
+
+template <typename T_Graph>
+type_length
+floyd_warshall_blocked_calc_all_pairs_shortest_path(
+  const T_Graph& vertices, bool& has_negative_cycles) {
+  ThreadPool thread_pool(1);
+  return floyd_warshall_blocked_calc_all_pairs_shortest_path(
+    vertices, has_negative_cycles, thread_pool);
+}
@@ -17,13 +17,108 @@ test_apsp(
   }
 
   assert(shortest_path_length == expected_shortest_path);
+
+  bool blocked_has_negative_cycles = false;
+  const auto blocked_shortest_path_length =
+    floyd_warshall_blocked_calc_all_pairs_shortest_path(
+      graph, blocked_has_negative_cycles);
+  assert(blocked_has_negative_cycles == has_negative_cycles);
+  assert(blocked_shortest_path_length == expected_shortest_path);
+}
+
+/**
+ * Check the whole matrix, for a graph with more vertices than fit in one
+ * block, against the (unblocked) Floyd-Warshall algorithm.
+ */
+template <typename T_Length>
+static void
+test_blocked_matrix(
+  const type_vec_nodes& vertices, std::size_t threads_count = 1) {
+  const auto vertices_count = vertices.size();
+  std::vector<std::vector<type_length>> expected(vertices_count,
+    std::vector<type_length>(vertices_count, LENGTH_INFINITY));
+  for (type_num i = 0; i < vertices_count; ++i) {
+    expected[i][i] = 0;
+    for (const auto& edge : vertices[i].edges_) {
+      auto& length = expected[i][edge.destination_vertex_];
+      length = std::min(length, edge.length_);
+    }
+  }
+
+  for (type_num k = 0; k < vertices_count; ++k) {
+    for (type_num i = 0; i < vertices_count; ++i) {
+      for (type_num j = 0; j < vertices_count; ++j) {
+        if (expected[i][k] != LENGTH_INFINITY &&
+            expected[k][j] != LENGTH_INFINITY) {
+          expected[i][j] =
+            std::min(expected[i][j], expected[i][k] + expected[k][j]);
+        }
+      }
+    }
+  }
+
+  ThreadPool thread_pool(threads_count);
+  BasicDistanceMatrix<T_Length> matrix;
+  assert(floyd_warshall_blocked_compute(vertices, matrix, thread_pool));
+  assert(matrix.size() == vertices_count);
+  for (type_num i = 0; i < vertices_count; ++i) {
+    for (type_num j = 0; j < vertices_count; ++j) {
+      assert(matrix.get_length(i, j) == expected[i][j]);
+    }
+  }
+}
+
+/**
+ * Build a graph with pseudo-random edges, some of them negative,
+ * but with no negative cycles, because the negative edges only lead from
+ * lower numbered vertices to higher numbered vertices, and the edges back
+ * are longer than any path of negative edges.
+ */
+static type_vec_nodes
+make_graph_without_negative_cycles(type_num vertices_count) {
+  type_vec_nodes result(vertices_count);
+  for (type_num i = 0; i < vertices_count; ++i) {
+    for (type_num j = 0; j < vertices_count; ++j) {
+      const auto hash = (i * 7919 + j * 104729) % 31;
+      if (i != j && hash < 3) {
+        const type_length length =
+          i < j ? static_cast<type_length>(hash * 13 % 17) - 5 : hash + 1000;
+        result[i].edges_.emplace_back(j, length);
+      }
+    }
+  }
+
+  return result;
 }
 
 int
 main() {
   test_apsp(EXAMPLE_GRAPH_SMALL, 0);
   test_apsp(EXAMPLE_GRAPH_SMALL_WITH_NEGATIVE_EDGES, -10003);
-  test_apsp(EXAMPLE_GRAPH_LARGER_WITH_NEGATIVE_EDGES, -4);
+  test_apsp(EXAMPLE_GRAPH_LARGER_WITH_NEGATIVE_EDGES, -7);
+
+  test_blocked_matrix<type_length>(EXAMPLE_GRAPH_LARGER_WITH_NEGATIVE_EDGES);
+  test_blocked_matrix<type_length>(make_graph_without_negative_cycles(150));
+  test_blocked_matrix<std::int32_t>(make_graph_without_negative_cycles(150));
+
+  for (const std::size_t threads_count : {2, 3, 4}) {
+    test_blocked_matrix<type_length>(
+      make_graph_without_negative_cycles(300), threads_count);
+  }
+
+  // A negative cycle, between the first and last blocks:
+  auto graph = make_graph_without_negative_cycles(150);
+  graph[149].edges_.emplace_back(0, -1000);
+  bool has_negative_cycles = false;
+  floyd_warshall_blocked_calc_all_pairs_shortest_path(
+    graph, has_negative_cycles);
+  assert(has_negative_cycles);
+
+  ThreadPool thread_pool(4);
+  has_negative_cycles = false;
+  floyd_warshall_blocked_calc_all_pairs_shortest_path(
+    graph, has_negative_cycles, thread_pool);
+  assert(has_negative_cycles);
 
   return EXIT_SUCCESS;
 }
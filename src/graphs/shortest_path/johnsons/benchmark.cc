@@ -0,0 +1,73 @@
+#include "johnsons.h"
+#include "utils/benchmark.h"
+#include "utils/random_graphs.h"
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+/**
+ * Usage: murrayc_johnsons_benchmark [vertices_count] [max_threads_count]
+ */
+int
+main(int argc, char** argv) {
+  const auto vertices_count = benchmark_get_arg<type_num>(argc, argv, 1, 4000);
+  const auto max_threads_count = benchmark_get_arg<std::size_t>(
+    argc, argv, 2, std::max(1u, std::thread::hardware_concurrency()));
+
+  auto vertices = make_random_graph(vertices_count, 10 * vertices_count, 1000);
+
+  // Make some edges negative, without adding negative cycles, by only
+  // making edges from lower numbered vertices to higher numbered vertices
+  // negative:
+  for (type_num i = 0; i < vertices_count; ++i) {
+    for (auto& edge : vertices[i].edges_) {
+      if (edge.destination_vertex_ > i && edge.length_ % 4 == 0) {
+        edge.length_ = -edge.length_ / 100;
+      }
+    }
+  }
+
+  std::cout << "vertices: " << vertices_count << std::endl;
+
+  bool has_negative_cycles = false;
+  type_length serial_result = 0;
+  const auto serial_seconds = benchmark_seconds([&] {
+    serial_result =
+      johnsons_all_pairs_shortest_path(vertices, has_negative_cycles);
+  });
+  std::cout << "  minimum, 1 thread: " << serial_seconds << "s" << std::endl;
+
+  if (has_negative_cycles) {
+    std::cerr << "Unexpected negative cycle." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  for (std::size_t threads_count = 2; threads_count <= max_threads_count;
+       threads_count *= 2) {
+    ThreadPool thread_pool(threads_count);
+    type_length threaded_result = 0;
+    const auto threaded_seconds = benchmark_seconds([&] {
+      threaded_result = johnsons_all_pairs_shortest_path(
+        vertices, has_negative_cycles, thread_pool);
+    });
+    std::cout << "  minimum, " << threads_count
+              << " threads: " << threaded_seconds
+              << "s, speedup: " << serial_seconds / threaded_seconds
+              << std::endl;
+
+    if (threaded_result != serial_result) {
+      std::cerr << "The results were not the same." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Keeping the whole matrix needs O(V^2) memory, and writing to it:
+  ThreadPool thread_pool(max_threads_count);
+  DistanceMatrix matrix;
+  const auto matrix_seconds = benchmark_seconds(
+    [&] { johnsons_compute_all_pairs(vertices, matrix, thread_pool); });
+  std::cout << "  whole matrix, " << max_threads_count
+            << " threads: " << matrix_seconds << "s" << std::endl;
+
+  return EXIT_SUCCESS;
+}
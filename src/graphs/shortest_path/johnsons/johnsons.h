@@ -1,8 +1,12 @@
-#include "shortest_path/bellman_ford/bellman_ford.h"
 #include "shortest_path/dijkstra/dijkstra.h"
+#include "shortest_path/parallel_bellman_ford/parallel_bellman_ford.h"
+#include "utils/csr_graph.h"
+#include "utils/distance_matrix.h"
 #include "utils/shortest_path.h"
+#include "utils/thread_pool.h"
 #include <algorithm>
 #include <iostream>
+#include <vector>
 
 // A set of vertices and their edges.
 using type_vec_nodes = std::vector<Vertex>;
@@ -10,109 +14,223 @@ using type_vec_nodes = std::vector<Vertex>;
 using type_num = Edge::type_num;
 using type_length = Edge::type_length;
 
-static type_length
-johnsons_all_pairs_shortest_path(
-  const type_vec_nodes& vertices, bool& has_negative_cycles) {
-  // Initialize ouput variables:
-  has_negative_cycles = false;
-
-  if (vertices.empty())
-    return Edge::LENGTH_INFINITY;
-
+/**
+ * Reweight the edges so that they are all non-negative, without changing
+ * which paths are the shortest, so Dijkstra's algorithm can be used.
+ *
+ * @param vertices_reweighted The graph, with the new edge lengths.
+ * @param potentials The length of the shortest path to each vertex from an
+ * extra vertex s, with zero-length edges to all vertices. Each edge from u to
+ * v gets potentials[u] - potentials[v] added to its length, so the length of
+ * any path from u to v changes by potentials[u] - potentials[v].
+ * @result false if there is a negative cycle.
+ */
+static bool
+johnsons_reweight(const type_vec_nodes& vertices,
+  type_vec_nodes& vertices_reweighted, std::vector<type_length>& potentials,
+  bool& has_negative_cycles, ThreadPool& thread_pool) {
   // Add an extra vertex s, with zero-weight paths to every existing vertex:
   // There will be no paths into vertex s, so it will not disturb any
   // shortest paths calculations from any other vertex.
+  // We only add its edges to the list of edges, instead of copying the whole
+  // graph to add the vertex.
   const auto original_size = vertices.size();
-  type_vec_nodes vertices_with_s = vertices;
-  vertices_with_s.emplace_back();
+  BellmanFordEdgeList edges(vertices);
   const type_num s = original_size;
-  auto& vertex_s = vertices_with_s[s];
+  edges.vertices_count_ = original_size + 1;
   for (type_num i = 0; i < original_size; ++i) {
     // Add a zero-weight edge from our extra s vertex to the other vertex:
-    vertex_s.edges_.emplace_back(i, 0);
+    edges.sources_.emplace_back(s);
+    edges.destinations_.emplace_back(i);
+    edges.lengths_.emplace_back(0);
   }
 
   // Run Bellman-Ford single source shortest path algorithm from our new vertex
-  // s.
+  // s, relaxing the edges in parallel.
   // (We can't use Dijkstra's SSSP algorithm because we can have negative edge
   // lengths).
   // This gives us a value (from s to the vertex) for each vertex:
-  const auto shortest_paths_from_s = bellman_ford_single_source_shortest_paths(
-    vertices_with_s, s, has_negative_cycles);
+  parallel_bellman_ford_compute_lengths(
+    edges, s, potentials, has_negative_cycles, thread_pool);
   if (has_negative_cycles) {
     std::cerr << "Negative cycle found." << std::endl;
-    return Edge::LENGTH_INFINITY;
+    return false;
   }
 
-  // Debug:
-  /*
-  const auto shortest_paths_from_s_count = shortest_paths_from_s.size();
-  for (type_num i = 0; i < shortest_paths_from_s_count; ++i)
-  {
-    const auto& shortest_path = shortest_paths_from_s[i];
-    std::cout << "shortest path from " << s << " to " << i
-      << ": " << shortest_path.length_
-      << ", path: " << shortest_path.path_ << std::endl;
-  }
-  */
+  // Forget the length to s itself:
+  potentials.resize(original_size);
 
   // Reweighting:
   // Change the edge lengths based on the discovered values for each vertex
   //(single source shortest paths from our new vertex s):
   // Now they will all be positive.
-  auto vertices_reweighted = vertices;
-  for (type_num i = 0; i < original_size;
-       ++i) { // Not including the new vertex_s.
-    const auto shortest_path_for_i = shortest_paths_from_s[i].length_;
-
+  vertices_reweighted = vertices;
+  for (type_num i = 0; i < original_size; ++i) {
     auto& vertex = vertices_reweighted[i];
     for (auto& edge : vertex.edges_) {
-      const auto shortest_path_for_dest =
-        shortest_paths_from_s[edge.destination_vertex_].length_;
-
-      // std::cout << "original edge length: " << edge.length_ << std::endl;
-      // std:: cout << "  source=" << i << ", dest=" << edge.destination_vertex_
-      // << std::endl;
-      // std:: cout << "  shortest_path_for_i =" << shortest_path_for_i <<
-      //  ", vertex_dest.shortest_path_for_dest=" <<  shortest_path_for_dest <<
-      //  std::endl;
-      const auto diff = shortest_path_for_i - shortest_path_for_dest;
+      const auto diff = potentials[i] - potentials[edge.destination_vertex_];
       edge.length_ += diff;
-      // std::cout << "new edge length: " << edge.length_ << std::endl;
       if (edge.length_ < 0) {
         std::cerr << "Error: The new edge length should not be negative: "
                   << edge.length_ << std::endl;
-        return Edge::LENGTH_INFINITY;
+        return false;
       }
     }
   }
 
-  // Use Dijkstra's single source shortest path algorithm on each u, v in
-  // the reweighted graph:
-  type_length min = Edge::LENGTH_INFINITY;
-  for (type_num u = 0; u < original_size; ++u) {
-    const auto shortest_path_u = shortest_paths_from_s[u].length_;
-
-    const auto shortest_paths =
-      dijkstra_compute_shortest_paths(vertices_reweighted, u);
-    for (type_num v = 0; v < original_size; ++v) {
-      if (u == v)
-        continue;
-      const auto& shortest_path = shortest_paths[v];
-      const auto shortest_path_v = shortest_paths_from_s[v].length_;
-
-      // std::cout << "u=" << u << ", v=" << v << std::endl;
-      // std::cout << "  shortest_path=" << shortest_path.length_ << std::endl;
-
-      // Convert to the length of the path in the original set of vertices
-      //(with negative edge weights):
-      const auto diff = shortest_path_u - shortest_path_v;
-      const auto real_shortest_path = shortest_path.length_ - diff;
-      if (real_shortest_path < min) {
-        min = real_shortest_path;
+  return true;
+}
+
+/**
+ * Calculate the lengths of the shortest paths from each vertex to all
+ * vertices, with Johnson's algorithm, calling @a callback with each vertex's
+ * lengths as soon as they are known, so the caller can use them, or reduce
+ * them, without keeping all of them at once.
+ *
+ * After reweighting the edges, with one run of the Bellman-Ford algorithm,
+ * with parallel_bellman_ford_compute_lengths(), this runs Dijkstra's
+ * algorithm once from each vertex. Those runs are independent, so they are
+ * shared between the @a thread_pool's threads, with one reusable
+ * DijkstraWorkspace, and one row of lengths, per thread.
+ * So this needs O(V) memory per thread, instead of O(V^2) for the whole
+ * distance matrix.
+ *
+ * @param callback A callable that takes the start vertex, a
+ * std::vector<type_length> with the lengths of the shortest paths from it to
+ * each vertex, or Edge::LENGTH_INFINITY if there is no path, and the
+ * thread_index. This is called on all the thread_pool's threads at once,
+ * so it must only change state that belongs to the start vertex, or to the
+ * thread_index. The lengths are only valid until the callback returns.
+ * @param has_negative_cycles This will be set to true if there is a negative
+ * cycle, in which case @a callback is never called.
+ */
+template <typename T_Callback>
+void
+johnsons_for_each_source(const type_vec_nodes& vertices,
+  const T_Callback& callback, bool& has_negative_cycles,
+  ThreadPool& thread_pool) {
+  // Initialize ouput variables:
+  has_negative_cycles = false;
+
+  if (vertices.empty()) {
+    return;
+  }
+
+  type_vec_nodes vertices_reweighted;
+  std::vector<type_length> potentials;
+  if (!johnsons_reweight(vertices, vertices_reweighted, potentials,
+        has_negative_cycles, thread_pool)) {
+    return;
+  }
+
+  // All the threads run Dijkstra's algorithm on the same graph,
+  // so it is worth converting it to the more compact CSR layout once.
+  const CsrGraph graph(vertices_reweighted);
+
+  const auto vertices_count = vertices.size();
+  const auto threads_count = thread_pool.size();
+  std::vector<DijkstraWorkspace> workspaces(threads_count);
+  std::vector<std::vector<type_length>> rows(
+    threads_count, std::vector<type_length>(vertices_count));
+
+  thread_pool.parallel_for(
+    vertices_count, [&](std::size_t u, std::size_t thread_index) {
+      auto& workspace = workspaces[thread_index];
+      dijkstra_compute(graph, u, u, false /* stop_at_end */, workspace);
+
+      // Convert to the lengths of the paths in the original set of vertices
+      // (with negative edge weights):
+      auto& row = rows[thread_index];
+      for (type_num v = 0; v < vertices_count; ++v) {
+        const auto length = workspace.get_length(v);
+        row[v] = length == Edge::LENGTH_INFINITY
+                   ? Edge::LENGTH_INFINITY
+                   : length - (potentials[u] - potentials[v]);
       }
-    }
+
+      callback(static_cast<type_num>(u), row, thread_index);
+    });
+}
+
+/**
+ * Calculate the lengths of the shortest paths between all pairs of vertices,
+ * with johnsons_for_each_source(), putting them into @a matrix.
+ *
+ * @result false if there is a negative cycle.
+ */
+template <typename T_Length>
+bool
+johnsons_compute_all_pairs(const type_vec_nodes& vertices,
+  BasicDistanceMatrix<T_Length>& matrix, ThreadPool& thread_pool) {
+  using type_matrix_length = T_Length;
+
+  const auto vertices_count = vertices.size();
+  matrix.resize(vertices_count, vertices_count);
+
+  // Each start vertex has its own row, so the threads never write to the
+  // same lengths.
+  bool has_negative_cycles = false;
+  johnsons_for_each_source(vertices,
+    [&matrix, vertices_count](type_num u,
+      const std::vector<type_length>& lengths, std::size_t /* thread_index */) {
+      auto row = matrix.get_row(u);
+      for (type_num v = 0; v < vertices_count; ++v) {
+        if (lengths[v] != Edge::LENGTH_INFINITY) {
+          row[v] = static_cast<type_matrix_length>(lengths[v]);
+        }
+      }
+    },
+    has_negative_cycles, thread_pool);
+
+  return !has_negative_cycles;
+}
+
+/**
+ * Like johnsons_compute_all_pairs(), using only the calling thread.
+ */
+template <typename T_Length>
+bool
+johnsons_compute_all_pairs(
+  const type_vec_nodes& vertices, BasicDistanceMatrix<T_Length>& matrix) {
+  ThreadPool thread_pool(1);
+  return johnsons_compute_all_pairs(vertices, matrix, thread_pool);
+}
+
+/**
+ * Get the length of the shortest of the shortest paths between all pairs of
+ * different vertices, with johnsons_for_each_source().
+ */
+static type_length
+johnsons_all_pairs_shortest_path(const type_vec_nodes& vertices,
+  bool& has_negative_cycles, ThreadPool& thread_pool) {
+  // The minimum found by each thread, so the threads don't need to share one:
+  std::vector<type_length> mins(thread_pool.size(), Edge::LENGTH_INFINITY);
+  johnsons_for_each_source(vertices,
+    [&mins](type_num u, const std::vector<type_length>& lengths,
+      std::size_t thread_index) {
+      auto& min = mins[thread_index];
+      const auto vertices_count = lengths.size();
+      for (type_num v = 0; v < vertices_count; ++v) {
+        if (u != v && lengths[v] < min) {
+          // There is no path from u to v if the length is
+          // Edge::LENGTH_INFINITY, but that is never less than min.
+          min = lengths[v];
+        }
+      }
+    },
+    has_negative_cycles, thread_pool);
+
+  if (has_negative_cycles) {
+    return Edge::LENGTH_INFINITY;
   }
 
-  return min;
+  return *std::min_element(mins.begin(), mins.end());
+}
+
+static type_length
+johnsons_all_pairs_shortest_path(
+  const type_vec_nodes& vertices, bool& has_negative_cycles) {
+  ThreadPool thread_pool(1);
+  return johnsons_all_pairs_shortest_path(
+    vertices, has_negative_cycles, thread_pool);
 }
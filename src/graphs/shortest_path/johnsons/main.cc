@@ -1,23 +1,122 @@
 #include "johnsons.h"
+#include "shortest_path/bellman_ford/bellman_ford.h"
 #include "utils/example_graphs.h"
 #include <cassert>
 #include <cstdlib>
 #include <iostream>
 
-int
-main() {
-  // TODO: This implementation seems to be incorrect.
-  // It gets different values than the floyd warshall version.
+static void
+test_apsp(
+  const std::vector<Vertex>& graph, type_length expected_shortest_path) {
   bool has_negative_cycles = false;
-  const auto shortest_path_length = johnsons_all_pairs_shortest_path(
-    EXAMPLE_GRAPH_SMALL_WITH_NEGATIVE_EDGES, has_negative_cycles);
+  const auto shortest_path_length =
+    johnsons_all_pairs_shortest_path(graph, has_negative_cycles);
   if (has_negative_cycles) {
     std::cout << "Negative cycle found." << std::endl;
   } else {
     std::cout << "Shortest path length: " << shortest_path_length << std::endl;
   }
 
-  assert(shortest_path_length == -10003);
+  assert(shortest_path_length == expected_shortest_path);
+
+  for (const std::size_t threads_count : {2, 3}) {
+    ThreadPool thread_pool(threads_count);
+    bool threaded_has_negative_cycles = false;
+    const auto threaded_shortest_path_length =
+      johnsons_all_pairs_shortest_path(
+        graph, threaded_has_negative_cycles, thread_pool);
+    assert(threaded_has_negative_cycles == has_negative_cycles);
+    assert(threaded_shortest_path_length == expected_shortest_path);
+  }
+}
+
+/**
+ * Check the whole matrix against the Bellman-Ford algorithm from each vertex.
+ */
+static void
+test_matrix(const type_vec_nodes& vertices, std::size_t threads_count) {
+  ThreadPool thread_pool(threads_count);
+  DistanceMatrix matrix;
+  assert(johnsons_compute_all_pairs(vertices, matrix, thread_pool));
+
+  const auto vertices_count = vertices.size();
+  assert(matrix.size() == vertices_count);
+  for (type_num u = 0; u < vertices_count; ++u) {
+    bool has_negative_cycles = false;
+    const auto expected = bellman_ford_single_source_shortest_paths(
+      vertices, u, has_negative_cycles);
+    assert(!has_negative_cycles);
+    for (type_num v = 0; v < vertices_count; ++v) {
+      assert(matrix.get_length(u, v) == expected.get_length(v));
+    }
+  }
+
+  // The callback should be called exactly once for each start vertex,
+  // with the same lengths:
+  std::vector<int> calls_counts(vertices_count, 0);
+  bool has_negative_cycles = false;
+  johnsons_for_each_source(vertices,
+    [&](type_num u, const std::vector<type_length>& lengths,
+      std::size_t thread_index) {
+      assert(thread_index < threads_count);
+      ++calls_counts[u];
+      for (type_num v = 0; v < vertices_count; ++v) {
+        assert(lengths[v] == matrix.get_length(u, v));
+      }
+    },
+    has_negative_cycles, thread_pool);
+  assert(!has_negative_cycles);
+  for (const auto calls_count : calls_counts) {
+    assert(calls_count == 1);
+  }
+}
+
+/**
+ * Build a graph with pseudo-random edges, some of them negative,
+ * but with no negative cycles, because the negative edges only lead from
+ * lower numbered vertices to higher numbered vertices, and the edges back
+ * are longer than any path of negative edges.
+ */
+static type_vec_nodes
+make_graph_without_negative_cycles(type_num vertices_count) {
+  type_vec_nodes result(vertices_count);
+  for (type_num i = 0; i < vertices_count; ++i) {
+    for (type_num j = 0; j < vertices_count; ++j) {
+      const auto hash = (i * 7919 + j * 104729) % 31;
+      if (i != j && hash < 3) {
+        const type_length length =
+          i < j ? static_cast<type_length>(hash * 13 % 17) - 5 : hash + 1000;
+        result[i].edges_.emplace_back(j, length);
+      }
+    }
+  }
+
+  return result;
+}
+
+int
+main() {
+  test_apsp(EXAMPLE_GRAPH_SMALL_WITH_NEGATIVE_EDGES, -10003);
+
+  // The same as the Floyd-Warshall algorithm:
+  test_apsp(EXAMPLE_GRAPH_LARGER_WITH_NEGATIVE_EDGES, -7);
+
+  for (const std::size_t threads_count : {1, 2, 4}) {
+    test_matrix(EXAMPLE_GRAPH_SMALL_WITH_NEGATIVE_EDGES, threads_count);
+    test_matrix(EXAMPLE_GRAPH_LARGER_WITH_NEGATIVE_EDGES, threads_count);
+    test_matrix(make_graph_without_negative_cycles(100), threads_count);
+  }
+
+  // A negative cycle:
+  auto graph = make_graph_without_negative_cycles(100);
+  graph[99].edges_.emplace_back(0, -1000);
+  bool has_negative_cycles = false;
+  johnsons_all_pairs_shortest_path(graph, has_negative_cycles);
+  assert(has_negative_cycles);
+
+  ThreadPool thread_pool(4);
+  DistanceMatrix matrix;
+  assert(!johnsons_compute_all_pairs(graph, matrix, thread_pool));
 
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,60 @@
+#include "k_shortest_paths.h"
+#include "utils/benchmark.h"
+#include "utils/random_graphs.h"
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * Find the @a k shortest paths between some pairs of vertices.
+ */
+static void
+benchmark_k(const std::string& name, const type_vec_nodes& vertices,
+  std::size_t k) {
+  const CsrGraph graph(vertices);
+  const auto reverse_graph = make_reverse_csr_graph(graph);
+  DijkstraWorkspace workspace;
+  const type_num queries_count = 5;
+  const type_num step = vertices.size() / queries_count;
+
+  std::size_t paths_count = 0;
+  type_length longest = 0;
+  const auto seconds = benchmark_seconds([&] {
+    for (type_num i = 0; i < queries_count; ++i) {
+      const auto paths = yen_k_shortest_paths(graph, reverse_graph, i * step,
+        vertices.size() - 1 - i * step, k, workspace);
+      paths_count += paths.size();
+      if (!paths.empty()) {
+        longest = std::max(longest, paths.back().length_);
+      }
+    }
+  });
+
+  std::cout << name << ", vertices: " << vertices.size() << ", k: " << k
+            << ": " << seconds / queries_count
+            << "s per query, paths found: " << paths_count
+            << ", longest kth path: " << longest << std::endl;
+}
+
+/**
+ * Usage: murrayc_k_shortest_paths_benchmark [vertices_count]
+ */
+int
+main(int argc, char** argv) {
+  const auto vertices_count =
+    benchmark_get_arg<type_num>(argc, argv, 1, 1000000);
+
+  const auto random_graph =
+    make_random_graph(vertices_count, 4 * vertices_count, 1000);
+  benchmark_k("random graph", random_graph, 10);
+  benchmark_k("random graph", random_graph, 100);
+
+  // A road-like network, where the paths are much longer, so there are more
+  // spur paths to search:
+  const type_num width = 1000;
+  const auto grid_graph =
+    make_random_grid_graph(width, vertices_count / width, 1000);
+  benchmark_k("grid graph", grid_graph, 10);
+  benchmark_k("grid graph", grid_graph, 100);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,245 @@
+#ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_K_SHORTEST_PATHS
+#define MURRAYC_ALGORITHMS_EXPERIMENTS_K_SHORTEST_PATHS
+
+#include "shortest_path/astar/astar.h"
+#include "shortest_path/dijkstra/dijkstra.h"
+#include "utils/csr_graph.h"
+#include "utils/shortest_path.h"
+#include "utils/vertex.h"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <set>
+#include <vector>
+
+/**
+ * A path found by yen_k_shortest_paths(), with the length of the path so far
+ * at each of its vertices, so the length of any of its prefixes is known
+ * without looking up its edges again.
+ */
+class YenPath {
+public:
+  YenPath() : deviation_(0) {}
+
+  type_length
+  get_length() const {
+    return lengths_.back();
+  }
+
+  /**
+   * Order by length, and then by the vertices, so that the candidates are
+   * sorted, and the same candidate is only kept once.
+   */
+  bool
+  operator<(const YenPath& other) const {
+    if (get_length() != other.get_length()) {
+      return get_length() < other.get_length();
+    }
+
+    return path_ < other.path_;
+  }
+
+  ShortestPath::type_path path_;
+
+  // The length of the path from the start vertex to each vertex in path_.
+  std::vector<type_length> lengths_;
+
+  // The index, in path_, of the vertex at which this path left the path that
+  // it was derived from.
+  std::size_t deviation_;
+};
+
+/**
+ * Get up to @a k shortest paths from @a start_vertex to @a end_vertex,
+ * in order of length, with Yen's algorithm. The paths are loopless, so they
+ * visit each vertex at most once. There are fewer than @a k paths if there
+ * are fewer than @a k loopless paths.
+ *
+ * Each path after the first is found by taking a prefix, the "root", of an
+ * earlier path, and then finding the shortest "spur" path from the root's
+ * last vertex to @a end_vertex, avoiding the root's other vertices, and
+ * avoiding the next edge of any earlier path that has the same root.
+ * The best of these candidates is the next path.
+ * Each spur path is found with an edge filter that hides those vertices and
+ * edges, so we don't copy the graph for every search, and all searches share
+ * one workspace, so they don't allocate memory either.
+ *
+ * As suggested by Lawler, a path's spur paths only start at or after the
+ * vertex where it left the path that it came from, because the spur paths
+ * from its earlier vertices were already found for that path.
+ *
+ * Hiding vertices and edges can only make the distances to @a end_vertex
+ * longer, so the distances in the whole graph, found once by searching
+ * backwards from @a end_vertex in @a reverse_vertices, are a consistent
+ * heuristic for A*. With it, a spur search only explores the vertices near
+ * its detour, instead of all the vertices closer than @a end_vertex.
+ * Vertices that can't reach @a end_vertex are never explored.
+ *
+ * A path is a sequence of vertices, so several edges from one vertex to
+ * another are treated as just the shortest of them.
+ *
+ * This needs the edge lengths to be non-negative.
+ *
+ * @param reverse_vertices The graph with all edges reversed, for instance
+ * from make_reverse_csr_graph(), which can be reused for many queries.
+ *
+ * @tparam T_Graph For instance, type_vec_nodes or CsrGraph.
+ * @tparam T_Queue The workspace's priority queue.
+ */
+template <typename T_Graph, typename T_ReverseGraph, typename T_Queue>
+std::vector<ShortestPath>
+yen_k_shortest_paths(const T_Graph& vertices,
+  const T_ReverseGraph& reverse_vertices, type_num start_vertex,
+  type_num end_vertex, std::size_t k,
+  BasicDijkstraWorkspace<T_Queue>& workspace) {
+  std::vector<ShortestPath> result;
+  if (k == 0 || start_vertex >= vertices.size() ||
+      !dijkstra_compute(reverse_vertices, end_vertex, end_vertex,
+        false /* stop_at_end */, workspace)) {
+    return result;
+  }
+
+  if (!workspace.is_reached(start_vertex)) {
+    return result;
+  }
+
+  const auto vertices_count = vertices.size();
+  std::vector<type_length> lengths_to_end(vertices_count);
+  for (type_num v = 0; v < vertices_count; ++v) {
+    lengths_to_end[v] = workspace.get_length(v);
+  }
+
+  const auto heuristic = [&lengths_to_end](
+                           type_num v) { return lengths_to_end[v]; };
+
+  // The vertices of the current root, apart from its last vertex,
+  // and the vertices that the spur path may not go to next from the root's
+  // last vertex:
+  std::vector<bool> removed_vertices(vertices_count);
+  std::vector<type_num> removed_next_vertices;
+  type_num spur_vertex = start_vertex;
+  const auto edge_filter = [&](type_num source_vertex, const auto& edge) {
+    const type_num v = edge.destination_vertex_;
+    if (removed_vertices[v] || lengths_to_end[v] == Edge::LENGTH_INFINITY) {
+      return false;
+    }
+
+    return source_vertex != spur_vertex ||
+           std::find(removed_next_vertices.begin(),
+             removed_next_vertices.end(),
+             v) == removed_next_vertices.end();
+  };
+
+  // Find the spur path from spur_vertex, appending it to the root.
+  // @result false if there is no spur path.
+  const auto add_spur_path = [&](YenPath& path) {
+    const auto spur_path = astar_compute_shortest_path(
+      vertices, spur_vertex, end_vertex, heuristic, workspace, edge_filter);
+    if (spur_path.path_.empty()) {
+      return false;
+    }
+
+    const auto root_length = path.lengths_.back();
+    for (std::size_t i = 1; i < spur_path.path_.size(); ++i) {
+      const auto v = spur_path.path_[i];
+      path.path_.emplace_back(v);
+      path.lengths_.emplace_back(root_length + workspace.distances_[v]);
+    }
+
+    return true;
+  };
+
+  // The paths found so far:
+  std::vector<YenPath> paths(1);
+  paths[0].path_.emplace_back(start_vertex);
+  paths[0].lengths_.emplace_back(0);
+  add_spur_path(paths[0]);
+
+  // The candidates for the next path, shortest first:
+  std::set<YenPath> candidates;
+
+  while (paths.size() < k) {
+    const auto& previous = paths.back();
+    const auto& previous_path = previous.path_;
+    const auto previous_size = previous_path.size();
+
+    for (auto i = previous.deviation_; i + 1 < previous_size; ++i) {
+      spur_vertex = previous_path[i];
+
+      for (std::size_t j = 0; j < i; ++j) {
+        removed_vertices[previous_path[j]] = true;
+      }
+
+      removed_next_vertices.clear();
+      for (const auto& path : paths) {
+        if (path.path_.size() > i + 1 &&
+            std::equal(previous_path.begin(), previous_path.begin() + i + 1,
+              path.path_.begin())) {
+          removed_next_vertices.emplace_back(path.path_[i + 1]);
+        }
+      }
+
+      YenPath candidate;
+      candidate.path_.assign(
+        previous_path.begin(), previous_path.begin() + i + 1);
+      candidate.lengths_.assign(
+        previous.lengths_.begin(), previous.lengths_.begin() + i + 1);
+      candidate.deviation_ = i;
+      if (add_spur_path(candidate)) {
+        candidates.emplace(std::move(candidate));
+      }
+
+      for (std::size_t j = 0; j < i; ++j) {
+        removed_vertices[previous_path[j]] = false;
+      }
+    }
+
+    if (candidates.empty()) {
+      break;
+    }
+
+    // Keep only as many candidates as we could still use:
+    while (candidates.size() > k - paths.size()) {
+      candidates.erase(std::prev(candidates.end()));
+    }
+
+    paths.emplace_back(std::move(*candidates.begin()));
+    candidates.erase(candidates.begin());
+  }
+
+  result.reserve(paths.size());
+  for (auto& path : paths) {
+    result.emplace_back(path.get_length(), std::move(path.path_));
+  }
+
+  return result;
+}
+
+/**
+ * Like yen_k_shortest_paths(), building the reverse graph,
+ * with a new workspace.
+ */
+template <typename T_Edge>
+std::vector<ShortestPath>
+yen_k_shortest_paths(const std::vector<BasicVertex<T_Edge>>& vertices,
+  type_num start_vertex, type_num end_vertex, std::size_t k) {
+  const CsrGraph graph(vertices);
+  DijkstraWorkspace workspace;
+  return yen_k_shortest_paths(graph, make_reverse_csr_graph(graph),
+    start_vertex, end_vertex, k, workspace);
+}
+
+/**
+ * Like yen_k_shortest_paths(), building the reverse graph,
+ * with a new workspace.
+ */
+template <typename T_Num, typename T_Length>
+std::vector<ShortestPath>
+yen_k_shortest_paths(const BasicCsrGraph<T_Num, T_Length>& graph,
+  type_num start_vertex, type_num end_vertex, std::size_t k) {
+  DijkstraWorkspace workspace;
+  return yen_k_shortest_paths(graph, make_reverse_csr_graph(graph),
+    start_vertex, end_vertex, k, workspace);
+}
+
+#endif // MURRAYC_ALGORITHMS_EXPERIMENTS_K_SHORTEST_PATHS
@@ -0,0 +1,151 @@
+#include "k_shortest_paths.h"
+#include "utils/csr_graph.h"
+#include "utils/example_graphs.h"
+#include "utils/random_graphs.h"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * Get the lengths of all the loopless paths from @a u to @a end_vertex,
+ * by trying every path, for comparison with yen_k_shortest_paths().
+ */
+static void
+get_all_path_lengths(const type_vec_nodes& vertices, type_num u,
+  type_num end_vertex, type_length length, std::vector<bool>& visited,
+  std::vector<type_length>& result) {
+  if (u == end_vertex) {
+    result.emplace_back(length);
+    return;
+  }
+
+  visited[u] = true;
+
+  // Use only the shortest edge to each vertex:
+  std::vector<type_length> edge_lengths(vertices.size(), Edge::LENGTH_INFINITY);
+  for (const auto& edge : vertices[u].edges_) {
+    auto& edge_length = edge_lengths[edge.destination_vertex_];
+    edge_length = std::min(edge_length, edge.length_);
+  }
+
+  for (type_num v = 0; v < vertices.size(); ++v) {
+    if (!visited[v] && edge_lengths[v] != Edge::LENGTH_INFINITY) {
+      get_all_path_lengths(
+        vertices, v, end_vertex, length + edge_lengths[v], visited, result);
+    }
+  }
+
+  visited[u] = false;
+}
+
+/**
+ * Check that each path is loopless, uses existing edges, has the stated
+ * length, and is different from the other paths.
+ */
+static void
+check_paths(const type_vec_nodes& vertices, type_num start_vertex,
+  type_num end_vertex, const std::vector<ShortestPath>& paths) {
+  for (std::size_t i = 0; i < paths.size(); ++i) {
+    const auto& path = paths[i].path_;
+    assert(path.front() == start_vertex);
+    assert(path.back() == end_vertex);
+
+    std::vector<bool> visited(vertices.size());
+    type_length length = 0;
+    for (std::size_t j = 0; j < path.size(); ++j) {
+      assert(!visited[path[j]]);
+      visited[path[j]] = true;
+
+      if (j + 1 < path.size()) {
+        type_length edge_length = Edge::LENGTH_INFINITY;
+        for (const auto& edge : vertices[path[j]].edges_) {
+          if (edge.destination_vertex_ == path[j + 1]) {
+            edge_length = std::min(edge_length, edge.length_);
+          }
+        }
+
+        assert(edge_length != Edge::LENGTH_INFINITY);
+        length += edge_length;
+      }
+    }
+
+    assert(length == paths[i].length_);
+
+    for (std::size_t j = 0; j < i; ++j) {
+      assert(paths[j].path_ != path);
+    }
+  }
+}
+
+static void
+test_small() {
+  const auto paths = yen_k_shortest_paths(EXAMPLE_GRAPH_SMALL, 0, 3, 10);
+  assert(paths.size() == 3);
+  assert(paths[0].length_ == 5);
+  assert(paths[0].path_ == ShortestPath::type_path({0, 1, 3}));
+  assert(paths[1].length_ == 53);
+  assert(paths[1].path_ == ShortestPath::type_path({0, 2, 3}));
+  assert(paths[2].length_ == 54);
+  assert(paths[2].path_ == ShortestPath::type_path({0, 1, 2, 3}));
+
+  const auto two_paths = yen_k_shortest_paths(EXAMPLE_GRAPH_SMALL, 0, 3, 2);
+  assert(two_paths.size() == 2);
+  assert(two_paths[1].length_ == 53);
+
+  // No path:
+  assert(yen_k_shortest_paths(EXAMPLE_GRAPH_SMALL, 3, 0, 10).empty());
+  assert(yen_k_shortest_paths(EXAMPLE_GRAPH_SMALL, 0, 3, 0).empty());
+
+  // The start vertex is the end vertex:
+  const auto empty_path = yen_k_shortest_paths(EXAMPLE_GRAPH_SMALL, 2, 2, 10);
+  assert(empty_path.size() == 1);
+  assert(empty_path[0].length_ == 0);
+  assert(empty_path[0].path_ == ShortestPath::type_path({2}));
+
+  const CsrGraph graph(EXAMPLE_GRAPH_SMALL);
+  const auto csr_paths = yen_k_shortest_paths(graph, 0, 3, 10);
+  assert(csr_paths.size() == 3);
+  assert(csr_paths[2].path_ == ShortestPath::type_path({0, 1, 2, 3}));
+}
+
+static void
+test_random() {
+  DijkstraWorkspace workspace;
+  for (unsigned int seed = 0; seed < 30; ++seed) {
+    const type_num vertices_count = 9;
+    const auto vertices = make_random_graph(vertices_count, 30, 10, seed);
+    const CsrGraph graph(vertices);
+    const auto reverse_graph = make_reverse_csr_graph(graph);
+    const type_num end_vertex = vertices_count - 1;
+
+    std::vector<type_length> expected;
+    std::vector<bool> visited(vertices_count);
+    get_all_path_lengths(vertices, 0, end_vertex, 0, visited, expected);
+    std::sort(expected.begin(), expected.end());
+
+    for (const std::size_t k : {1, 5, 50, 100000}) {
+      const auto paths = yen_k_shortest_paths(
+        graph, reverse_graph, 0, end_vertex, k, workspace);
+      assert(paths.size() == std::min(k, expected.size()));
+      check_paths(vertices, 0, end_vertex, paths);
+
+      for (std::size_t i = 0; i < paths.size(); ++i) {
+        assert(paths[i].length_ == expected[i]);
+      }
+    }
+  }
+}
+
+int
+main() {
+  const auto paths = yen_k_shortest_paths(EXAMPLE_GRAPH_SMALL, 0, 3, 10);
+  for (const auto& path : paths) {
+    std::cout << "path from 0 to 3: " << path.length_
+              << ", path: " << path.get_path_string() << std::endl;
+  }
+
+  test_small();
+  test_random();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,110 @@
+#include "multi_source_shortest_paths.h"
+#include "shortest_path/dijkstra/dijkstra.h"
+#include "utils/benchmark.h"
+#include "utils/csr_graph.h"
+#include "utils/random_graphs.h"
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * Compare one multi-source search, from 64 sources, with 64 single-source
+ * searches, each reusing one workspace.
+ * @result false if the results were not the same.
+ */
+static bool
+benchmark_graph(const std::string& name, const CsrGraph& graph) {
+  const auto vertices_count = graph.size();
+  std::cout << name << ", vertices: " << vertices_count
+            << ", edges: " << graph.edges_count() << std::endl;
+
+  std::vector<type_num> sources;
+  for (type_num i = 0; i < MULTI_SOURCE_MAX_SOURCES; ++i) {
+    sources.emplace_back((i * 104729) % vertices_count);
+  }
+
+  std::vector<std::vector<type_num>> expected_depths;
+  BfsWorkspace bfs_workspace;
+  const auto bfs_seconds = benchmark_seconds([&] {
+    for (const auto source : sources) {
+      bfs_compute(graph, source, 0, false, bfs_workspace);
+      expected_depths.emplace_back(bfs_workspace.depths_);
+    }
+  });
+
+  MultiSourceBfsWorkspace multi_source_bfs_workspace;
+  const auto multi_source_bfs_seconds = benchmark_seconds([&] {
+    multi_source_bfs_compute(graph, sources, multi_source_bfs_workspace);
+  });
+
+  std::cout << "  64 x bfs_compute(): " << bfs_seconds << "s" << std::endl;
+  std::cout << "  multi_source_bfs_compute(): " << multi_source_bfs_seconds
+            << "s, speedup: " << bfs_seconds / multi_source_bfs_seconds
+            << std::endl;
+
+  std::vector<std::vector<type_length>> expected_lengths;
+  DijkstraWorkspace dijkstra_workspace;
+  const auto dijkstra_seconds = benchmark_seconds([&] {
+    for (const auto source : sources) {
+      expected_lengths.emplace_back(
+        dijkstra_compute_shortest_paths(graph, source, dijkstra_workspace)
+          .lengths_);
+    }
+  });
+
+  MultiSourceDijkstraWorkspace multi_source_dijkstra_workspace;
+  const auto multi_source_dijkstra_seconds = benchmark_seconds([&] {
+    multi_source_dijkstra_compute(
+      graph, sources, multi_source_dijkstra_workspace);
+  });
+
+  std::cout << "  64 x dijkstra_compute_shortest_paths(): " << dijkstra_seconds
+            << "s" << std::endl;
+  std::cout << "  multi_source_dijkstra_compute(): "
+            << multi_source_dijkstra_seconds << "s, speedup: "
+            << dijkstra_seconds / multi_source_dijkstra_seconds << std::endl;
+
+  for (std::size_t i = 0; i < sources.size(); ++i) {
+    for (type_num v = 0; v < vertices_count; ++v) {
+      if (multi_source_bfs_workspace.get_depth(i, v) !=
+            expected_depths[i][v] ||
+          multi_source_dijkstra_workspace.get_length(i, v) !=
+            expected_lengths[i][v]) {
+        std::cerr << "The results were not the same." << std::endl;
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Usage: murrayc_multi_source_shortest_paths_benchmark [scale]
+ * [max_length]
+ */
+int
+main(int argc, char** argv) {
+  const auto scale = benchmark_get_arg<unsigned int>(argc, argv, 1, 18);
+  const auto max_length = benchmark_get_arg<type_length>(argc, argv, 2, 10);
+
+  if (!benchmark_graph("R-MAT graph",
+        CsrGraph(make_rmat_graph(scale, 16, max_length)))) {
+    return EXIT_FAILURE;
+  }
+
+  const type_num vertices_count = type_num(1) << scale;
+  if (!benchmark_graph("random graph",
+        CsrGraph(make_random_graph(
+          vertices_count, 8 * vertices_count, max_length)))) {
+    return EXIT_FAILURE;
+  }
+
+  const type_num width = 512;
+  if (!benchmark_graph("grid graph",
+        CsrGraph(make_random_grid_graph(
+          width, vertices_count / width, max_length)))) {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,112 @@
+#include "multi_source_shortest_paths.h"
+#include "shortest_path/dijkstra/dijkstra.h"
+#include "utils/csr_graph.h"
+#include "utils/example_graphs.h"
+#include "utils/random_graphs.h"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+template <typename T_Graph>
+static void
+check_bfs(const T_Graph& vertices, const std::vector<type_num>& sources) {
+  const auto depths = multi_source_bfs_compute_depths(vertices, sources);
+  assert(depths.size() == sources.size());
+
+  BfsWorkspace expected;
+  for (std::size_t i = 0; i < sources.size(); ++i) {
+    assert(bfs_compute(vertices, sources[i], 0, false, expected));
+    assert(depths[i] == expected.depths_);
+  }
+}
+
+template <typename T_Graph>
+static void
+check_dijkstra(const T_Graph& vertices, const std::vector<type_num>& sources) {
+  const auto lengths = multi_source_dijkstra_compute_lengths(vertices, sources);
+  assert(lengths.size() == sources.size());
+
+  DijkstraWorkspace workspace;
+  for (std::size_t i = 0; i < sources.size(); ++i) {
+    const auto expected =
+      dijkstra_compute_shortest_paths(vertices, sources[i], workspace);
+    assert(lengths[i] == expected.lengths_);
+  }
+}
+
+static void
+test_small() {
+  const std::vector<type_num> sources = {0, 1, 2, 3};
+  check_bfs(EXAMPLE_GRAPH_SMALL, sources);
+  check_dijkstra(EXAMPLE_GRAPH_SMALL, sources);
+
+  MultiSourceDijkstraWorkspace workspace;
+  assert(multi_source_dijkstra_compute(EXAMPLE_GRAPH_SMALL, {0, 1}, workspace));
+  assert(workspace.get_length(0, 3) == 5);
+  assert(workspace.get_length(1, 3) == 2);
+  assert(workspace.get_length(1, 0) == Edge::LENGTH_INFINITY);
+
+  MultiSourceBfsWorkspace bfs_workspace;
+  assert(multi_source_bfs_compute(EXAMPLE_GRAPH_SMALL, {0, 2}, bfs_workspace));
+  assert(bfs_workspace.get_depth(0, 3) == 2);
+  assert(bfs_workspace.get_depth(1, 3) == 1);
+  assert(bfs_workspace.get_depth(1, 1) == BFS_DEPTH_UNREACHED);
+
+  // The same source more than once:
+  check_bfs(EXAMPLE_GRAPH_SMALL, {1, 1, 0});
+  check_dijkstra(EXAMPLE_GRAPH_SMALL, {1, 1, 0});
+
+  // Invalid sources:
+  assert(!multi_source_bfs_compute(EXAMPLE_GRAPH_SMALL, {0, 4}, bfs_workspace));
+  const std::vector<type_num> too_many(MULTI_SOURCE_MAX_SOURCES + 1, 0);
+  assert(!multi_source_dijkstra_compute(
+    EXAMPLE_GRAPH_SMALL, too_many, workspace));
+  assert(!multi_source_dijkstra_compute(
+    EXAMPLE_GRAPH_SMALL_WITH_NEGATIVE_EDGES, {0}, workspace));
+}
+
+static void
+test_zero_length_edges() {
+  // bfs_compute() ignores zero-length edges, while Dijkstra uses them.
+  const type_vec_nodes graph = {Vertex({Edge(1, 0), Edge(2, 5)}),
+    Vertex({Edge(2, 0), Edge(3, 1)}), Vertex({Edge(3, 0)}), Vertex()};
+  check_bfs(graph, {0, 1, 2, 3});
+  check_dijkstra(graph, {0, 1, 2, 3});
+}
+
+/**
+ * Get more sources than one search can handle, so they are split.
+ */
+static std::vector<type_num>
+get_sources(type_num vertices_count) {
+  std::vector<type_num> result;
+  for (type_num i = 0; i < 150; ++i) {
+    result.emplace_back((i * 7919) % vertices_count);
+  }
+
+  return result;
+}
+
+static void
+test_random() {
+  const auto graph = make_random_graph(3000, 9000, 5);
+  check_bfs(graph, get_sources(graph.size()));
+  check_dijkstra(graph, get_sources(graph.size()));
+
+  const CsrGraph csr_graph(make_rmat_graph(11, 8, 100));
+  check_bfs(csr_graph, get_sources(csr_graph.size()));
+  check_dijkstra(csr_graph, get_sources(csr_graph.size()));
+
+  const auto grid_graph = make_random_grid_graph(50, 60, 3);
+  check_bfs(grid_graph, get_sources(grid_graph.size()));
+  check_dijkstra(grid_graph, get_sources(grid_graph.size()));
+}
+
+int
+main() {
+  test_small();
+  test_zero_length_edges();
+  test_random();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,447 @@
+#ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_MULTI_SOURCE_SHORTEST_PATHS
+#define MURRAYC_ALGORITHMS_EXPERIMENTS_MULTI_SOURCE_SHORTEST_PATHS
+
+#include "shortest_path/breadth_first_search/breadth_first_search.h"
+#include "utils/bit_scan.h"
+#include "utils/shortest_path.h"
+#include "utils/vertex.h"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+using type_num = Edge::type_num;
+using type_length = Edge::type_length;
+
+// The most sources that one multi-source search can handle, with one bit per
+// source in each vertex's mask.
+constexpr std::size_t MULTI_SOURCE_MAX_SOURCES = 64;
+
+/**
+ * Check that there are not too many sources, and that they are all in the
+ * graph.
+ */
+static bool
+multi_source_check_sources(
+  std::size_t vertices_count, const std::vector<type_num>& sources) {
+  if (sources.size() > MULTI_SOURCE_MAX_SOURCES) {
+    std::cerr << "too many sources for one search: " << sources.size()
+              << std::endl;
+    return false;
+  }
+
+  for (const auto source : sources) {
+    if (source >= vertices_count) {
+      std::cerr << "start vertex not found in vertices: " << source
+                << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * The arrays used by multi_source_bfs_compute(), which can be reused by
+ * many calls, so repeated searches don't allocate any memory.
+ *
+ * The depths from all the sources to one vertex are next to each other,
+ * so a vertex that is reached from several sources in the same level has its
+ * depths written to the same cache line.
+ */
+class MultiSourceBfsWorkspace {
+public:
+  MultiSourceBfsWorkspace() : sources_count_(0) {}
+
+  /**
+   * The number of edges on the path from the source with index
+   * @a source_index to @a v, or BFS_DEPTH_UNREACHED.
+   */
+  type_num
+  get_depth(std::size_t source_index, type_num v) const {
+    return depths_[v * sources_count_ + source_index];
+  }
+
+  std::size_t sources_count_;
+
+  // The depth of each vertex from each source, with a row per vertex.
+  std::vector<type_num> depths_;
+
+  // A bit per source, for each vertex, set when the source has reached the
+  // vertex.
+  std::vector<std::uint64_t> seen_;
+
+  // The sources whose searches reached each vertex in the current level,
+  // and in the next level.
+  std::vector<std::uint64_t> visit_;
+  std::vector<std::uint64_t> visit_next_;
+
+  // The vertices with any bits in visit_, and in visit_next_.
+  std::vector<type_num> frontier_;
+  std::vector<type_num> next_frontier_;
+};
+
+/**
+ * Calculate the same depths as bfs_compute() from each of up to 64
+ * @a sources, in one traversal, as in the MS-BFS algorithm (Then et al.,
+ * "The More the Merrier: Efficient Multi-Source Graph Traversal").
+ *
+ * Each vertex has a 64-bit mask of the searches that reach it in the current
+ * level, so when several searches reach the same vertex in the same level,
+ * which is common in small-world graphs, its edges are read only once for all
+ * of them, and each edge passes all of them on with a few bitwise operations.
+ * In graphs with a large diameter, such as grids, the searches rarely reach a
+ * vertex in the same level, so separate bfs_compute() calls are faster.
+ *
+ * Like bfs_compute(), this ignores zero-length edges.
+ *
+ * @result false if there are more than 64 sources, or a source is not in the
+ * graph.
+ *
+ * @tparam T_Graph For instance, type_vec_nodes or CsrGraph.
+ */
+template <typename T_Graph>
+bool
+multi_source_bfs_compute(const T_Graph& vertices,
+  const std::vector<type_num>& sources, MultiSourceBfsWorkspace& workspace) {
+  const auto vertices_count = vertices.size();
+  if (!multi_source_check_sources(vertices_count, sources)) {
+    return false;
+  }
+
+  const auto sources_count = sources.size();
+  workspace.sources_count_ = sources_count;
+
+  auto& depths = workspace.depths_;
+  auto& seen = workspace.seen_;
+  auto& visit = workspace.visit_;
+  auto& visit_next = workspace.visit_next_;
+  auto& frontier = workspace.frontier_;
+  auto& next_frontier = workspace.next_frontier_;
+  depths.assign(vertices_count * sources_count, BFS_DEPTH_UNREACHED);
+  seen.assign(vertices_count, 0);
+  visit.assign(vertices_count, 0);
+  visit_next.assign(vertices_count, 0);
+  frontier.clear();
+  next_frontier.clear();
+
+  for (std::size_t i = 0; i < sources_count; ++i) {
+    const auto source = sources[i];
+    if (visit[source] == 0) {
+      frontier.emplace_back(source);
+    }
+
+    const auto bit = std::uint64_t(1) << i;
+    seen[source] |= bit;
+    visit[source] |= bit;
+    depths[source * sources_count + i] = 0;
+  }
+
+  type_num depth = 0;
+  while (!frontier.empty()) {
+    ++depth;
+
+    for (const auto u : frontier) {
+      const auto searches = visit[u];
+      for (const auto& edge : vertices[u].edges_) {
+        // Ignore zero-length edges.
+        if (edge.length_ == 0) {
+          continue;
+        }
+
+        const type_num v = edge.destination_vertex_;
+        const auto new_searches = searches & ~seen[v];
+        if (new_searches == 0) {
+          continue;
+        }
+
+        if (visit_next[v] == 0) {
+          next_frontier.emplace_back(v);
+        }
+
+        visit_next[v] |= new_searches;
+        seen[v] |= new_searches;
+      }
+
+      visit[u] = 0;
+    }
+
+    for (const auto v : next_frontier) {
+      auto* const vertex_depths = depths.data() + v * sources_count;
+      for (auto bits = visit_next[v]; bits != 0; bits &= bits - 1) {
+        vertex_depths[count_trailing_zeros(bits)] = depth;
+      }
+    }
+
+    // visit_ is now all zeros, so it can be the next level's visit_next_.
+    std::swap(visit, visit_next);
+    std::swap(frontier, next_frontier);
+    next_frontier.clear();
+  }
+
+  return true;
+}
+
+/**
+ * Like multi_source_bfs_compute(), for any number of @a sources, 64 at a
+ * time, returning the depths from each source.
+ */
+template <typename T_Graph>
+std::vector<std::vector<type_num>>
+multi_source_bfs_compute_depths(
+  const T_Graph& vertices, const std::vector<type_num>& sources) {
+  const auto vertices_count = vertices.size();
+  std::vector<std::vector<type_num>> result;
+  MultiSourceBfsWorkspace workspace;
+  for (std::size_t begin = 0; begin < sources.size();
+       begin += MULTI_SOURCE_MAX_SOURCES) {
+    const auto end =
+      std::min(begin + MULTI_SOURCE_MAX_SOURCES, sources.size());
+    const std::vector<type_num> batch(
+      sources.begin() + begin, sources.begin() + end);
+    if (!multi_source_bfs_compute(vertices, batch, workspace)) {
+      return std::vector<std::vector<type_num>>();
+    }
+
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+      std::vector<type_num> depths(vertices_count);
+      for (type_num v = 0; v < vertices_count; ++v) {
+        depths[v] = workspace.get_depth(i, v);
+      }
+
+      result.emplace_back(std::move(depths));
+    }
+  }
+
+  return result;
+}
+
+/**
+ * The element for the priority queue of multi_source_dijkstra_compute():
+ * A vertex, and the searches that could reach it with a path of this length.
+ */
+class MultiSourceDijkstraEntry {
+public:
+  MultiSourceDijkstraEntry(
+    type_num vertex, std::uint64_t searches, type_length total_length)
+  : vertex_(vertex), searches_(searches), total_length_(total_length) {}
+
+  type_num vertex_;
+  std::uint64_t searches_;
+  type_length total_length_;
+};
+
+/**
+ * The arrays used by multi_source_dijkstra_compute(), which can be reused by
+ * many calls, so repeated searches don't allocate any memory.
+ *
+ * As in MultiSourceBfsWorkspace, the lengths from all the sources to one
+ * vertex are next to each other, and the other state needs only two 64-bit
+ * masks (16 bytes) per vertex for all the searches, plus the list of
+ * vertices being settled, instead of a distance, predecessor and epoch per
+ * vertex for each search, so more of the graph's state stays in the cache.
+ */
+class MultiSourceDijkstraWorkspace {
+public:
+  MultiSourceDijkstraWorkspace() : sources_count_(0) {}
+
+  /**
+   * The length of the shortest path from the source with index
+   * @a source_index to @a v, or Edge::LENGTH_INFINITY if there is no path.
+   */
+  type_length
+  get_length(std::size_t source_index, type_num v) const {
+    return lengths_[v * sources_count_ + source_index];
+  }
+
+  std::size_t sources_count_;
+
+  // The length of the shortest path so far to each vertex from each source,
+  // with a row per vertex.
+  std::vector<type_length> lengths_;
+
+  // A bit per source, for each vertex, set when the vertex's shortest path
+  // from the source is known.
+  std::vector<std::uint64_t> settled_;
+
+  // The searches that reach each vertex at the current length,
+  // and the vertices with any bits in settling_.
+  std::vector<std::uint64_t> settling_;
+  std::vector<type_num> settling_vertices_;
+
+  // A binary heap of MultiSourceDijkstraEntry.
+  std::vector<MultiSourceDijkstraEntry> queue_;
+};
+
+/**
+ * Calculate the same lengths as dijkstra_compute_shortest_paths() from each
+ * of up to 64 @a sources, in one traversal.
+ *
+ * Like MS-BFS, each entry in the priority queue has a 64-bit mask of the
+ * searches that reach its vertex with that length. All the entries with the
+ * smallest length are taken from the queue together, and combined per
+ * vertex, so a vertex that several searches reach with the same length has
+ * its edges read only once for all of them. Like dijkstra_compute(), an
+ * edge only adds an entry for the searches for which it gives a shorter path.
+ *
+ * This is most useful when many paths have the same length, for instance in
+ * small-world graphs with small integer lengths. In graphs with a large
+ * diameter, such as road networks or grids, the searches rarely reach a
+ * vertex with the same length, so separate dijkstra_compute() calls are
+ * faster.
+ *
+ * This needs the edge lengths to be non-negative.
+ * This doesn't record the predecessors.
+ *
+ * @result false if there are more than 64 sources, a source is not in the
+ * graph, or there is a negative edge.
+ *
+ * @tparam T_Graph For instance, type_vec_nodes or CsrGraph.
+ */
+template <typename T_Graph>
+bool
+multi_source_dijkstra_compute(const T_Graph& vertices,
+  const std::vector<type_num>& sources,
+  MultiSourceDijkstraWorkspace& workspace) {
+  const auto vertices_count = vertices.size();
+  if (!multi_source_check_sources(vertices_count, sources)) {
+    return false;
+  }
+
+  for (std::size_t v = 0; v < vertices_count; ++v) {
+    for (const auto& edge : vertices[v].edges_) {
+      if (edge.length_ < 0) {
+        std::cerr << "multi_source_dijkstra_compute(): "
+                     "negative edge lengths are not supported."
+                  << std::endl;
+        return false;
+      }
+    }
+  }
+
+  const auto sources_count = sources.size();
+  workspace.sources_count_ = sources_count;
+
+  auto& lengths = workspace.lengths_;
+  auto& settled = workspace.settled_;
+  auto& settling = workspace.settling_;
+  auto& settling_vertices = workspace.settling_vertices_;
+  auto& queue = workspace.queue_;
+  lengths.assign(vertices_count * sources_count, Edge::LENGTH_INFINITY);
+  settled.assign(vertices_count, 0);
+  settling.assign(vertices_count, 0);
+  settling_vertices.clear();
+  queue.clear();
+
+  const auto compare = [](const MultiSourceDijkstraEntry& a,
+                         const MultiSourceDijkstraEntry& b) {
+    return a.total_length_ > b.total_length_;
+  };
+
+  for (std::size_t i = 0; i < sources_count; ++i) {
+    lengths[sources[i] * sources_count + i] = 0;
+    queue.emplace_back(sources[i], std::uint64_t(1) << i, 0);
+    std::push_heap(queue.begin(), queue.end(), compare);
+  }
+
+  while (!queue.empty()) {
+    // Take all the entries with the smallest length,
+    // combining the searches for each vertex:
+    const auto length = queue.front().total_length_;
+    while (!queue.empty() && queue.front().total_length_ == length) {
+      std::pop_heap(queue.begin(), queue.end(), compare);
+      const auto& entry = queue.back();
+      const auto v = entry.vertex_;
+
+      // Ignore the searches that have since found a shorter path to v:
+      auto searches = entry.searches_ & ~settled[v];
+      const auto* const vertex_lengths = lengths.data() + v * sources_count;
+      for (auto bits = searches; bits != 0; bits &= bits - 1) {
+        const auto i = count_trailing_zeros(bits);
+        if (vertex_lengths[i] != length) {
+          searches &= ~(std::uint64_t(1) << i);
+        }
+      }
+
+      if (searches != 0) {
+        if (settling[v] == 0) {
+          settling_vertices.emplace_back(v);
+        }
+
+        settling[v] |= searches;
+      }
+
+      queue.pop_back();
+    }
+
+    // No shorter path is possible for these searches, because all shorter
+    // entries have been taken.
+    for (const auto u : settling_vertices) {
+      const auto searches = settling[u];
+      settling[u] = 0;
+      settled[u] |= searches;
+
+      for (const auto& edge : vertices[u].edges_) {
+        const type_num v = edge.destination_vertex_;
+        const auto total_length = length + edge.length_;
+
+        // Only the searches for which this is a shorter path to v:
+        std::uint64_t shorter = 0;
+        auto* const vertex_lengths = lengths.data() + v * sources_count;
+        for (auto bits = searches & ~settled[v]; bits != 0;
+             bits &= bits - 1) {
+          const auto i = count_trailing_zeros(bits);
+          if (total_length < vertex_lengths[i]) {
+            vertex_lengths[i] = total_length;
+            shorter |= std::uint64_t(1) << i;
+          }
+        }
+
+        if (shorter != 0) {
+          queue.emplace_back(v, shorter, total_length);
+          std::push_heap(queue.begin(), queue.end(), compare);
+        }
+      }
+    }
+
+    settling_vertices.clear();
+  }
+
+  return true;
+}
+
+/**
+ * Like multi_source_dijkstra_compute(), for any number of @a sources, 64 at a
+ * time, returning the lengths from each source.
+ */
+template <typename T_Graph>
+std::vector<std::vector<type_length>>
+multi_source_dijkstra_compute_lengths(
+  const T_Graph& vertices, const std::vector<type_num>& sources) {
+  const auto vertices_count = vertices.size();
+  std::vector<std::vector<type_length>> result;
+  MultiSourceDijkstraWorkspace workspace;
+  for (std::size_t begin = 0; begin < sources.size();
+       begin += MULTI_SOURCE_MAX_SOURCES) {
+    const auto end =
+      std::min(begin + MULTI_SOURCE_MAX_SOURCES, sources.size());
+    const std::vector<type_num> batch(
+      sources.begin() + begin, sources.begin() + end);
+    if (!multi_source_dijkstra_compute(vertices, batch, workspace)) {
+      return std::vector<std::vector<type_length>>();
+    }
+
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+      std::vector<type_length> lengths(vertices_count);
+      for (type_num v = 0; v < vertices_count; ++v) {
+        lengths[v] = workspace.get_length(i, v);
+      }
+
+      result.emplace_back(std::move(lengths));
+    }
+  }
+
+  return result;
+}
+
+#endif // MURRAYC_ALGORITHMS_EXPERIMENTS_MULTI_SOURCE_SHORTEST_PATHS
@@ -0,0 +1,71 @@
+#include "parallel_bellman_ford.h"
+#include "shortest_path/bellman_ford/bellman_ford.h"
+#include "utils/benchmark.h"
+#include "utils/csr_graph.h"
+#include "utils/random_graphs.h"
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+/**
+ * Usage: murrayc_parallel_bellman_ford_benchmark [vertices_count]
+ * [edges_count] [max_threads_count]
+ */
+int
+main(int argc, char** argv) {
+  const auto vertices_count =
+    benchmark_get_arg<type_num>(argc, argv, 1, 1000000);
+  const auto edges_count =
+    benchmark_get_arg<type_num>(argc, argv, 2, 10 * vertices_count);
+  const auto max_threads_count = benchmark_get_arg<std::size_t>(
+    argc, argv, 3, std::max(1u, std::thread::hardware_concurrency()));
+  std::cout << "vertices: " << vertices_count << ", edges: " << edges_count
+            << std::endl;
+
+  // Negative edges only from higher to lower numbered vertices,
+  // with the edges back long enough to avoid negative cycles.
+  auto vertices = make_random_graph(vertices_count, edges_count, 100);
+  for (type_num i = 0; i < vertices_count; ++i) {
+    for (auto& edge : vertices[i].edges_) {
+      if (edge.destination_vertex_ < i) {
+        edge.length_ -= 20;
+      } else {
+        edge.length_ += 20 * vertices_count;
+      }
+    }
+  }
+
+  const CsrGraph graph(vertices);
+
+  bool has_negative_cycles = false;
+  ShortestPaths expected;
+  const auto serial_seconds = benchmark_seconds([&] {
+    expected =
+      bellman_ford_single_source_shortest_paths(graph, 0, has_negative_cycles);
+  });
+  std::cout << "bellman_ford_single_source_shortest_paths(): "
+            << serial_seconds << "s" << std::endl;
+
+  const BellmanFordEdgeList edges(graph);
+  for (std::size_t threads_count = 1; threads_count <= max_threads_count;
+       threads_count *= 2) {
+    ThreadPool thread_pool(threads_count);
+    std::vector<type_length> lengths;
+    const auto seconds = benchmark_seconds([&] {
+      parallel_bellman_ford_compute_lengths(
+        edges, 0, lengths, has_negative_cycles, thread_pool);
+    });
+    std::cout << "parallel_bellman_ford_compute_lengths(), " << threads_count
+              << " threads: " << seconds
+              << "s, speedup: " << serial_seconds / seconds << std::endl;
+
+    for (type_num v = 0; v < vertices_count; ++v) {
+      if (lengths[v] != expected.get_length(v)) {
+        std::cerr << "The results were not the same." << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
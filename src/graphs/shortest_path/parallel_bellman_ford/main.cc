@@ -0,0 +1,93 @@
+#include "parallel_bellman_ford.h"
+#include "shortest_path/bellman_ford/bellman_ford.h"
+#include "utils/csr_graph.h"
+#include "utils/example_graphs.h"
+#include "utils/random_graphs.h"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * Check the lengths against bellman_ford_single_source_shortest_paths(),
+ * and that each path has the same length.
+ */
+template <typename T_Graph>
+static void
+test_graph(const T_Graph& vertices, type_num start_vertex) {
+  bool has_negative_cycles = false;
+  const auto expected = bellman_ford_single_source_shortest_paths(
+    vertices, start_vertex, has_negative_cycles);
+  assert(!has_negative_cycles);
+
+  for (const std::size_t threads_count : {1, 2, 4}) {
+    ThreadPool thread_pool(threads_count);
+    const auto shortest_paths =
+      parallel_bellman_ford_single_source_shortest_paths(
+        vertices, start_vertex, has_negative_cycles, thread_pool);
+    assert(!has_negative_cycles);
+
+    const auto vertices_count = vertices.size();
+    for (type_num v = 0; v < vertices_count; ++v) {
+      const auto length = shortest_paths.get_length(v);
+      assert(length == expected.get_length(v));
+      if (length == Edge::LENGTH_INFINITY) {
+        continue;
+      }
+
+      // The path's edges should add up to the length:
+      const auto path = shortest_paths.get_path(v);
+      assert(path.front() == start_vertex);
+      assert(path.back() == v);
+      type_length path_length = 0;
+      for (std::size_t i = 0; i + 1 < path.size(); ++i) {
+        auto edge_length = Edge::LENGTH_INFINITY;
+        for (const auto& edge : vertices[path[i]].edges_) {
+          if (edge.destination_vertex_ == path[i + 1]) {
+            edge_length = std::min<type_length>(edge_length, edge.length_);
+          }
+        }
+
+        path_length += edge_length;
+      }
+
+      assert(path_length == length);
+    }
+  }
+}
+
+int
+main() {
+  test_graph(EXAMPLE_GRAPH_SMALL_WITH_NEGATIVE_EDGES, 0);
+  test_graph(EXAMPLE_GRAPH_LARGER_WITH_NEGATIVE_EDGES, 0);
+
+  // Negative edges only from higher to lower numbered vertices,
+  // with the edges back long enough to avoid negative cycles,
+  // and some zero-length edges:
+  auto vertices = make_random_graph(3000, 20000, 100);
+  for (type_num i = 0; i < vertices.size(); ++i) {
+    for (auto& edge : vertices[i].edges_) {
+      if (edge.destination_vertex_ < i) {
+        edge.length_ -= 50;
+      } else {
+        edge.length_ += 50 * vertices.size();
+      }
+    }
+  }
+
+  test_graph(vertices, 0);
+  test_graph(CsrGraph(vertices), 7);
+
+  // A negative cycle, reachable from vertex 0:
+  vertices[0].edges_.emplace_back(1, 1);
+  vertices[1].edges_.emplace_back(2, -5);
+  vertices[2].edges_.emplace_back(1, 1);
+  for (const std::size_t threads_count : {1, 3}) {
+    ThreadPool thread_pool(threads_count);
+    bool has_negative_cycles = false;
+    parallel_bellman_ford_single_source_shortest_paths(
+      vertices, 0, has_negative_cycles, thread_pool);
+    assert(has_negative_cycles);
+  }
+
+  return EXIT_SUCCESS;
+}
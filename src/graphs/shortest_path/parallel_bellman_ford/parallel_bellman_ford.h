@@ -0,0 +1,239 @@
+#ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_PARALLEL_BELLMAN_FORD
+#define MURRAYC_ALGORITHMS_EXPERIMENTS_PARALLEL_BELLMAN_FORD
+
+#include "utils/shortest_path.h"
+#include "utils/thread_pool.h"
+#include "utils/vertex.h"
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <queue>
+#include <vector>
+
+using type_num = Edge::type_num;
+using type_length = Edge::type_length;
+
+/**
+ * All the edges of a graph, in flat arrays, ordered by source vertex,
+ * so each round of parallel_bellman_ford_compute_lengths() can split the
+ * edges evenly between the threads, regardless of how many edges each
+ * vertex has.
+ */
+class BellmanFordEdgeList {
+public:
+  BellmanFordEdgeList() : vertices_count_(0) {}
+
+  /**
+   * @tparam T_Graph For instance, type_vec_nodes or CsrGraph.
+   */
+  template <typename T_Graph>
+  explicit BellmanFordEdgeList(const T_Graph& vertices)
+  : vertices_count_(vertices.size()) {
+    for (type_num u = 0; u < vertices_count_; ++u) {
+      for (const auto& edge : vertices[u].edges_) {
+        sources_.emplace_back(u);
+        destinations_.emplace_back(edge.destination_vertex_);
+        lengths_.emplace_back(edge.length_);
+      }
+    }
+  }
+
+  /**
+   * The number of edges.
+   */
+  std::size_t
+  size() const {
+    return sources_.size();
+  }
+
+  std::size_t vertices_count_;
+  std::vector<type_num> sources_;
+  std::vector<type_num> destinations_;
+  std::vector<type_length> lengths_;
+};
+
+// The number of edges that a thread relaxes at a time.
+constexpr std::size_t PARALLEL_BELLMAN_FORD_CHUNK_SIZE = 4096;
+
+/**
+ * Reduce @a length to @a candidate, if that is smaller, even if other
+ * threads are changing it at the same time.
+ * @result true if the length was reduced.
+ */
+static bool
+parallel_bellman_ford_atomic_min(
+  std::atomic<type_length>& length, type_length candidate) {
+  auto current = length.load(std::memory_order_relaxed);
+  while (candidate < current) {
+    if (length.compare_exchange_weak(
+          current, candidate, std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Calculate the lengths of the shortest paths from @a start_vertex, like
+ * bellman_ford_single_source_shortest_paths(), but relaxing each round's
+ * edges in parallel, sharing them between the @a thread_pool's threads.
+ *
+ * The lengths are updated with an atomic minimum, so the threads don't need
+ * locks. An edge can see a length that another thread has just reduced in
+ * the same round, which only makes the lengths converge sooner, so this still
+ * needs at most V - 1 rounds, and stops as soon as a round changes nothing.
+ *
+ * @param lengths The length of the shortest path to each vertex, or
+ * Edge::LENGTH_INFINITY if there is no path.
+ * @param has_negative_cycles This will be set to true if there is a negative
+ * cycle reachable from @a start_vertex, in which case the lengths are not
+ * meaningful.
+ */
+static void
+parallel_bellman_ford_compute_lengths(const BellmanFordEdgeList& edges,
+  type_num start_vertex, std::vector<type_length>& lengths,
+  bool& has_negative_cycles, ThreadPool& thread_pool) {
+  // Initialize output variables:
+  has_negative_cycles = false;
+  lengths.clear();
+
+  const auto vertices_count = edges.vertices_count_;
+  if (start_vertex >= vertices_count) {
+    std::cerr << "start vertex not found in vertices: " << start_vertex
+              << std::endl;
+    return;
+  }
+
+  // std::atomic can't be copied, so the vector can't be initialized with
+  // a value.
+  std::vector<std::atomic<type_length>> atomic_lengths(vertices_count);
+  for (auto& length : atomic_lengths) {
+    length.store(Edge::LENGTH_INFINITY, std::memory_order_relaxed);
+  }
+
+  atomic_lengths[start_vertex].store(0, std::memory_order_relaxed);
+
+  const auto edges_count = edges.size();
+  const auto chunks_count = (edges_count + PARALLEL_BELLMAN_FORD_CHUNK_SIZE -
+                              1) / PARALLEL_BELLMAN_FORD_CHUNK_SIZE;
+
+  // Whether each thread changed any lengths in the current round,
+  // so the threads don't share one flag:
+  std::vector<char> changed(thread_pool.size());
+
+  const auto relax_all_edges = [&] {
+    std::fill(changed.begin(), changed.end(), 0);
+    thread_pool.parallel_for(
+      chunks_count,
+      [&](std::size_t chunk, std::size_t thread_index) {
+        bool chunk_changed = false;
+        const auto begin = chunk * PARALLEL_BELLMAN_FORD_CHUNK_SIZE;
+        const auto end =
+          std::min(begin + PARALLEL_BELLMAN_FORD_CHUNK_SIZE, edges_count);
+        for (auto e = begin; e < end; ++e) {
+          const auto source_length =
+            atomic_lengths[edges.sources_[e]].load(std::memory_order_relaxed);
+          if (source_length == Edge::LENGTH_INFINITY) {
+            continue;
+          }
+
+          if (parallel_bellman_ford_atomic_min(
+                atomic_lengths[edges.destinations_[e]],
+                source_length + edges.lengths_[e])) {
+            chunk_changed = true;
+          }
+        }
+
+        if (chunk_changed) {
+          changed[thread_index] = 1;
+        }
+      },
+      1);
+
+    return std::find(changed.begin(), changed.end(), 1) != changed.end();
+  };
+
+  // We need at most n-1 rounds.
+  bool converged = false;
+  for (type_num i = 0; i + 1 < vertices_count; ++i) {
+    if (!relax_all_edges()) {
+      converged = true;
+      break;
+    }
+  }
+
+  // Check for a negative cycle:
+  // If one more round still changes a length, then we must have taken a
+  // negative cycle.
+  if (!converged && relax_all_edges()) {
+    has_negative_cycles = true;
+  }
+
+  lengths.resize(vertices_count);
+  for (type_num v = 0; v < vertices_count; ++v) {
+    lengths[v] = atomic_lengths[v].load(std::memory_order_relaxed);
+  }
+}
+
+/**
+ * Get all the shortest paths from @a start_vertex, like
+ * bellman_ford_single_source_shortest_paths(), with
+ * parallel_bellman_ford_compute_lengths().
+ *
+ * The predecessors are not recorded during the rounds, because a thread
+ * could reduce a length just after another thread, leaving the wrong
+ * predecessor. Instead, after the lengths are known, this finds a tree of
+ * "tight" edges, whose length is the difference between the lengths of their
+ * vertices, with a BFS from @a start_vertex, which never takes a cycle of
+ * zero-length edges.
+ *
+ * @tparam T_Graph For instance, type_vec_nodes or CsrGraph.
+ */
+template <typename T_Graph>
+ShortestPaths
+parallel_bellman_ford_single_source_shortest_paths(const T_Graph& vertices,
+  type_num start_vertex, bool& has_negative_cycles, ThreadPool& thread_pool) {
+  std::vector<type_length> lengths;
+  parallel_bellman_ford_compute_lengths(BellmanFordEdgeList(vertices),
+    start_vertex, lengths, has_negative_cycles, thread_pool);
+  if (lengths.empty() || has_negative_cycles) {
+    return ShortestPaths();
+  }
+
+  const auto vertices_count = vertices.size();
+  std::vector<type_num> predecessors(vertices_count, INVALID_PREDECESSOR);
+  std::vector<bool> discovered(vertices_count);
+  std::queue<type_num> queue;
+  queue.emplace(start_vertex);
+  discovered[start_vertex] = true;
+  while (!queue.empty()) {
+    const auto u = queue.front();
+    queue.pop();
+    for (const auto& edge : vertices[u].edges_) {
+      const type_num v = edge.destination_vertex_;
+      if (!discovered[v] && lengths[u] + edge.length_ == lengths[v]) {
+        discovered[v] = true;
+        predecessors[v] = u;
+        queue.emplace(v);
+      }
+    }
+  }
+
+  return ShortestPaths(
+    start_vertex, std::move(lengths), std::move(predecessors));
+}
+
+/**
+ * Like parallel_bellman_ford_single_source_shortest_paths(), using all cores.
+ */
+template <typename T_Graph>
+ShortestPaths
+parallel_bellman_ford_single_source_shortest_paths(
+  const T_Graph& vertices, type_num start_vertex, bool& has_negative_cycles) {
+  ThreadPool thread_pool;
+  return parallel_bellman_ford_single_source_shortest_paths(
+    vertices, start_vertex, has_negative_cycles, thread_pool);
+}
+
+#endif // MURRAYC_ALGORITHMS_EXPERIMENTS_PARALLEL_BELLMAN_FORD
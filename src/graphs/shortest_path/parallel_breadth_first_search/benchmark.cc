@@ -0,0 +1,71 @@
+#include "parallel_breadth_first_search.h"
+#include "utils/benchmark.h"
+#include "utils/csr_graph.h"
+#include "utils/random_graphs.h"
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+/**
+ * Usage: murrayc_parallel_breadth_first_search_benchmark [scale]
+ * [edges_per_vertex] [max_threads_count]
+ *
+ * This reports the number of traversed edges per second (TEPS), counting
+ * the edges of all the reached vertices, as in the Graph500 benchmark.
+ */
+int
+main(int argc, char** argv) {
+  const auto scale = benchmark_get_arg<unsigned int>(argc, argv, 1, 20);
+  const auto edges_per_vertex = benchmark_get_arg<type_num>(argc, argv, 2, 16);
+  const auto max_threads_count = benchmark_get_arg<std::size_t>(
+    argc, argv, 3, std::max(1u, std::thread::hardware_concurrency()));
+
+  const CsrGraph graph(make_rmat_graph(scale, edges_per_vertex, 1000));
+  const auto vertices_count = graph.size();
+  std::cout << "R-MAT scale: " << scale << ", vertices: " << vertices_count
+            << ", edges: " << graph.edges_count() << std::endl;
+
+  // Start from the vertex with most edges, so most of the graph is reached:
+  type_num start_vertex = 0;
+  for (type_num v = 0; v < vertices_count; ++v) {
+    if (graph[v].edges_.size() > graph[start_vertex].edges_.size()) {
+      start_vertex = v;
+    }
+  }
+
+  BfsWorkspace expected;
+  const auto serial_seconds = benchmark_seconds(
+    [&] { bfs_compute(graph, start_vertex, 0, false, expected); });
+
+  std::size_t traversed_edges_count = 0;
+  for (type_num v = 0; v < vertices_count; ++v) {
+    if (expected.is_reached(v)) {
+      traversed_edges_count += graph[v].edges_.size();
+    }
+  }
+
+  std::cout << "traversed edges: " << traversed_edges_count << std::endl;
+  std::cout << "bfs_compute(): " << serial_seconds
+            << "s, TEPS: " << traversed_edges_count / serial_seconds
+            << std::endl;
+
+  ParallelBfsWorkspace workspace;
+  for (std::size_t threads_count = 1; threads_count <= max_threads_count;
+       threads_count *= 2) {
+    ThreadPool thread_pool(threads_count);
+    const auto seconds = benchmark_seconds([&] {
+      parallel_bfs_compute(graph, start_vertex, workspace, thread_pool);
+    });
+    std::cout << "parallel_bfs_compute(), " << threads_count
+              << " threads: " << seconds
+              << "s, TEPS: " << traversed_edges_count / seconds
+              << ", speedup: " << serial_seconds / seconds << std::endl;
+
+    if (workspace.depths_ != expected.depths_) {
+      std::cerr << "The depths were not the same." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
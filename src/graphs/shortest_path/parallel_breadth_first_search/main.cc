@@ -0,0 +1,74 @@
+#include "parallel_breadth_first_search.h"
+#include "utils/csr_graph.h"
+#include "utils/example_graphs.h"
+#include "utils/random_graphs.h"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * Check the depths against bfs_compute(), and that each vertex's predecessor
+ * is an edge from a vertex in the previous level.
+ */
+template <typename T_Graph>
+static void
+test_graph(const T_Graph& vertices, type_num start_vertex) {
+  BfsWorkspace expected;
+  assert(bfs_compute(vertices, start_vertex, 0, false, expected));
+
+  ParallelBfsWorkspace workspace;
+  for (const std::size_t threads_count : {1, 2, 3, 4}) {
+    ThreadPool thread_pool(threads_count);
+
+    // Twice, to check that the workspace can be reused:
+    for (int i = 0; i < 2; ++i) {
+      assert(
+        parallel_bfs_compute(vertices, start_vertex, workspace, thread_pool));
+      assert(workspace.depths_ == expected.depths_);
+    }
+
+    const auto vertices_count = vertices.size();
+    for (type_num v = 0; v < vertices_count; ++v) {
+      if (v == start_vertex || !workspace.is_reached(v)) {
+        continue;
+      }
+
+      const auto& predecessor = workspace.predecessors_[v];
+      assert(
+        workspace.depths_[predecessor.source_] + 1 == workspace.depths_[v]);
+
+      const auto& source = vertices[predecessor.source_];
+      const auto& edge = source.edges_[predecessor.edge_];
+      assert(edge.destination_vertex_ == v);
+      assert(edge.length_ != 0);
+    }
+  }
+}
+
+int
+main() {
+  test_graph(EXAMPLE_GRAPH_SMALL, 0);
+  test_graph(EXAMPLE_GRAPH_SMALL, 2);
+
+  auto vertices = make_random_graph(2000, 10000, 10);
+
+  // Some zero-length edges, which should be ignored:
+  for (auto& vertex : vertices) {
+    for (auto& edge : vertex.edges_) {
+      if (edge.length_ == 1) {
+        edge.length_ = 0;
+      }
+    }
+  }
+
+  test_graph(vertices, 0);
+  test_graph(CsrGraph(vertices), 5);
+
+  const CsrGraph rmat_graph(make_rmat_graph(12, 16, 10));
+  test_graph(rmat_graph, 0);
+
+  assert(parallel_bfs_compute_depths(EXAMPLE_GRAPH_SMALL, 0) ==
+         std::vector<type_num>({0, 1, 1, 2}));
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,185 @@
+#ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_PARALLEL_BFS
+#define MURRAYC_ALGORITHMS_EXPERIMENTS_PARALLEL_BFS
+
+#include "shortest_path/breadth_first_search/breadth_first_search.h"
+#include "utils/thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+/**
+ * The arrays used by parallel_bfs_compute(), which can be reused by many
+ * calls, so repeated searches don't allocate any memory.
+ */
+class ParallelBfsWorkspace {
+public:
+  /**
+   * Whether there is a path to the vertex.
+   */
+  bool
+  is_reached(type_num v) const {
+    return depths_[v] != BFS_DEPTH_UNREACHED;
+  }
+
+  /**
+   * Claim the vertex for the calling thread, by setting its visited bit,
+   * unless another thread has already set it.
+   * @result true if this thread claimed the vertex.
+   */
+  bool
+  claim(type_num v) {
+    auto& word = visited_[v / 64];
+    const auto bit = std::uint64_t(1) << (v % 64);
+    auto expected = word.load(std::memory_order_relaxed);
+    while (true) {
+      if (expected & bit) {
+        return false;
+      }
+
+      if (word.compare_exchange_weak(
+            expected, expected | bit, std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+  }
+
+  // The number of edges from the start vertex, or BFS_DEPTH_UNREACHED.
+  std::vector<type_num> depths_;
+
+  // The edge used to reach each vertex, as in BfsWorkspace.
+  std::vector<SourceAndEdge> predecessors_;
+
+  // A bit per vertex, set by the thread that claims the vertex.
+  std::vector<std::atomic<std::uint64_t>> visited_;
+
+  // The current level.
+  std::vector<type_num> frontier_;
+
+  // The next level, as found by each thread.
+  std::vector<std::vector<type_num>> next_frontiers_;
+};
+
+/**
+ * Calculate the same depths and predecessors as bfs_compute(), with top-down
+ * steps, sharing each level's frontier between the @a thread_pool's threads.
+ *
+ * Several threads can find the same unvisited vertex in one level, so each
+ * vertex is claimed by atomically setting its visited bit, with a
+ * compare-exchange. Only the thread that claimed it writes its depth and
+ * predecessor, and adds it to that thread's part of the next frontier, so
+ * there are no other atomic operations or locks. The predecessor is the edge
+ * used by whichever thread claimed the vertex first, so it can differ between
+ * runs, though it is always from the previous level.
+ *
+ * @result false if the start vertex is not in the graph.
+ *
+ * @tparam T_Graph For instance, type_vec_nodes or CsrGraph.
+ */
+template <typename T_Graph>
+bool
+parallel_bfs_compute(const T_Graph& vertices, type_num start_vertex,
+  ParallelBfsWorkspace& workspace, ThreadPool& thread_pool) {
+  const auto vertices_count = vertices.size();
+  if (start_vertex >= vertices_count) {
+    std::cerr << "start vertex not found in vertices: " << start_vertex
+              << std::endl;
+    return false;
+  }
+
+  const auto threads_count = thread_pool.size();
+  const auto words_count = (vertices_count + 63) / 64;
+
+  auto& depths = workspace.depths_;
+  auto& predecessors = workspace.predecessors_;
+  auto& visited = workspace.visited_;
+  depths.resize(vertices_count);
+  predecessors.resize(vertices_count);
+  if (visited.size() != words_count) {
+    // std::atomic can't be moved, so the vector can't be resized.
+    visited = std::vector<std::atomic<std::uint64_t>>(words_count);
+  }
+
+  workspace.next_frontiers_.resize(threads_count);
+
+  // Initialize the arrays in parallel too, 64 vertices at a time:
+  thread_pool.parallel_for(
+    words_count, [&](std::size_t w, std::size_t /* thread_index */) {
+      visited[w].store(0, std::memory_order_relaxed);
+
+      const auto end = std::min<std::size_t>((w + 1) * 64, vertices_count);
+      std::fill(depths.begin() + w * 64, depths.begin() + end,
+        BFS_DEPTH_UNREACHED);
+    });
+
+  workspace.claim(start_vertex);
+  depths[start_vertex] = 0;
+
+  auto& frontier = workspace.frontier_;
+  frontier.clear();
+  frontier.emplace_back(start_vertex);
+
+  type_num depth = 0;
+  while (!frontier.empty()) {
+    ++depth;
+
+    thread_pool.parallel_for(
+      frontier.size(), [&](std::size_t i, std::size_t thread_index) {
+        auto& next_frontier = workspace.next_frontiers_[thread_index];
+
+        const auto u = frontier[i];
+        const auto& vertex = vertices[u];
+        const auto& edges = vertex.edges_;
+        const auto edges_count = edges.size();
+        for (type_num e = 0; e < edges_count; ++e) {
+          const auto& edge = edges[e];
+
+          // Ignore zero-length edges.
+          if (edge.length_ == 0) {
+            continue;
+          }
+
+          const type_num v = edge.destination_vertex_;
+          if (!workspace.claim(v)) {
+            continue;
+          }
+
+          depths[v] = depth;
+          predecessors[v] = SourceAndEdge(u, e);
+          next_frontier.emplace_back(v);
+        }
+      });
+
+    // Gather the threads' parts of the next frontier, with each thread
+    // copying its own part:
+    std::vector<std::size_t> offsets(threads_count + 1, 0);
+    for (std::size_t t = 0; t < threads_count; ++t) {
+      offsets[t + 1] = offsets[t] + workspace.next_frontiers_[t].size();
+    }
+
+    frontier.resize(offsets.back());
+    thread_pool.run([&](std::size_t thread_index) {
+      auto& next_frontier = workspace.next_frontiers_[thread_index];
+      std::copy(next_frontier.begin(), next_frontier.end(),
+        frontier.begin() + offsets[thread_index]);
+      next_frontier.clear();
+    });
+  }
+
+  return true;
+}
+
+/**
+ * Like parallel_bfs_compute(), using all cores, returning just the depths.
+ */
+template <typename T_Graph>
+std::vector<type_num>
+parallel_bfs_compute_depths(const T_Graph& vertices, type_num start_vertex) {
+  ThreadPool thread_pool;
+  ParallelBfsWorkspace workspace;
+  parallel_bfs_compute(vertices, start_vertex, workspace, thread_pool);
+  return std::move(workspace.depths_);
+}
+
+#endif // MURRAYC_ALGORITHMS_EXPERIMENTS_PARALLEL_BFS
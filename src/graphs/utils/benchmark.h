@@ -0,0 +1,36 @@
+#ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_BENCHMARK
+#define MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_BENCHMARK
+
+#include <boost/timer/timer.hpp>
+#include <cstdlib>
+#include <string>
+
+/**
+ * Call @a func and return how long it took, in (wall clock) seconds.
+ */
+template <typename T_Func>
+double
+benchmark_seconds(T_Func func) {
+  boost::timer::cpu_timer timer;
+  func();
+  timer.stop();
+
+  return timer.elapsed().wall / 1e9;
+}
+
+/**
+ * Get the numeric command-line argument at @a index,
+ * or @a default_value if there is no such argument,
+ * so benchmarks can be run on larger graphs than their defaults.
+ */
+template <typename T_Value>
+T_Value
+benchmark_get_arg(int argc, char** argv, int index, T_Value default_value) {
+  if (index >= argc) {
+    return default_value;
+  }
+
+  return static_cast<T_Value>(std::stoull(argv[index]));
+}
+
+#endif // MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_BENCHMARK
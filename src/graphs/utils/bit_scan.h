@@ -0,0 +1,29 @@
+#ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_BIT_SCAN
+#define MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_BIT_SCAN
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * The index of the lowest set bit of @a x, which must not be 0, for instance
+ * to find each vertex in a 64-bit word of a bitmap of vertices.
+ */
+inline std::size_t
+count_trailing_zeros(std::uint64_t x) {
+  assert(x != 0);
+
+#if defined(__GNUC__)
+  return __builtin_ctzll(static_cast<unsigned long long>(x));
+#else
+  std::size_t result = 0;
+  while ((x & 1) == 0) {
+    x >>= 1;
+    ++result;
+  }
+
+  return result;
+#endif
+}
+
+#endif // MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_BIT_SCAN
@@ -0,0 +1,263 @@
+#ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_CSR_GRAPH
+#define MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_CSR_GRAPH
+
+#include "utils/edge.h"
+#include "utils/vertex.h"
+#include <iterator>
+#include <vector>
+
+/**
+ * An edge, as seen when iterating over the edges of a BasicCsrGraph's vertex.
+ *
+ * This has the same member names as Edge, so the algorithms can use either,
+ * but it is just a copy of the values in the BasicCsrGraph's flat arrays.
+ */
+template <typename T_Num, typename T_Length>
+class BasicCsrEdge {
+public:
+  using type_num = T_Num;
+  using type_length = T_Length;
+
+  BasicCsrEdge(type_num destination_vertex, type_length length)
+  : destination_vertex_(destination_vertex), length_(length) {}
+
+  type_num destination_vertex_;
+  type_length length_;
+};
+
+/**
+ * The edges of one vertex in a BasicCsrGraph.
+ * This has the parts of the std::vector<Edge> API that the algorithms use.
+ */
+template <typename T_Num, typename T_Length>
+class BasicCsrEdges {
+public:
+  using type_num = T_Num;
+  using type_length = T_Length;
+  using type_edge = BasicCsrEdge<T_Num, T_Length>;
+
+  class const_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = type_edge;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const type_edge*;
+    using reference = type_edge;
+
+    const_iterator(const type_num* destination, const type_length* length)
+    : destination_(destination), length_(length) {}
+
+    type_edge
+    operator*() const {
+      return type_edge(*destination_, *length_);
+    }
+
+    const_iterator&
+    operator++() {
+      ++destination_;
+      ++length_;
+      return *this;
+    }
+
+    bool
+    operator==(const const_iterator& other) const {
+      return destination_ == other.destination_;
+    }
+
+    bool
+    operator!=(const const_iterator& other) const {
+      return destination_ != other.destination_;
+    }
+
+  private:
+    const type_num* destination_;
+    const type_length* length_;
+  };
+
+  BasicCsrEdges(const type_num* destinations, const type_length* lengths,
+    std::size_t count)
+  : destinations_(destinations), lengths_(lengths), count_(count) {}
+
+  std::size_t
+  size() const {
+    return count_;
+  }
+
+  bool
+  empty() const {
+    return count_ == 0;
+  }
+
+  type_edge
+  operator[](std::size_t e) const {
+    return type_edge(destinations_[e], lengths_[e]);
+  }
+
+  const_iterator
+  begin() const {
+    return const_iterator(destinations_, lengths_);
+  }
+
+  const_iterator
+  end() const {
+    return const_iterator(destinations_ + count_, lengths_ + count_);
+  }
+
+private:
+  const type_num* destinations_;
+  const type_length* lengths_;
+  std::size_t count_;
+};
+
+/**
+ * A vertex, as seen when accessing a BasicCsrGraph with operator[].
+ */
+template <typename T_Num, typename T_Length>
+class BasicCsrVertex {
+public:
+  explicit BasicCsrVertex(const BasicCsrEdges<T_Num, T_Length>& edges)
+  : edges_(edges) {}
+
+  BasicCsrEdges<T_Num, T_Length> edges_;
+};
+
+/**
+ * A Compressed Sparse Row representation of a graph.
+ *
+ * Instead of one std::vector<Edge> per Vertex, all the edges are stored
+ * contiguously, ordered by their source vertex, so a traversal reads from a
+ * few flat arrays instead of jumping between many small allocations.
+ * The edges of vertex v are at the indices [offsets_[v], offsets_[v + 1]) of
+ * destinations_ and lengths_.
+ *
+ * This mimics the parts of the type_vec_nodes API that the algorithms use
+ * (size(), operator[] and edges_), so the algorithms can be templates that
+ * take either.
+ *
+ * @tparam T_Num The type of the vertex indices.
+ * @tparam T_Length The type of the edge lengths.
+ */
+template <typename T_Num, typename T_Length>
+class BasicCsrGraph {
+public:
+  using type_num = T_Num;
+  using type_length = T_Length;
+
+  BasicCsrGraph() {}
+
+  template <typename T_Edge>
+  explicit BasicCsrGraph(const std::vector<BasicVertex<T_Edge>>& vertices) {
+    const auto vertices_count = vertices.size();
+
+    offsets_.reserve(vertices_count + 1);
+    offsets_.emplace_back(0);
+    for (const auto& vertex : vertices) {
+      offsets_.emplace_back(offsets_.back() + vertex.edges_.size());
+    }
+
+    const auto edges_count = offsets_.back();
+    destinations_.reserve(edges_count);
+    lengths_.reserve(edges_count);
+    for (const auto& vertex : vertices) {
+      for (const auto& edge : vertex.edges_) {
+        destinations_.emplace_back(
+          static_cast<type_num>(edge.destination_vertex_));
+        lengths_.emplace_back(static_cast<type_length>(edge.length_));
+      }
+    }
+  }
+
+  /**
+   * The number of vertices.
+   */
+  std::size_t
+  size() const {
+    return offsets_.empty() ? 0 : offsets_.size() - 1;
+  }
+
+  bool
+  empty() const {
+    return size() == 0;
+  }
+
+  /**
+   * The number of edges, from all vertices.
+   */
+  std::size_t
+  edges_count() const {
+    return destinations_.size();
+  }
+
+  BasicCsrVertex<T_Num, T_Length>
+  operator[](std::size_t v) const {
+    const auto begin = offsets_[v];
+    return BasicCsrVertex<T_Num, T_Length>(
+      BasicCsrEdges<T_Num, T_Length>(destinations_.data() + begin,
+        lengths_.data() + begin, offsets_[v + 1] - begin));
+  }
+
+  // The offsets are indices into the arrays of all edges,
+  // so they are not necessarily of the same type as the vertex indices.
+  std::vector<std::size_t> offsets_;
+  std::vector<type_num> destinations_;
+  std::vector<type_length> lengths_;
+};
+
+using CsrGraph = BasicCsrGraph<Edge::type_num, Edge::type_length>;
+
+/**
+ * Get the graph with all of its edges reversed, so the edges of vertex v are
+ * the edges that lead to v in @a graph, for searching backwards from a vertex.
+ *
+ * This sorts the edges by their destination vertex, in O(n + m) time,
+ * by counting the edges that lead to each vertex.
+ */
+template <typename T_Num, typename T_Length>
+BasicCsrGraph<T_Num, T_Length>
+make_reverse_csr_graph(const BasicCsrGraph<T_Num, T_Length>& graph) {
+  BasicCsrGraph<T_Num, T_Length> result;
+  if (graph.empty()) {
+    return result;
+  }
+
+  const auto vertices_count = graph.size();
+  const auto edges_count = graph.edges_count();
+
+  // Count the edges leading to each vertex,
+  // then add up the counts to get the offsets:
+  result.offsets_.assign(vertices_count + 1, 0);
+  for (const auto destination : graph.destinations_) {
+    ++result.offsets_[destination + 1];
+  }
+
+  for (std::size_t v = 0; v < vertices_count; ++v) {
+    result.offsets_[v + 1] += result.offsets_[v];
+  }
+
+  // The next free position for each vertex's edges:
+  std::vector<std::size_t> positions(
+    result.offsets_.begin(), result.offsets_.end() - 1);
+
+  result.destinations_.resize(edges_count);
+  result.lengths_.resize(edges_count);
+  for (std::size_t v = 0; v < vertices_count; ++v) {
+    for (auto e = graph.offsets_[v]; e < graph.offsets_[v + 1]; ++e) {
+      const auto position = positions[graph.destinations_[e]]++;
+      result.destinations_[position] = static_cast<T_Num>(v);
+      result.lengths_[position] = graph.lengths_[e];
+    }
+  }
+
+  return result;
+}
+
+static_assert(std::is_copy_assignable<CsrGraph>::value,
+  "CsrGraph should be copy assignable.");
+static_assert(std::is_copy_constructible<CsrGraph>::value,
+  "CsrGraph should be copy constructible.");
+static_assert(std::is_move_assignable<CsrGraph>::value,
+  "CsrGraph should be move assignable.");
+static_assert(std::is_move_constructible<CsrGraph>::value,
+  "CsrGraph should be move constructible.");
+
+#endif // MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_CSR_GRAPH
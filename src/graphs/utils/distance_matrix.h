@@ -0,0 +1,88 @@
+#ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_DISTANCE_MATRIX
+#define MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_DISTANCE_MATRIX
+
+#include "utils/edge.h"
+#include <limits>
+#include <vector>
+
+/**
+ * The lengths of the shortest paths between all pairs of vertices,
+ * in one flat, row-major array, so a row is contiguous in memory.
+ *
+ * Each row can be padded to stride_ elements,
+ * so that blocked algorithms can work on whole blocks.
+ *
+ * Instead of the maximum value, "no path" is stored as LENGTH_INFINITY,
+ * which is small enough that adding two of them doesn't overflow, so the
+ * algorithms can add lengths without checking for infinity first.
+ * Adding a (negative) length to it can give a slightly smaller value,
+ * so any length above half of LENGTH_INFINITY is treated as infinity.
+ *
+ * @tparam T_Length The type of the lengths, such as Edge::type_length,
+ * or a smaller type, to fit more lengths into each SIMD register.
+ */
+template <typename T_Length>
+class BasicDistanceMatrix {
+public:
+  using type_length = T_Length;
+
+  static constexpr type_length LENGTH_INFINITY =
+    std::numeric_limits<type_length>::max() / 2;
+
+  BasicDistanceMatrix() : size_(0), stride_(0) {}
+
+  /**
+   * Set all lengths to LENGTH_INFINITY.
+   */
+  void
+  resize(std::size_t size, std::size_t stride) {
+    size_ = size;
+    stride_ = stride;
+    lengths_.assign(stride * stride, LENGTH_INFINITY);
+  }
+
+  /**
+   * The number of vertices.
+   */
+  std::size_t
+  size() const {
+    return size_;
+  }
+
+  static bool
+  is_infinity(type_length length) {
+    return length > LENGTH_INFINITY / 2;
+  }
+
+  type_length*
+  get_row(std::size_t i) {
+    return lengths_.data() + i * stride_;
+  }
+
+  const type_length*
+  get_row(std::size_t i) const {
+    return lengths_.data() + i * stride_;
+  }
+
+  /**
+   * The length of the shortest path from @a i to @a j,
+   * or Edge::LENGTH_INFINITY if there is no path.
+   */
+  Edge::type_length
+  get_length(std::size_t i, std::size_t j) const {
+    const auto length = lengths_[i * stride_ + j];
+    return is_infinity(length) ? Edge::LENGTH_INFINITY
+                               : static_cast<Edge::type_length>(length);
+  }
+
+  std::size_t size_;
+  std::size_t stride_;
+  std::vector<type_length> lengths_;
+};
+
+template <typename T_Length>
+constexpr T_Length BasicDistanceMatrix<T_Length>::LENGTH_INFINITY;
+
+using DistanceMatrix = BasicDistanceMatrix<Edge::type_length>;
+
+#endif // MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_DISTANCE_MATRIX
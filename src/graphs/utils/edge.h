@@ -1,35 +1,47 @@
 #ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_EDGE
 #define MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_EDGE
 
+#include <cstdint>
 #include <limits>
 #include <type_traits>
 
-class Edge {
+/**
+ * An edge, for a graph of BasicVertex.
+ *
+ * @tparam T_Num The type of the vertex indices. For instance, a 32-bit type
+ * makes the edges smaller, for graphs with fewer than 2^32 vertices.
+ * @tparam T_Length The type of the edge lengths (or costs, capacities, etc).
+ */
+template <typename T_Num, typename T_Length>
+class BasicEdge {
 public:
-  using type_num = unsigned long;
+  using type_num = T_Num;
 
   // Can be negative.
-  using type_length = long;
+  using type_length = T_Length;
 
-  // TODO: Use a constexpr here instead of a static variable.
-  // But, with g++ 6.2, the linker complains that it is undefined
-  // when using -O0 to disable optimization.
   static const type_length LENGTH_INFINITY;
 
-  Edge() : destination_vertex_(0), length_(0), reverse_edge_in_dest_(0) {}
+  BasicEdge() : destination_vertex_(0), length_(0) {}
 
-  Edge(type_num destination_vertex, type_length length)
-  : destination_vertex_(destination_vertex),
-    length_(length),
-    reverse_edge_in_dest_(0) {}
+  BasicEdge(type_num destination_vertex, type_length length)
+  : destination_vertex_(destination_vertex), length_(length) {}
 
   type_num destination_vertex_;
   type_length length_; // Or cost, capacity, etc.
-
-  // TODO: This is only used for max-flow algorithms.
-  type_num reverse_edge_in_dest_;
 };
 
+template <typename T_Num, typename T_Length>
+const typename BasicEdge<T_Num, T_Length>::type_length
+  BasicEdge<T_Num, T_Length>::LENGTH_INFINITY =
+    std::numeric_limits<T_Length>::max();
+
+using Edge = BasicEdge<unsigned long, long>;
+
+// A smaller edge, for graphs with fewer than 2^32 vertices,
+// whose lengths fit in 32 bits.
+using CompactEdge = BasicEdge<std::uint32_t, std::int32_t>;
+
 static_assert(
   std::is_copy_assignable<Edge>::value, "Edge should be copy assignable.");
 static_assert(std::is_copy_constructible<Edge>::value,
@@ -39,7 +51,10 @@ static_assert(
 static_assert(std::is_move_constructible<Edge>::value,
   "Edge should be move constructible.");
 
-const Edge::type_length Edge::LENGTH_INFINITY =
-  std::numeric_limits<type_length>::max();
+static_assert(
+  sizeof(Edge) == sizeof(Edge::type_num) + sizeof(Edge::type_length),
+  "Edge should not store a reverse edge index.");
+static_assert(sizeof(CompactEdge) == 2 * sizeof(std::uint32_t),
+  "CompactEdge should be half the size of Edge.");
 
 #endif // MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_EDGE
@@ -0,0 +1,235 @@
+#ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_INDEXED_D_ARY_HEAP
+#define MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_INDEXED_D_ARY_HEAP
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <vector>
+
+/**
+ * A min-heap of items, numbered from 0 to n-1, such as vertices,
+ * which can decrease the key of an item that is already in the heap.
+ *
+ * Unlike std::priority_queue, this never holds more than one entry per item,
+ * so algorithms don't need to push duplicate entries and skip the stale ones
+ * later. The heap's size is therefore limited by the number of items (n),
+ * instead of growing with the number of edges.
+ *
+ * Each node has T_Arity children instead of 2, so the heap is shallower,
+ * making push() and decrease_key() cheaper, while pop() examines more
+ * children at each level. Those children are adjacent in memory.
+ *
+ * @tparam T_Key The type of the keys, such as path lengths.
+ * @tparam T_Arity The number of children of each node, such as 4 or 8.
+ */
+template <typename T_Key, unsigned int T_Arity = 4>
+class IndexedDAryHeap {
+public:
+  static_assert(T_Arity >= 2, "IndexedDAryHeap needs an arity of at least 2.");
+
+  using type_item = std::size_t;
+  using type_key = T_Key;
+
+  IndexedDAryHeap() {}
+
+  explicit IndexedDAryHeap(std::size_t items_count) {
+    resize(items_count);
+  }
+
+  /**
+   * Allow items from 0 to @a items_count - 1.
+   * This empties the heap.
+   */
+  void
+  resize(std::size_t items_count) {
+    heap_.clear();
+    positions_.assign(items_count, NOT_IN_HEAP);
+  }
+
+  /**
+   * Remove all items, in time proportional to the number of items in the
+   * heap, rather than the number of possible items.
+   */
+  void
+  clear() {
+    for (const auto& entry : heap_) {
+      positions_[entry.item_] = NOT_IN_HEAP;
+    }
+
+    heap_.clear();
+  }
+
+  bool
+  empty() const {
+    return heap_.empty();
+  }
+
+  std::size_t
+  size() const {
+    return heap_.size();
+  }
+
+  bool
+  contains(type_item item) const {
+    return positions_[item] != NOT_IN_HEAP;
+  }
+
+  /**
+   * Get the key of an item that is in the heap.
+   */
+  type_key
+  get_key(type_item item) const {
+    assert(contains(item));
+    return heap_[positions_[item]].key_;
+  }
+
+  /**
+   * Add an item that is not already in the heap.
+   */
+  void
+  push(type_item item, type_key key) {
+    assert(!contains(item));
+
+    const auto position = heap_.size();
+    heap_.emplace_back(item, key);
+    positions_[item] = position;
+    sift_up(position);
+  }
+
+  /**
+   * Decrease the key of an item that is already in the heap.
+   */
+  void
+  decrease_key(type_item item, type_key key) {
+    assert(contains(item));
+
+    const auto position = positions_[item];
+    assert(key <= heap_[position].key_);
+    heap_[position].key_ = key;
+    sift_up(position);
+  }
+
+  /**
+   * Add the item, or decrease its key if it is already in the heap.
+   *
+   * @result false if the item was already in the heap with a key that is not
+   * greater than @a key, so nothing was changed.
+   */
+  bool
+  push_or_decrease_key(type_item item, type_key key) {
+    if (!contains(item)) {
+      push(item, key);
+      return true;
+    }
+
+    if (key >= heap_[positions_[item]].key_) {
+      return false;
+    }
+
+    decrease_key(item, key);
+    return true;
+  }
+
+  /**
+   * The item with the smallest key.
+   */
+  type_item
+  top() const {
+    return heap_.front().item_;
+  }
+
+  type_key
+  top_key() const {
+    return heap_.front().key_;
+  }
+
+  /**
+   * Remove the item with the smallest key.
+   */
+  void
+  pop() {
+    positions_[heap_.front().item_] = NOT_IN_HEAP;
+
+    const auto last = heap_.back();
+    heap_.pop_back();
+    if (heap_.empty()) {
+      return;
+    }
+
+    heap_[0] = last;
+    positions_[last.item_] = 0;
+    sift_down(0);
+  }
+
+private:
+  static constexpr std::size_t NOT_IN_HEAP =
+    std::numeric_limits<std::size_t>::max();
+
+  class Entry {
+  public:
+    Entry(type_item item, type_key key) : key_(key), item_(item) {}
+
+    type_key key_;
+    type_item item_;
+  };
+
+  void
+  sift_up(std::size_t position) {
+    const auto entry = heap_[position];
+    while (position > 0) {
+      const auto parent = (position - 1) / T_Arity;
+      if (!(entry.key_ < heap_[parent].key_)) {
+        break;
+      }
+
+      heap_[position] = heap_[parent];
+      positions_[heap_[position].item_] = position;
+      position = parent;
+    }
+
+    heap_[position] = entry;
+    positions_[entry.item_] = position;
+  }
+
+  void
+  sift_down(std::size_t position) {
+    const auto entry = heap_[position];
+    const auto size = heap_.size();
+    while (true) {
+      const auto first_child = position * T_Arity + 1;
+      if (first_child >= size) {
+        break;
+      }
+
+      // Find the child with the smallest key:
+      const auto end_child = std::min(first_child + T_Arity, size);
+      auto best_child = first_child;
+      for (auto child = first_child + 1; child < end_child; ++child) {
+        if (heap_[child].key_ < heap_[best_child].key_) {
+          best_child = child;
+        }
+      }
+
+      if (!(heap_[best_child].key_ < entry.key_)) {
+        break;
+      }
+
+      heap_[position] = heap_[best_child];
+      positions_[heap_[position].item_] = position;
+      position = best_child;
+    }
+
+    heap_[position] = entry;
+    positions_[entry.item_] = position;
+  }
+
+  std::vector<Entry> heap_;
+
+  // The position of each item in heap_, or NOT_IN_HEAP.
+  std::vector<std::size_t> positions_;
+};
+
+template <typename T_Key, unsigned int T_Arity>
+constexpr std::size_t IndexedDAryHeap<T_Key, T_Arity>::NOT_IN_HEAP;
+
+#endif // MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_INDEXED_D_ARY_HEAP
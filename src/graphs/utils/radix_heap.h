@@ -0,0 +1,179 @@
+#ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_RADIX_HEAP
+#define MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_RADIX_HEAP
+
+#include <cassert>
+#include <climits>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * A monotone min-priority queue for non-negative integer keys.
+ *
+ * This only works if no key is pushed that is smaller than the last key that
+ * was popped, which is true of Dijkstra's algorithm, because it never finds a
+ * path that is shorter than the path to a vertex that it has already popped,
+ * as long as there are no negative edges.
+ *
+ * The entries are kept in buckets, according to the highest bit in which
+ * their key differs from the last popped key. Bucket 0 holds the entries
+ * whose key is equal to the last popped key. When that is empty, pop()
+ * finds the first non-empty bucket, takes its smallest key as the new last
+ * popped key, and redistributes that bucket's entries into lower buckets.
+ * Each entry can only move down, at most once per bit of the key, so push()
+ * and pop() take O(log C) amortized time, where C is the largest key,
+ * instead of O(log n), and they don't jump around the memory like a heap.
+ *
+ * @tparam T_Key An integer type, such as Edge::type_length.
+ * @tparam T_Value The type of the values, such as a vertex number.
+ */
+template <typename T_Key, typename T_Value>
+class RadixHeap {
+public:
+  static_assert(std::is_integral<T_Key>::value,
+    "RadixHeap needs an integer key type.");
+
+  using type_key = T_Key;
+  using type_value = T_Value;
+
+  RadixHeap() : last_(0), size_(0) {}
+
+  /**
+   * Remove all entries, and allow keys from 0 again.
+   */
+  void
+  clear() {
+    for (auto& bucket : buckets_) {
+      bucket.clear();
+    }
+
+    last_ = 0;
+    size_ = 0;
+  }
+
+  bool
+  empty() const {
+    return size_ == 0;
+  }
+
+  std::size_t
+  size() const {
+    return size_;
+  }
+
+  /**
+   * Add an entry, whose key may not be less than the last popped key.
+   */
+  void
+  push(type_key key, type_value value) {
+    assert(key >= 0);
+
+    const auto unsigned_key = static_cast<type_unsigned_key>(key);
+    assert(unsigned_key >= last_);
+
+    buckets_[get_bucket(unsigned_key)].emplace_back(unsigned_key, value);
+    ++size_;
+  }
+
+  /**
+   * Remove and return an entry with the smallest key.
+   */
+  std::pair<type_key, type_value>
+  pop() {
+    assert(!empty());
+
+    auto& bucket = buckets_[0];
+    if (bucket.empty()) {
+      redistribute();
+    }
+
+    const auto entry = bucket.back();
+    bucket.pop_back();
+    --size_;
+
+    return std::make_pair(static_cast<type_key>(entry.first), entry.second);
+  }
+
+private:
+  using type_unsigned_key = typename std::make_unsigned<type_key>::type;
+
+  // One bucket for keys equal to last_,
+  // and one for each bit in which a key can differ from last_.
+  static constexpr std::size_t BUCKETS_COUNT =
+    std::numeric_limits<type_unsigned_key>::digits + 1;
+
+  using type_entry = std::pair<type_unsigned_key, type_value>;
+  using type_bucket = std::vector<type_entry>;
+
+  /**
+   * The number of bits needed to hold @a x, which is 0 if @a x is 0.
+   */
+  static std::size_t
+  get_bit_width(type_unsigned_key x) {
+#if defined(__GNUC__)
+    if (x == 0) {
+      return 0;
+    }
+
+    return sizeof(unsigned long long) * CHAR_BIT -
+           __builtin_clzll(static_cast<unsigned long long>(x));
+#else
+    std::size_t result = 0;
+    while (x != 0) {
+      x >>= 1;
+      ++result;
+    }
+
+    return result;
+#endif
+  }
+
+  std::size_t
+  get_bucket(type_unsigned_key key) const {
+    return get_bit_width(key ^ last_);
+  }
+
+  /**
+   * Move the entries from the first non-empty bucket into the lower buckets,
+   * so that at least one of them, with the smallest key, is in bucket 0.
+   */
+  void
+  redistribute() {
+    std::size_t i = 1;
+    while (buckets_[i].empty()) {
+      ++i;
+    }
+
+    auto& bucket = buckets_[i];
+
+    auto min_key = bucket.front().first;
+    for (const auto& entry : bucket) {
+      if (entry.first < min_key) {
+        min_key = entry.first;
+      }
+    }
+
+    last_ = min_key;
+
+    // Every entry in this bucket differs from the new last_ only in lower
+    // bits, so each one moves to a lower bucket.
+    for (const auto& entry : bucket) {
+      buckets_[get_bucket(entry.first)].emplace_back(entry);
+    }
+
+    bucket.clear();
+  }
+
+  type_bucket buckets_[BUCKETS_COUNT];
+
+  // The last popped key.
+  type_unsigned_key last_;
+
+  std::size_t size_;
+};
+
+template <typename T_Key, typename T_Value>
+constexpr std::size_t RadixHeap<T_Key, T_Value>::BUCKETS_COUNT;
+
+#endif // MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_RADIX_HEAP
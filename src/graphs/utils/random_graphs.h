@@ -0,0 +1,392 @@
+#ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_RANDOM_GRAPHS
+#define MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_RANDOM_GRAPHS
+
+#include "utils/edge.h"
+#include "utils/vertex.h"
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <vector>
+
+/**
+ * Generate a graph with @a edges_count random edges between @a vertices_count
+ * vertices, with random lengths between 1 and @a max_length.
+ * The same @a seed always gives the same graph, so benchmarks can compare
+ * implementations on the same input.
+ *
+ * Like any graph built by adding edges one at a time, each vertex's edges
+ * end up in their own separate allocation.
+ */
+type_vec_nodes
+make_random_graph(Edge::type_num vertices_count, Edge::type_num edges_count,
+  Edge::type_length max_length, unsigned int seed = 1) {
+  type_vec_nodes result(vertices_count);
+  if (vertices_count == 0) {
+    return result;
+  }
+
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<Edge::type_num> vertex_distribution(
+    0, vertices_count - 1);
+  std::uniform_int_distribution<Edge::type_length> length_distribution(
+    1, max_length);
+
+  for (Edge::type_num i = 0; i < edges_count; ++i) {
+    const auto source = vertex_distribution(generator);
+    const auto dest = vertex_distribution(generator);
+    result[source].edges_.emplace_back(dest, length_distribution(generator));
+  }
+
+  return result;
+}
+
+/**
+ * Like make_random_graph(), but each edge leads from a lower-numbered vertex
+ * to a higher-numbered vertex, so there are no cycles.
+ */
+type_vec_nodes
+make_random_acyclic_graph(Edge::type_num vertices_count,
+  Edge::type_num edges_count, Edge::type_length max_length,
+  unsigned int seed = 1) {
+  type_vec_nodes result(vertices_count);
+  if (vertices_count < 2) {
+    return result;
+  }
+
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<Edge::type_num> vertex_distribution(
+    0, vertices_count - 1);
+  std::uniform_int_distribution<Edge::type_length> length_distribution(
+    1, max_length);
+
+  for (Edge::type_num i = 0; i < edges_count; ++i) {
+    auto source = vertex_distribution(generator);
+    auto dest = vertex_distribution(generator);
+    if (source == dest) {
+      continue;
+    }
+
+    if (source > dest) {
+      std::swap(source, dest);
+    }
+
+    result[source].edges_.emplace_back(dest, length_distribution(generator));
+  }
+
+  return result;
+}
+
+/**
+ * Generate a @a width by @a height grid of vertices, with edges in both
+ * directions between neighbouring vertices, with random lengths between 1 and
+ * @a max_length. Vertex (x, y) is number y * width + x.
+ *
+ * Like a road network, this has a large diameter,
+ * unlike make_random_graph(), whose vertices are all a few edges apart.
+ */
+type_vec_nodes
+make_random_grid_graph(Edge::type_num width, Edge::type_num height,
+  Edge::type_length max_length, unsigned int seed = 1) {
+  type_vec_nodes result(width * height);
+
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<Edge::type_length> length_distribution(
+    1, max_length);
+
+  for (Edge::type_num y = 0; y < height; ++y) {
+    for (Edge::type_num x = 0; x < width; ++x) {
+      const auto v = y * width + x;
+      if (x + 1 < width) {
+        result[v].edges_.emplace_back(v + 1, length_distribution(generator));
+        result[v + 1].edges_.emplace_back(v, length_distribution(generator));
+      }
+
+      if (y + 1 < height) {
+        result[v].edges_.emplace_back(
+          v + width, length_distribution(generator));
+        result[v + width].edges_.emplace_back(
+          v, length_distribution(generator));
+      }
+    }
+  }
+
+  return result;
+}
+
+/**
+ * Generate a graph with 2^@a scale vertices and @a edges_per_vertex * 2^scale
+ * random edges, with random lengths between 1 and @a max_length, using the
+ * R-MAT (recursive matrix) model, as used by the Graph500 benchmark.
+ *
+ * Each edge is placed by repeatedly choosing one quarter of the adjacency
+ * matrix, with probabilities 0.57, 0.19, 0.19 and 0.05, so a few vertices
+ * have very many edges, and most have few, like a social network.
+ * The vertex numbers are shuffled, so the vertices with most edges are not
+ * all numbered near 0.
+ */
+type_vec_nodes
+make_rmat_graph(unsigned int scale, Edge::type_num edges_per_vertex,
+  Edge::type_length max_length, unsigned int seed = 1) {
+  const Edge::type_num vertices_count = Edge::type_num(1) << scale;
+  type_vec_nodes result(vertices_count);
+
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> quarter_distribution(0, 1);
+  std::uniform_int_distribution<Edge::type_length> length_distribution(
+    1, max_length);
+
+  std::vector<Edge::type_num> permutation(vertices_count);
+  std::iota(permutation.begin(), permutation.end(), 0);
+  std::shuffle(permutation.begin(), permutation.end(), generator);
+
+  const auto edges_count = edges_per_vertex * vertices_count;
+  for (Edge::type_num i = 0; i < edges_count; ++i) {
+    Edge::type_num source = 0;
+    Edge::type_num dest = 0;
+    for (unsigned int bit = 0; bit < scale; ++bit) {
+      const auto quarter = quarter_distribution(generator);
+      if (quarter >= 0.57 + 0.19 + 0.19) {
+        source |= Edge::type_num(1) << bit;
+        dest |= Edge::type_num(1) << bit;
+      } else if (quarter >= 0.57 + 0.19) {
+        source |= Edge::type_num(1) << bit;
+      } else if (quarter >= 0.57) {
+        dest |= Edge::type_num(1) << bit;
+      }
+    }
+
+    result[permutation[source]].edges_.emplace_back(
+      permutation[dest], length_distribution(generator));
+  }
+
+  return result;
+}
+
+/**
+ * Generate a max-flow network like the DIMACS GENRMF generator (Goldfarb and
+ * Grigoriadis), with @a frames_count frames, each a grid of
+ * @a frame_width * @a frame_width vertices.
+ *
+ * Each vertex has edges to its neighbours in its frame, with a capacity of
+ * @a max_capacity * frame_width * frame_width, so the flow can easily spread
+ * out within a frame. Each vertex also has one edge to a vertex in the next
+ * frame, chosen by a random permutation, with a random capacity between 1
+ * and @a max_capacity, so those edges limit the flow.
+ * The source is vertex 0, in the first frame, and the sink is the last
+ * vertex, in the last frame.
+ */
+type_vec_nodes
+make_rmf_graph(Edge::type_num frame_width, Edge::type_num frames_count,
+  Edge::type_length max_capacity, unsigned int seed = 1) {
+  const auto frame_size = frame_width * frame_width;
+  type_vec_nodes result(frame_size * frames_count);
+
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<Edge::type_length> capacity_distribution(
+    1, max_capacity);
+  const Edge::type_length frame_capacity = max_capacity * frame_size;
+
+  std::vector<Edge::type_num> permutation(frame_size);
+  std::iota(permutation.begin(), permutation.end(), 0);
+
+  for (Edge::type_num f = 0; f < frames_count; ++f) {
+    const auto first = f * frame_size;
+    for (Edge::type_num y = 0; y < frame_width; ++y) {
+      for (Edge::type_num x = 0; x < frame_width; ++x) {
+        const auto v = first + y * frame_width + x;
+        auto& edges = result[v].edges_;
+        if (x > 0) {
+          edges.emplace_back(v - 1, frame_capacity);
+        }
+
+        if (x + 1 < frame_width) {
+          edges.emplace_back(v + 1, frame_capacity);
+        }
+
+        if (y > 0) {
+          edges.emplace_back(v - frame_width, frame_capacity);
+        }
+
+        if (y + 1 < frame_width) {
+          edges.emplace_back(v + frame_width, frame_capacity);
+        }
+      }
+    }
+
+    if (f + 1 < frames_count) {
+      std::shuffle(permutation.begin(), permutation.end(), generator);
+      const auto next_first = first + frame_size;
+      for (Edge::type_num i = 0; i < frame_size; ++i) {
+        result[first + i].edges_.emplace_back(
+          next_first + permutation[i], capacity_distribution(generator));
+      }
+    }
+  }
+
+  return result;
+}
+
+/**
+ * Generate a max-flow network like the DIMACS Washington random level graph
+ * generator, with @a levels_count levels of @a level_width vertices.
+ *
+ * Each vertex has @a edges_per_vertex edges to random vertices in the next
+ * level, with random capacities between 1 and @a max_capacity.
+ * The source is vertex 0, with edges to all the vertices in the first level,
+ * and the sink is the last vertex, with edges from all the vertices in the
+ * last level, all with enough capacity to not limit the flow.
+ */
+type_vec_nodes
+make_random_level_graph(Edge::type_num levels_count,
+  Edge::type_num level_width, Edge::type_num edges_per_vertex,
+  Edge::type_length max_capacity, unsigned int seed = 1) {
+  const auto vertices_count = levels_count * level_width + 2;
+  type_vec_nodes result(vertices_count);
+  const Edge::type_num source = 0;
+  const auto sink = vertices_count - 1;
+
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<Edge::type_num> column_distribution(
+    0, level_width - 1);
+  std::uniform_int_distribution<Edge::type_length> capacity_distribution(
+    1, max_capacity);
+  const Edge::type_length unlimited = max_capacity * edges_per_vertex;
+
+  for (Edge::type_num level = 0; level < levels_count; ++level) {
+    const auto first = 1 + level * level_width;
+    for (Edge::type_num i = 0; i < level_width; ++i) {
+      const auto v = first + i;
+      if (level == 0) {
+        result[source].edges_.emplace_back(v, unlimited);
+      }
+
+      if (level + 1 == levels_count) {
+        result[v].edges_.emplace_back(sink, unlimited);
+        continue;
+      }
+
+      for (Edge::type_num e = 0; e < edges_per_vertex; ++e) {
+        result[v].edges_.emplace_back(
+          first + level_width + column_distribution(generator),
+          capacity_distribution(generator));
+      }
+    }
+  }
+
+  return result;
+}
+
+/**
+ * Generate a max-flow network like those used to segment images with graph
+ * cuts, for a noisy @a width by @a height image of a bright disc on a dark
+ * background, with random brightnesses between 0 and @a max_capacity.
+ *
+ * Pixel (x, y) is vertex 1 + y * width + x, with edges in both directions to
+ * its 4 neighbours, whose capacities are high between pixels of similar
+ * brightness, so the cheapest cut follows the disc's edge. The source is
+ * vertex 0, with an edge to each pixel, whose capacity is its brightness, and
+ * the sink is the last vertex, with an edge from each pixel, whose capacity
+ * is its darkness.
+ */
+type_vec_nodes
+make_segmentation_grid_graph(Edge::type_num width, Edge::type_num height,
+  Edge::type_length max_capacity, unsigned int seed = 1) {
+  const auto pixels_count = width * height;
+  type_vec_nodes result(pixels_count + 2);
+  const Edge::type_num source = 0;
+  const auto sink = pixels_count + 1;
+
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<Edge::type_length> noise_distribution(
+    -max_capacity / 4, max_capacity / 4);
+
+  const auto radius = std::min(width, height) / 3.0;
+  std::vector<Edge::type_length> brightnesses(pixels_count);
+  for (Edge::type_num y = 0; y < height; ++y) {
+    for (Edge::type_num x = 0; x < width; ++x) {
+      const auto dx = x - width / 2.0;
+      const auto dy = y - height / 2.0;
+      const auto brightness =
+        (dx * dx + dy * dy <= radius * radius ? max_capacity * 3 / 4
+                                              : max_capacity / 4) +
+        noise_distribution(generator);
+      brightnesses[y * width + x] =
+        std::min(std::max<Edge::type_length>(brightness, 0), max_capacity);
+    }
+  }
+
+  const auto add_neighbour = [&](Edge::type_num p, Edge::type_num q) {
+    const auto difference = std::abs(brightnesses[p] - brightnesses[q]);
+    result[1 + p].edges_.emplace_back(
+      1 + q, std::max<Edge::type_length>(max_capacity / 2 - difference, 1));
+  };
+
+  for (Edge::type_num y = 0; y < height; ++y) {
+    for (Edge::type_num x = 0; x < width; ++x) {
+      const auto p = y * width + x;
+      result[source].edges_.emplace_back(1 + p, brightnesses[p]);
+      result[1 + p].edges_.emplace_back(sink, max_capacity - brightnesses[p]);
+
+      if (x > 0) {
+        add_neighbour(p, p - 1);
+      }
+
+      if (x + 1 < width) {
+        add_neighbour(p, p + 1);
+      }
+
+      if (y > 0) {
+        add_neighbour(p, p - width);
+      }
+
+      if (y + 1 < height) {
+        add_neighbour(p, p + width);
+      }
+    }
+  }
+
+  return result;
+}
+
+/**
+ * Generate the max-flow network for a random bipartite matching problem,
+ * with @a left_count vertices on the left, each with @a edges_per_vertex
+ * edges to random vertices among the @a right_count vertices on the right,
+ * all with a capacity of 1.
+ * The source is vertex 0, with an edge to each left vertex, and the sink is
+ * the last vertex, with an edge from each right vertex, so the maximum flow
+ * is the size of the maximum matching.
+ */
+type_vec_nodes
+make_bipartite_matching_graph(Edge::type_num left_count,
+  Edge::type_num right_count, Edge::type_num edges_per_vertex,
+  unsigned int seed = 1) {
+  const auto vertices_count = left_count + right_count + 2;
+  type_vec_nodes result(vertices_count);
+  const Edge::type_num source = 0;
+  const auto sink = vertices_count - 1;
+  const Edge::type_num first_left = 1;
+  const auto first_right = first_left + left_count;
+
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<Edge::type_num> right_distribution(
+    0, right_count - 1);
+
+  for (Edge::type_num i = 0; i < left_count; ++i) {
+    const auto v = first_left + i;
+    result[source].edges_.emplace_back(v, 1);
+    for (Edge::type_num e = 0; e < edges_per_vertex; ++e) {
+      result[v].edges_.emplace_back(
+        first_right + right_distribution(generator), 1);
+    }
+  }
+
+  for (Edge::type_num i = 0; i < right_count; ++i) {
+    result[first_right + i].edges_.emplace_back(sink, 1);
+  }
+
+  return result;
+}
+
+#endif // MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_RANDOM_GRAPHS
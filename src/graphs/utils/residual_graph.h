@@ -0,0 +1,241 @@
+#ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_RESIDUAL_GRAPH
+#define MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_RESIDUAL_GRAPH
+
+#include "utils/csr_graph.h"
+#include "utils/edge.h"
+#include <iostream>
+#include <vector>
+
+/**
+ * The residual graph used by the max-flow algorithms, with each edge's length
+ * as its capacity, and a reverse arc, with no capacity, for each edge, so the
+ * algorithms can undo the flow along an edge.
+ *
+ * Like BasicCsrGraph, the arcs (the edges and their reverse arcs) are stored
+ * contiguously, ordered by their source vertex, so the arcs of vertex v are at
+ * the indices [offsets_[v], offsets_[v + 1]) of the arrays. Each arc knows the
+ * index of its reverse arc, which is in the arcs of its destination vertex.
+ *
+ * The topology (offsets_, destinations_, reverse_arcs_) never changes after
+ * construction, and is kept apart from the capacities and the remaining
+ * (residual) capacities, so the same graph can be used for many max-flow
+ * calculations, with reset_flow() or set_capacities(), without building it
+ * again.
+ *
+ * operator[] gives the residual capacities as the edge lengths, so
+ * bfs_compute() can search the residual graph, ignoring saturated arcs, which
+ * have a length of 0.
+ */
+class ResidualGraph {
+public:
+  using type_num = Edge::type_num;
+  using type_length = Edge::type_length;
+  using type_vertex = BasicCsrVertex<type_num, type_length>;
+
+  ResidualGraph() {}
+
+  /**
+   * Build the residual graph in two passes over the edges: the first counts
+   * the arcs of each vertex, to get the offsets, and the second puts each arc
+   * in place, so nothing is ever reallocated.
+   *
+   * Each vertex's edges come first, in their original order, before the
+   * reverse arcs of the edges that lead to it, so the algorithms try to send
+   * flow forwards before sending it back.
+   *
+   * @tparam T_Graph For instance, type_vec_nodes or CsrGraph.
+   */
+  template <typename T_Graph>
+  explicit ResidualGraph(const T_Graph& vertices) {
+    const auto vertices_count = vertices.size();
+
+    // Count the arcs from each vertex: its edges, and the reverse arcs of the
+    // edges that lead to it. Then add up the counts to get the offsets:
+    offsets_.assign(vertices_count + 1, 0);
+    std::vector<std::size_t> reverse_positions(vertices_count, 0);
+    std::size_t edges_count = 0;
+    for (type_num u = 0; u < vertices_count; ++u) {
+      for (const auto& edge : vertices[u].edges_) {
+        ++offsets_[u + 1];
+        ++offsets_[edge.destination_vertex_ + 1];
+        ++reverse_positions[u];
+        ++edges_count;
+      }
+    }
+
+    for (std::size_t v = 0; v < vertices_count; ++v) {
+      offsets_[v + 1] += offsets_[v];
+
+      // The first free position for the vertex's reverse arcs,
+      // after its edges:
+      reverse_positions[v] += offsets_[v];
+    }
+
+    const auto arcs_count = offsets_.back();
+    destinations_.resize(arcs_count);
+    reverse_arcs_.resize(arcs_count);
+    capacities_.resize(arcs_count);
+    edge_arcs_.resize(edges_count);
+
+    std::size_t i = 0;
+    for (type_num u = 0; u < vertices_count; ++u) {
+      auto arc = offsets_[u];
+      for (const auto& edge : vertices[u].edges_) {
+        const auto v = edge.destination_vertex_;
+        const auto reverse_arc = reverse_positions[v]++;
+
+        destinations_[arc] = v;
+        reverse_arcs_[arc] = reverse_arc;
+        capacities_[arc] = edge.length_;
+
+        destinations_[reverse_arc] = u;
+        reverse_arcs_[reverse_arc] = arc;
+        capacities_[reverse_arc] = 0;
+
+        edge_arcs_[i++] = arc++;
+      }
+    }
+
+    residuals_ = capacities_;
+  }
+
+  /**
+   * The number of vertices.
+   */
+  std::size_t
+  size() const {
+    return offsets_.empty() ? 0 : offsets_.size() - 1;
+  }
+
+  bool
+  empty() const {
+    return size() == 0;
+  }
+
+  /**
+   * The number of arcs, which is twice the number of edges.
+   */
+  std::size_t
+  arcs_count() const {
+    return destinations_.size();
+  }
+
+  /**
+   * The vertex, with its arcs' remaining capacities as their lengths.
+   */
+  type_vertex
+  operator[](std::size_t v) const {
+    const auto begin = offsets_[v];
+    return type_vertex(BasicCsrEdges<type_num, type_length>(
+      destinations_.data() + begin, residuals_.data() + begin,
+      offsets_[v + 1] - begin));
+  }
+
+  /**
+   * The index of the arc that is the @a e th edge of vertex @a u in
+   * operator[], for instance as in a SourceAndEdge.
+   */
+  std::size_t
+  get_arc(type_num u, type_num e) const {
+    return offsets_[u] + e;
+  }
+
+  /**
+   * Send @a flow along the arc, which must have that much remaining capacity,
+   * letting its reverse arc undo it.
+   */
+  void
+  push(std::size_t arc, type_length flow) {
+    residuals_[arc] -= flow;
+    residuals_[reverse_arcs_[arc]] += flow;
+  }
+
+  /**
+   * The flow along the original graph's @a i th edge, counting the edges in
+   * order of their source vertex, as in the constructor's graph.
+   */
+  type_length
+  get_flow(std::size_t i) const {
+    const auto arc = edge_arcs_[i];
+    return capacities_[arc] - residuals_[arc];
+  }
+
+  /**
+   * Remove all the flow, so the remaining capacities are the capacities.
+   */
+  void
+  reset_flow() {
+    residuals_ = capacities_;
+  }
+
+  /**
+   * Change the capacity of the original graph's @a i th edge, as for
+   * get_flow(). This doesn't change the flow, so call reset_flow() before
+   * calculating the maximum flow again.
+   */
+  void
+  set_capacity(std::size_t i, type_length capacity) {
+    capacities_[edge_arcs_[i]] = capacity;
+  }
+
+  /**
+   * Take new capacities from the lengths of a graph with the same edges as
+   * the constructor's graph, and remove all the flow.
+   * @result false if the graph has different edges, in which case nothing is
+   * changed.
+   */
+  template <typename T_Graph>
+  bool
+  set_capacities(const T_Graph& vertices) {
+    const auto vertices_count = vertices.size();
+    bool same = vertices_count == size();
+    std::size_t i = 0;
+    for (type_num u = 0; same && u < vertices_count; ++u) {
+      for (const auto& edge : vertices[u].edges_) {
+        if (i == edge_arcs_.size() ||
+            destinations_[edge_arcs_[i]] != edge.destination_vertex_) {
+          same = false;
+          break;
+        }
+
+        ++i;
+      }
+    }
+
+    if (!same || i != edge_arcs_.size()) {
+      std::cerr << "set_capacities(): the graph has different edges."
+                << std::endl;
+      return false;
+    }
+
+    i = 0;
+    for (type_num u = 0; u < vertices_count; ++u) {
+      for (const auto& edge : vertices[u].edges_) {
+        set_capacity(i++, edge.length_);
+      }
+    }
+
+    reset_flow();
+    return true;
+  }
+
+  // The topology:
+  std::vector<std::size_t> offsets_;
+  std::vector<type_num> destinations_;
+  std::vector<std::size_t> reverse_arcs_;
+
+  // The arc of each of the original graph's edges.
+  std::vector<std::size_t> edge_arcs_;
+
+  // The capacity of each arc, which is 0 for the reverse arcs,
+  // and the remaining capacity, as the flow changes.
+  std::vector<type_length> capacities_;
+  std::vector<type_length> residuals_;
+};
+
+static_assert(std::is_copy_assignable<ResidualGraph>::value,
+  "ResidualGraph should be copy assignable.");
+static_assert(std::is_move_constructible<ResidualGraph>::value,
+  "ResidualGraph should be move constructible.");
+
+#endif // MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_RESIDUAL_GRAPH
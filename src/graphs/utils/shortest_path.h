@@ -2,7 +2,16 @@
 #define MURRAYC_ALGORITHMS_EXPERIMENTS_SHORTEST_PATH
 
 #include "utils/edge.h"
+#include <algorithm>
+#include <iostream>
+#include <limits>
 #include <string>
+#include <vector>
+
+// The predecessor of the start vertex, and of vertices that have no path from
+// the start vertex.
+constexpr Edge::type_num INVALID_PREDECESSOR =
+  std::numeric_limits<Edge::type_num>::max();
 
 /**
  * Just a way to return both the length and the path.
@@ -10,11 +19,37 @@
  */
 class ShortestPath {
 public:
-  ShortestPath(Edge::type_length length, const std::string& path)
+  // The vertices along a path, including the start and end vertices.
+  using type_path = std::vector<Edge::type_num>;
+
+  ShortestPath() : length_(Edge::LENGTH_INFINITY) {}
+
+  ShortestPath(Edge::type_length length, const type_path& path)
   : length_(length), path_(path) {}
 
+  ShortestPath(Edge::type_length length, type_path&& path)
+  : length_(length), path_(std::move(path)) {}
+
+  /**
+   * Get the path as a string, such as "0, 1, 3, ".
+   * This is only built when it is needed, for instance to show it to a
+   * person, so the algorithms don't spend time building strings.
+   */
+  std::string
+  get_path_string() const {
+    std::string result;
+    for (const auto v : path_) {
+      result += std::to_string(v);
+      result += ", ";
+    }
+
+    return result;
+  }
+
   Edge::type_length length_;
-  std::string path_;
+
+  // This is empty if there is no path.
+  type_path path_;
 };
 
 static_assert(std::is_copy_assignable<ShortestPath>::value,
@@ -25,4 +60,117 @@ static_assert(std::is_move_assignable<ShortestPath>::value,
   "ShortestPath should be move assignable.");
 static_assert(std::is_move_constructible<ShortestPath>::value,
   "ShortestPath should be move constructible.");
+
+/**
+ * Get the vertices along the path from @a start_vertex to @a end_vertex,
+ * by following the chain of predecessors back from @a end_vertex.
+ * The caller should check that there is a path to @a end_vertex.
+ *
+ * @tparam T_Predecessors For instance, a std::vector<type_num>.
+ */
+template <typename T_Predecessors>
+ShortestPath::type_path
+get_path_vertices_from_predecessors(Edge::type_num start_vertex,
+  Edge::type_num end_vertex, const T_Predecessors& predecessors) {
+  ShortestPath::type_path path;
+
+  auto v = end_vertex;
+  path.emplace_back(v);
+  while (v != start_vertex) {
+    v = predecessors[v];
+
+    // The path can't be longer than the number of vertices,
+    // unless the predecessors have a (negative) cycle.
+    if (v == INVALID_PREDECESSOR || path.size() > predecessors.size()) {
+      std::cerr << "get_path_vertices_from_predecessors(): avoiding infinite "
+                   "loop."
+                << std::endl;
+      return ShortestPath::type_path();
+    }
+
+    path.emplace_back(v);
+  }
+
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+/**
+ * The shortest paths from one start vertex to all vertices.
+ *
+ * This just stores the length of each path, and the tree of predecessors,
+ * so it takes O(n) space. Each path is only built if it is requested,
+ * via get_path() or operator[].
+ */
+class ShortestPaths {
+public:
+  using type_num = Edge::type_num;
+  using type_length = Edge::type_length;
+
+  ShortestPaths() : start_vertex_(0) {}
+
+  ShortestPaths(type_num start_vertex, std::vector<type_length>&& lengths,
+    std::vector<type_num>&& predecessors)
+  : start_vertex_(start_vertex),
+    lengths_(std::move(lengths)),
+    predecessors_(std::move(predecessors)) {}
+
+  /**
+   * The number of vertices.
+   */
+  std::size_t
+  size() const {
+    return lengths_.size();
+  }
+
+  bool
+  empty() const {
+    return lengths_.empty();
+  }
+
+  /**
+   * The length of the shortest path to @a v,
+   * or Edge::LENGTH_INFINITY if there is no path.
+   */
+  type_length
+  get_length(type_num v) const {
+    return lengths_[v];
+  }
+
+  /**
+   * The vertices along the shortest path to @a v.
+   * This is empty if there is no path.
+   */
+  ShortestPath::type_path
+  get_path(type_num v) const {
+    if (lengths_[v] == Edge::LENGTH_INFINITY) {
+      return ShortestPath::type_path();
+    }
+
+    return get_path_vertices_from_predecessors(start_vertex_, v, predecessors_);
+  }
+
+  /**
+   * Get the shortest path to @a v, building its list of vertices.
+   * Use get_length() if you need only the length.
+   */
+  ShortestPath
+  operator[](type_num v) const {
+    return ShortestPath(lengths_[v], get_path(v));
+  }
+
+  type_num start_vertex_;
+  std::vector<type_length> lengths_;
+  std::vector<type_num> predecessors_;
+};
+
+static_assert(std::is_copy_assignable<ShortestPaths>::value,
+  "ShortestPaths should be copy assignable.");
+static_assert(std::is_copy_constructible<ShortestPaths>::value,
+  "ShortestPaths should be copy constructible.");
+static_assert(std::is_move_assignable<ShortestPaths>::value,
+  "ShortestPaths should be move assignable.");
+static_assert(std::is_move_constructible<ShortestPaths>::value,
+  "ShortestPaths should be move constructible.");
+
 #endif // MURRAYC_ALGORITHMS_EXPERIMENTS_SHORTEST_PATH
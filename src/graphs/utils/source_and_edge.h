@@ -40,10 +40,12 @@ using type_vec_path = std::vector<SourceAndEdge>;
  * the @a start_vertex.
  *
  * @path The path, in terms of edges.
+ * @tparam T_Graph For instance, type_vec_nodes or CsrGraph.
  */
+template <typename T_Graph>
 std::vector<Edge::type_num>
 get_vertices_for_path(Edge::type_num start_vertex, const type_vec_path& path,
-  const type_vec_nodes& vertices) {
+  const T_Graph& vertices) {
   std::vector<Edge::type_num> result;
   result.reserve(path.size() + 1);
 
@@ -0,0 +1,170 @@
+#ifndef MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_THREAD_POOL
+#define MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_THREAD_POOL
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * A fixed set of threads, which can all run the same function,
+ * for algorithms that work in phases, with each phase split between the
+ * threads, and each phase finishing before the next one starts.
+ *
+ * The threads are created once, so each phase only needs to wake them up,
+ * instead of creating new threads.
+ * The calling thread does the work of thread 0, so a ThreadPool of size 1
+ * doesn't create any threads.
+ */
+class ThreadPool {
+public:
+  /**
+   * @param threads_count The number of threads, including the calling
+   * thread. 0 means the number of cores.
+   */
+  explicit ThreadPool(std::size_t threads_count = 0)
+  : generation_(0), pending_(0), stop_(false) {
+    if (threads_count == 0) {
+      threads_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (std::size_t i = 1; i < threads_count; ++i) {
+      threads_.emplace_back(&ThreadPool::work, this, i);
+    }
+  }
+
+  ThreadPool(const ThreadPool& src) = delete;
+  ThreadPool&
+  operator=(const ThreadPool& src) = delete;
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+
+    start_condition_.notify_all();
+
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  /**
+   * The number of threads, including the calling thread.
+   */
+  std::size_t
+  size() const {
+    return threads_.size() + 1;
+  }
+
+  /**
+   * Call @a func(thread_index) once on each thread, with a thread_index from
+   * 0 to size() - 1, returning when all the calls have returned.
+   */
+  template <typename T_Func>
+  void
+  run(const T_Func& func) {
+    if (threads_.empty()) {
+      func(0);
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      task_ = [&func](std::size_t thread_index) { func(thread_index); };
+      pending_ = threads_.size();
+      ++generation_;
+    }
+
+    start_condition_.notify_all();
+
+    func(0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_condition_.wait(lock, [this] { return pending_ == 0; });
+    task_ = nullptr;
+  }
+
+  /**
+   * Call @a func(i, thread_index) for each i from 0 to @a count - 1,
+   * sharing the calls between the threads, in chunks of @a chunk_size,
+   * so that a thread that finishes early can take more chunks.
+   *
+   * @param chunk_size 0 means a size that gives each thread several chunks.
+   */
+  template <typename T_Func>
+  void
+  parallel_for(std::size_t count, const T_Func& func,
+    std::size_t chunk_size = 0) {
+    if (chunk_size == 0) {
+      chunk_size = std::max<std::size_t>(1, count / (size() * 8));
+    }
+
+    std::atomic<std::size_t> next(0);
+    run([&](std::size_t thread_index) {
+      while (true) {
+        const auto begin = next.fetch_add(chunk_size);
+        if (begin >= count) {
+          break;
+        }
+
+        const auto end = std::min(begin + chunk_size, count);
+        for (auto i = begin; i < end; ++i) {
+          func(i, thread_index);
+        }
+      }
+    });
+  }
+
+private:
+  void
+  work(std::size_t thread_index) {
+    std::size_t generation = 0;
+    while (true) {
+      std::function<void(std::size_t)> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        start_condition_.wait(
+          lock, [&] { return stop_ || generation_ != generation; });
+        if (stop_) {
+          return;
+        }
+
+        generation = generation_;
+        task = task_;
+      }
+
+      task(thread_index);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--pending_ == 0) {
+          done_condition_.notify_one();
+        }
+      }
+    }
+  }
+
+  std::vector<std::thread> threads_;
+
+  std::mutex mutex_;
+  std::condition_variable start_condition_;
+  std::condition_variable done_condition_;
+
+  // The function for the current phase.
+  std::function<void(std::size_t)> task_;
+
+  // Incremented for each phase, so the threads know when to start.
+  std::size_t generation_;
+
+  // The number of threads that have not yet finished the current phase.
+  std::size_t pending_;
+
+  bool stop_;
+};
+
+#endif // MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_THREAD_POOL
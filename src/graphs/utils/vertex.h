@@ -4,17 +4,22 @@
 #include "utils/edge.h"
 #include <vector>
 
-class Vertex {
+template <typename T_Edge>
+class BasicVertex {
 public:
-  Vertex() {}
+  using type_edge = T_Edge;
 
-  explicit Vertex(std::initializer_list<Edge>&& edges)
+  BasicVertex() {}
+
+  explicit BasicVertex(std::initializer_list<T_Edge>&& edges)
   : edges_(std::move(edges)) {}
 
   // A list of other vertices that the vertex has edges leading to.
-  std::vector<Edge> edges_;
+  std::vector<T_Edge> edges_;
 };
 
+using Vertex = BasicVertex<Edge>;
+
 static_assert(
   std::is_copy_assignable<Vertex>::value, "Vertex should be copy assignable.");
 static_assert(std::is_copy_constructible<Vertex>::value,
@@ -27,4 +32,29 @@ static_assert(std::is_move_constructible<Vertex>::value,
 // A set of vertices and their edges.
 using type_vec_nodes = std::vector<Vertex>;
 
+/**
+ * Copy the graph, using a different type of edge,
+ * for instance with a narrower type for the vertex indices or lengths.
+ */
+template <typename T_EdgeResult, typename T_Edge>
+std::vector<BasicVertex<T_EdgeResult>>
+convert_vertices(const std::vector<BasicVertex<T_Edge>>& vertices) {
+  std::vector<BasicVertex<T_EdgeResult>> result(vertices.size());
+
+  const auto vertices_count = vertices.size();
+  for (std::size_t i = 0; i < vertices_count; ++i) {
+    const auto& edges = vertices[i].edges_;
+    auto& result_edges = result[i].edges_;
+    result_edges.reserve(edges.size());
+    for (const auto& edge : edges) {
+      using type_num = typename T_EdgeResult::type_num;
+      using type_length = typename T_EdgeResult::type_length;
+      result_edges.emplace_back(static_cast<type_num>(edge.destination_vertex_),
+        static_cast<type_length>(edge.length_));
+    }
+  }
+
+  return result;
+}
+
 #endif // MURRAYC_ALGORITHMS_EXPERIMENTS_GRAPHS_VERTEX